@@ -179,6 +179,43 @@ struct AddLeakyReluAdd
 #endif
     }
 };
+
+// int32 accumulator to int8: y = saturate(round(scale * x) + zero_point), rounding half to even
+struct Requantize
+{
+    __host__ __device__ Requantize(float scale = 1.f, int32_t zero_point = 0)
+        : scale_{scale}, zero_point_{zero_point}
+    {
+    }
+
+    __host__ __device__ void operator()(int8_t& y, const int32_t& x) const { y = (*this)(x); }
+
+    __host__ __device__ int8_t operator()(int32_t x) const
+    {
+        const float v = __builtin_rintf(scale_ * static_cast<float>(x)) + zero_point_;
+
+        return static_cast<int8_t>(v > 127.f ? 127.f : (v < -128.f ? -128.f : v));
+    }
+
+    float scale_;
+    int32_t zero_point_;
+};
+
+// Requantize after Relu on the accumulator
+struct RequantizeRelu
+{
+    __host__ __device__ RequantizeRelu(float scale = 1.f, int32_t zero_point = 0)
+        : requantize_{scale, zero_point}
+    {
+    }
+
+    __host__ __device__ void operator()(int8_t& y, const int32_t& x) const { y = (*this)(x); }
+
+    __host__ __device__ int8_t operator()(int32_t x) const { return requantize_(x > 0 ? x : 0); }
+
+    Requantize requantize_;
+};
+
 } // namespace element_wise
 } // namespace tensor_operation
 } // namespace ck
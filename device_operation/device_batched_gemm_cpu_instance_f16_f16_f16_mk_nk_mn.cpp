@@ -0,0 +1,62 @@
+#include <stdlib.h>
+#include "config.hpp"
+#include "device_batched_gemm_cpu.hpp"
+#include "device_batched_gemm_instance.hpp"
+#include "element_wise_operation.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace device_batched_gemm_instance {
+
+using F16 = ck::half_t;
+using F32 = float;
+
+using Row = ck::tensor_layout::gemm::RowMajor;
+using Col = ck::tensor_layout::gemm::ColumnMajor;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+static constexpr auto Scalar = HostSimdIsa_t::Scalar;
+static constexpr auto Avx2   = HostSimdIsa_t::Avx2;
+static constexpr auto Avx512 = HostSimdIsa_t::Avx512;
+
+// Compilation parameters for a[m, k] * b[n, k] = c[m, n] on the host, batched
+using device_batched_gemm_cpu_instance_f16_f16_f16_mk_nk_mn =
+    std::tuple<
+        // clang-format off
+        //#################| AData| BData| CData| AccData| ALayout| BLayout| CLayout|           A|           B|           C|  Micro|  MPer|  NPer|  KPer|
+        //#################|  Type|  Type|  Type|    Type|        |        |        | Elementwise| Elementwise| Elementwise| Kernel| Block| Block| Block|
+        //#################|      |      |      |        |        |        |        |   Operation|   Operation|   Operation|    ISA|      |      |      |
+        //#################|      |      |      |        |        |        |        |            |            |            |       |      |      |      |
+        DeviceBatchedGemmCpu<  F16,   F16,   F16,     F32,     Row,     Col,     Row, PassThrough, PassThrough, PassThrough, Avx512,    192,    512,    256>,
+        DeviceBatchedGemmCpu<  F16,   F16,   F16,     F32,     Row,     Col,     Row, PassThrough, PassThrough, PassThrough, Avx512,    384,    256,    128>,
+        DeviceBatchedGemmCpu<  F16,   F16,   F16,     F32,     Row,     Col,     Row, PassThrough, PassThrough, PassThrough, Avx512,     64,   2048,    128>,
+        DeviceBatchedGemmCpu<  F16,   F16,   F16,     F32,     Row,     Col,     Row, PassThrough, PassThrough, PassThrough,   Avx2,    192,    512,    256>,
+        DeviceBatchedGemmCpu<  F16,   F16,   F16,     F32,     Row,     Col,     Row, PassThrough, PassThrough, PassThrough,   Avx2,     96,    256,    256>,
+        DeviceBatchedGemmCpu<  F16,   F16,   F16,     F32,     Row,     Col,     Row, PassThrough, PassThrough, PassThrough, Scalar,     64,    256,    256>
+        // clang-format on
+        >;
+
+template <>
+void add_device_batched_gemm_cpu_instance<F16, F16, F16, Row, Col, Row>(
+    std::vector<DeviceBatchedGemmPtr<PassThrough, PassThrough, PassThrough>>& device_op_instances)
+{
+    using DeviceGemms =
+        device_batched_gemm_instance::device_batched_gemm_cpu_instance_f16_f16_f16_mk_nk_mn;
+
+    const auto device_gemms = DeviceGemms{};
+
+    ck::static_for<0, std::tuple_size_v<DeviceGemms>, 1>{}([&](auto i) {
+        using Gemm = remove_cvref_t<decltype(std::get<i>(device_gemms))>;
+
+        auto gemm = Gemm{};
+
+        device_op_instances.push_back(std::make_unique<Gemm>(gemm));
+    });
+}
+
+} // namespace device_batched_gemm_instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
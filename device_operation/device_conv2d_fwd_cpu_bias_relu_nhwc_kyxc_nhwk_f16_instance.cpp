@@ -0,0 +1,82 @@
+#include <stdlib.h>
+#include "config.hpp"
+#include "device_conv2d_fwd_cpu_bias_activation_nhwc_kyxc_nhwk.hpp"
+#include "element_wise_operation.hpp"
+#include "device_operation_instance.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace device_conv2d_fwd_bias_activation_instance {
+
+using F16 = ck::half_t;
+using F32 = float;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using AddRelu     = ck::tensor_operation::element_wise::AddRelu;
+
+static constexpr auto ConvFwdDefault =
+    ck::tensor_operation::device::ConvolutionForwardSpecialization_t::Default;
+
+static constexpr auto ConvFwd1x1P0 =
+    ck::tensor_operation::device::ConvolutionForwardSpecialization_t::Filter1x1Pad0;
+
+static constexpr auto ConvFwd1x1S1P0 =
+    ck::tensor_operation::device::ConvolutionForwardSpecialization_t::Filter1x1Stride1Pad0;
+
+static constexpr auto Scalar = HostSimdIsa_t::Scalar;
+static constexpr auto Avx2   = HostSimdIsa_t::Avx2;
+static constexpr auto Avx512 = HostSimdIsa_t::Avx512;
+
+// Compilation parameters for
+//   out[n, ho, wo, k] = relu(in[n, hi, wi, c] * wei[k, y, x, c] + bias[k])
+// on the host
+using device_conv2d_fwd_cpu_bias_relu_nhwc_kyxc_nhwk_f16_instances = std::tuple<
+    // clang-format off
+        //################################################################################| InData| WeiData| OutData| AccData|          In|         Wei|         Out|    ConvForward|  Micro|  MPer|  NPer|  KPer|
+        //################################################################################|   Type|    Type|    Type|    Type| Elementwise| Elementwise| Elementwise| Specialization| Kernel| Block| Block| Block|
+        //################################################################################|       |        |        |        |   Operation|   Operation|   Operation|               |    ISA|      |      |      |
+        //################################################################################|       |        |        |        |            |            |            |               |       |      |      |      |
+        DeviceConv2dFwdCpu_Bias_Activation_Input_N_Hi_Wi_C_Weight_K_Y_X_C_Output_N_Ho_Wo_K<    F16,     F16,     F16,     F32, PassThrough, PassThrough,     AddRelu, ConvFwdDefault, Avx512,   192,   512,   256>,
+        DeviceConv2dFwdCpu_Bias_Activation_Input_N_Hi_Wi_C_Weight_K_Y_X_C_Output_N_Ho_Wo_K<    F16,     F16,     F16,     F32, PassThrough, PassThrough,     AddRelu, ConvFwdDefault,   Avx2,   192,   512,   256>,
+        DeviceConv2dFwdCpu_Bias_Activation_Input_N_Hi_Wi_C_Weight_K_Y_X_C_Output_N_Ho_Wo_K<    F16,     F16,     F16,     F32, PassThrough, PassThrough,     AddRelu, ConvFwdDefault, Scalar,    64,   256,   256>
+    // clang-format on
+    >;
+
+using device_conv2d_fwd_cpu_bias_relu_nhwc_kyxc_nhwk_1x1_p0_f16_instances = std::tuple<
+    // clang-format off
+        //################################################################################| InData| WeiData| OutData| AccData|          In|         Wei|         Out|    ConvForward|  Micro|  MPer|  NPer|  KPer|
+        //################################################################################|   Type|    Type|    Type|    Type| Elementwise| Elementwise| Elementwise| Specialization| Kernel| Block| Block| Block|
+        //################################################################################|       |        |        |        |   Operation|   Operation|   Operation|               |    ISA|      |      |      |
+        //################################################################################|       |        |        |        |            |            |            |               |       |      |      |      |
+        DeviceConv2dFwdCpu_Bias_Activation_Input_N_Hi_Wi_C_Weight_K_Y_X_C_Output_N_Ho_Wo_K<    F16,     F16,     F16,     F32, PassThrough, PassThrough,     AddRelu,   ConvFwd1x1P0, Avx512,   384,   256,   128>,
+        DeviceConv2dFwdCpu_Bias_Activation_Input_N_Hi_Wi_C_Weight_K_Y_X_C_Output_N_Ho_Wo_K<    F16,     F16,     F16,     F32, PassThrough, PassThrough,     AddRelu,   ConvFwd1x1P0,   Avx2,   144,   512,   256>
+    // clang-format on
+    >;
+
+using device_conv2d_fwd_cpu_bias_relu_nhwc_kyxc_nhwk_1x1_s1_p0_f16_instances = std::tuple<
+    // clang-format off
+        //################################################################################| InData| WeiData| OutData| AccData|          In|         Wei|         Out|    ConvForward|  Micro|  MPer|  NPer|  KPer|
+        //################################################################################|   Type|    Type|    Type|    Type| Elementwise| Elementwise| Elementwise| Specialization| Kernel| Block| Block| Block|
+        //################################################################################|       |        |        |        |   Operation|   Operation|   Operation|               |    ISA|      |      |      |
+        //################################################################################|       |        |        |        |            |            |            |               |       |      |      |      |
+        DeviceConv2dFwdCpu_Bias_Activation_Input_N_Hi_Wi_C_Weight_K_Y_X_C_Output_N_Ho_Wo_K<    F16,     F16,     F16,     F32, PassThrough, PassThrough,     AddRelu, ConvFwd1x1S1P0, Avx512,   384,   256,   128>,
+        DeviceConv2dFwdCpu_Bias_Activation_Input_N_Hi_Wi_C_Weight_K_Y_X_C_Output_N_Ho_Wo_K<    F16,     F16,     F16,     F32, PassThrough, PassThrough,     AddRelu, ConvFwd1x1S1P0,   Avx2,   144,   512,   256>
+    // clang-format on
+    >;
+
+void add_device_conv2d_fwd_cpu_bias_relu_nhwc_kyxc_nhwk_f16_instances(
+    std::vector<DeviceConvFwdBiasActivationPtr<PassThrough, PassThrough, AddRelu>>& instances)
+{
+    add_device_operation_instances(instances,
+                                   device_conv2d_fwd_cpu_bias_relu_nhwc_kyxc_nhwk_f16_instances{});
+    add_device_operation_instances(
+        instances, device_conv2d_fwd_cpu_bias_relu_nhwc_kyxc_nhwk_1x1_p0_f16_instances{});
+    add_device_operation_instances(
+        instances, device_conv2d_fwd_cpu_bias_relu_nhwc_kyxc_nhwk_1x1_s1_p0_f16_instances{});
+}
+
+} // namespace device_conv2d_fwd_bias_activation_instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
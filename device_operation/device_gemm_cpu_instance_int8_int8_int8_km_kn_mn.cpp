@@ -0,0 +1,63 @@
+#include <stdlib.h>
+#include "config.hpp"
+#include "device_gemm_cpu.hpp"
+#include "device_gemm_instance.hpp"
+#include "element_wise_operation.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace device_gemm_instance {
+
+using I8  = int8_t;
+using I32 = int32_t;
+
+using Row = ck::tensor_layout::gemm::RowMajor;
+using Col = ck::tensor_layout::gemm::ColumnMajor;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+static constexpr auto Scalar = HostSimdIsa_t::Scalar;
+static constexpr auto Avx2   = HostSimdIsa_t::Avx2;
+static constexpr auto Avx512 = HostSimdIsa_t::Avx512;
+
+// Compilation parameters for a[k, m] * b[k, n] = c[m, n] on the host
+// (KPerBlock counts int8 elements, panels are a quarter the size of fp32 ones)
+using device_gemm_cpu_instance_int8_int8_int8_km_kn_mn =
+    std::tuple<
+        // clang-format off
+        //##########| AData| BData| CData| AccData| ALayout| BLayout| CLayout|           A|           B|           C|  Micro|  MPer|  NPer|  KPer|
+        //##########|  Type|  Type|  Type|    Type|        |        |        | Elementwise| Elementwise| Elementwise| Kernel| Block| Block| Block|
+        //##########|      |      |      |        |        |        |        |   Operation|   Operation|   Operation|    ISA|      |      |      |
+        //##########|      |      |      |        |        |        |        |            |            |            |       |      |      |      |
+        DeviceGemmCpu<   I8,    I8,    I8,     I32,     Col,     Row,     Row, PassThrough, PassThrough, PassThrough, Avx512,    192,    512,    512>,
+        DeviceGemmCpu<   I8,    I8,    I8,     I32,     Col,     Row,     Row, PassThrough, PassThrough, PassThrough, Avx512,    384,    256,    512>,
+        DeviceGemmCpu<   I8,    I8,    I8,     I32,     Col,     Row,     Row, PassThrough, PassThrough, PassThrough, Avx512,     96,   1024,    512>,
+        DeviceGemmCpu<   I8,    I8,    I8,     I32,     Col,     Row,     Row, PassThrough, PassThrough, PassThrough, Avx512,    192,    512,   1024>,
+        DeviceGemmCpu<   I8,    I8,    I8,     I32,     Col,     Row,     Row, PassThrough, PassThrough, PassThrough,   Avx2,    192,    512,    512>,
+        DeviceGemmCpu<   I8,    I8,    I8,     I32,     Col,     Row,     Row, PassThrough, PassThrough, PassThrough,   Avx2,     96,    256,    512>,
+        DeviceGemmCpu<   I8,    I8,    I8,     I32,     Col,     Row,     Row, PassThrough, PassThrough, PassThrough, Scalar,     64,    256,    256>
+        // clang-format on
+        >;
+
+template <>
+void add_device_gemm_cpu_instance<I8, I8, I8, Col, Row, Row>(
+    std::vector<DeviceGemmPtr<PassThrough, PassThrough, PassThrough>>& device_op_instances)
+{
+    using DeviceGemms = device_gemm_instance::device_gemm_cpu_instance_int8_int8_int8_km_kn_mn;
+
+    const auto device_gemms = DeviceGemms{};
+
+    ck::static_for<0, std::tuple_size_v<DeviceGemms>, 1>{}([&](auto i) {
+        using Gemm = remove_cvref_t<decltype(std::get<i>(device_gemms))>;
+
+        auto gemm = Gemm{};
+
+        device_op_instances.push_back(std::make_unique<Gemm>(gemm));
+    });
+}
+
+} // namespace device_gemm_instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
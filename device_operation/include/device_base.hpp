@@ -2,6 +2,7 @@
 #define DEVICE_BASE_HPP
 
 #include <string>
+#include "timing_stats.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -24,6 +25,17 @@ struct BaseInvoker
 
     virtual float Run(const BaseArgument*, int = 1) = 0;
 
+    // Run() with the statistics of the per-run times it measured, e.g. to rank instances by
+    // median time. Invokers that do not time each run report their average time only.
+    virtual TimingStats RunWithStats(const BaseArgument* p_arg, int nrepeat = 1)
+    {
+        TimingStatsRecorder recorder;
+
+        const float ave_time = Run(p_arg, nrepeat);
+
+        return recorder.GetStats(ave_time);
+    }
+
     virtual ~BaseInvoker() {}
 };
 
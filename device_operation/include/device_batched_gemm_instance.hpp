@@ -0,0 +1,28 @@
+#ifndef DEVICE_BATCHED_GEMM_INSTANTCE_HPP
+#define DEVICE_BATCHED_GEMM_INSTANTCE_HPP
+
+#include "device_batched_gemm.hpp"
+#include "element_wise_operation.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace device_batched_gemm_instance {
+
+// instances that run on the host, they take host pointers
+template <typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename ALayout,
+          typename BLayout,
+          typename CLayout>
+void add_device_batched_gemm_cpu_instance(
+    std::vector<DeviceBatchedGemmPtr<ck::tensor_operation::element_wise::PassThrough,
+                                     ck::tensor_operation::element_wise::PassThrough,
+                                     ck::tensor_operation::element_wise::PassThrough>>&);
+
+} // namespace device_batched_gemm_instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
+#endif
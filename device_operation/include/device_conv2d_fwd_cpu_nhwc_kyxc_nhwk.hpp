@@ -0,0 +1,305 @@
+#ifndef DEVICE_CONV2D_FWD_CPU_NHWC_KYXC_NHWK_HPP
+#define DEVICE_CONV2D_FWD_CPU_NHWC_KYXC_NHWK_HPP
+
+#include <iostream>
+#include <sstream>
+#include "config.hpp"
+#include "device_base.hpp"
+#include "device_conv_fwd.hpp"
+#include "convolution_forward_specialization.hpp"
+#include "host_conv_fwd_im2col.hpp"
+#include "host_timer.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+
+// problem of packed in[N, Hi, Wi, C], wei[K, Y, X, C] and out[N, Ho, Wo, K] tensors
+inline HostConvProblem
+make_host_conv_problem_nhwc_kyxc_nhwk(ck::index_t N,
+                                      ck::index_t K,
+                                      ck::index_t C,
+                                      const std::vector<ck::index_t>& input_spatial_lengths,
+                                      const std::vector<ck::index_t>& filter_spatial_lengths,
+                                      const std::vector<ck::index_t>& output_spatial_lengths,
+                                      const std::vector<ck::index_t>& conv_filter_strides,
+                                      const std::vector<ck::index_t>& conv_filter_dilations,
+                                      const std::vector<ck::index_t>& input_left_pads,
+                                      const std::vector<ck::index_t>& input_right_pads)
+{
+    HostConvProblem problem;
+
+    problem.N  = N;
+    problem.K  = K;
+    problem.C  = C;
+    problem.Y  = filter_spatial_lengths[0];
+    problem.X  = filter_spatial_lengths[1];
+    problem.Hi = input_spatial_lengths[0];
+    problem.Wi = input_spatial_lengths[1];
+    problem.Ho = output_spatial_lengths[0];
+    problem.Wo = output_spatial_lengths[1];
+
+    problem.ConvStrideH   = conv_filter_strides[0];
+    problem.ConvStrideW   = conv_filter_strides[1];
+    problem.ConvDilationH = conv_filter_dilations[0];
+    problem.ConvDilationW = conv_filter_dilations[1];
+    problem.InLeftPadH    = input_left_pads[0];
+    problem.InLeftPadW    = input_left_pads[1];
+    problem.InRightPadH   = input_right_pads[0];
+    problem.InRightPadW   = input_right_pads[1];
+
+    // strides in the logical (n, c, h, w) order of HostConvProblem
+    const std::size_t Hi = problem.Hi, Wi = problem.Wi, Ho = problem.Ho, Wo = problem.Wo;
+    const std::size_t Y = problem.Y, X = problem.X;
+
+    problem.InStrides  = {Hi * Wi * problem.C, 1, Wi * problem.C, problem.C};
+    problem.WeiStrides = {Y * X * problem.C, 1, X * problem.C, problem.C};
+    problem.OutStrides = {Ho * Wo * problem.K, 1, Wo * problem.K, problem.K};
+
+    return problem;
+}
+
+// whether the problem is one the ConvolutionForwardSpecialization_t of an instance is made for
+template <ConvolutionForwardSpecialization_t ConvForwardSpecialization>
+bool is_host_conv_fwd_specialization_supported(const HostConvProblem& problem)
+{
+    if constexpr(ConvForwardSpecialization ==
+                 ConvolutionForwardSpecialization_t::Filter1x1Stride1Pad0)
+    {
+        return problem.IsFilter1x1Stride1Pad0();
+    }
+    else if constexpr(ConvForwardSpecialization ==
+                      ConvolutionForwardSpecialization_t::Filter1x1Pad0)
+    {
+        return problem.IsFilter1x1Pad0();
+    }
+    else if constexpr(ConvForwardSpecialization == ConvolutionForwardSpecialization_t::OddC)
+    {
+        return problem.C % 2 == 1;
+    }
+    else
+    {
+        return true;
+    }
+}
+
+// out[N, Ho, Wo, K] = in[N, Hi, Wi, C] * wei[K, Y, X, C], on the host with the implicit-GEMM
+// engine: each work unit packs its im2col panel on the fly and runs the blocked host GEMM on it.
+// Pointers passed to MakeArgumentPointer are host pointers. The engine detects the 1x1 cases
+// itself, Filter1x1 instances only accept those problems and carry blocking tuned for them.
+template <typename InDataType,
+          typename WeiDataType,
+          typename OutDataType,
+          typename AccDataType,
+          typename InElementwiseOperation,
+          typename WeiElementwiseOperation,
+          typename OutElementwiseOperation,
+          ConvolutionForwardSpecialization_t ConvForwardSpecialization,
+          HostSimdIsa_t Isa,
+          ck::index_t MPerBlock,
+          ck::index_t NPerBlock,
+          ck::index_t KPerBlock>
+struct DeviceConv2dFwdCpu_Input_N_Hi_Wi_C_Weight_K_Y_X_C_Output_N_Ho_Wo_K
+    : public DeviceConvFwd<InElementwiseOperation, WeiElementwiseOperation, OutElementwiseOperation>
+{
+    using DeviceOp = DeviceConv2dFwdCpu_Input_N_Hi_Wi_C_Weight_K_Y_X_C_Output_N_Ho_Wo_K;
+
+    // Argument
+    struct Argument : public BaseArgument
+    {
+        Argument(const InDataType* p_in,
+                 const WeiDataType* p_wei,
+                 OutDataType* p_out,
+                 ck::index_t N,
+                 ck::index_t K,
+                 ck::index_t C,
+                 std::vector<ck::index_t> input_spatial_lengths,
+                 std::vector<ck::index_t> filter_spatial_lengths,
+                 std::vector<ck::index_t> output_spatial_lengths,
+                 std::vector<ck::index_t> conv_filter_strides,
+                 std::vector<ck::index_t> conv_filter_dilations,
+                 std::vector<ck::index_t> input_left_pads,
+                 std::vector<ck::index_t> input_right_pads,
+                 InElementwiseOperation in_element_op,
+                 WeiElementwiseOperation wei_element_op,
+                 OutElementwiseOperation out_element_op)
+            : p_in_{p_in},
+              p_wei_{p_wei},
+              p_out_{p_out},
+              problem_{make_host_conv_problem_nhwc_kyxc_nhwk(N,
+                                                             K,
+                                                             C,
+                                                             input_spatial_lengths,
+                                                             filter_spatial_lengths,
+                                                             output_spatial_lengths,
+                                                             conv_filter_strides,
+                                                             conv_filter_dilations,
+                                                             input_left_pads,
+                                                             input_right_pads)},
+              in_element_op_{in_element_op},
+              wei_element_op_{wei_element_op},
+              out_element_op_{out_element_op}
+        {
+        }
+
+        //  private:
+        const InDataType* p_in_;
+        const WeiDataType* p_wei_;
+        OutDataType* p_out_;
+        HostConvProblem problem_;
+        InElementwiseOperation in_element_op_;
+        WeiElementwiseOperation wei_element_op_;
+        OutElementwiseOperation out_element_op_;
+    };
+
+    // Invoker
+    struct Invoker : public BaseInvoker
+    {
+        using Argument = DeviceOp::Argument;
+
+        float Run(const Argument& arg, int nrepeat = 1)
+        {
+            if(!DeviceOp::IsSupportedArgument(arg))
+            {
+                throw std::runtime_error("wrong! DeviceConv2dFwdCpu has invalid setting");
+            }
+
+            const HostGemmBlocking blocking{MPerBlock, NPerBlock, KPerBlock};
+
+            auto f_conv = [&]() {
+                host_conv_fwd_im2col<AccDataType>(arg.problem_,
+                                                  arg.p_in_,
+                                                  arg.p_wei_,
+                                                  arg.p_out_,
+                                                  arg.in_element_op_,
+                                                  arg.wei_element_op_,
+                                                  arg.out_element_op_,
+                                                  get_host_num_threads(),
+                                                  blocking,
+                                                  Isa);
+            };
+
+            return launch_and_time_host_kernel(f_conv, nrepeat);
+        }
+
+        // polymorphic
+        float Run(const BaseArgument* p_arg, int nrepeat = 1) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg), nrepeat);
+        }
+    };
+
+    static bool IsSupportedArgument(const Argument& arg)
+    {
+        if(Isa > get_host_simd_isa())
+            return false;
+
+        return is_host_conv_fwd_specialization_supported<ConvForwardSpecialization>(arg.problem_);
+    }
+
+    bool IsSupportedArgument(const BaseArgument* p_arg) override
+    {
+        return IsSupportedArgument(*dynamic_cast<const Argument*>(p_arg));
+    }
+
+    static auto MakeArgument(const InDataType* p_in,
+                             const WeiDataType* p_wei,
+                             OutDataType* p_out,
+                             ck::index_t N,
+                             ck::index_t K,
+                             ck::index_t C,
+                             std::vector<ck::index_t> input_spatial_lengths,
+                             std::vector<ck::index_t> filter_spatial_lengths,
+                             std::vector<ck::index_t> output_spatial_lengths,
+                             std::vector<ck::index_t> conv_filter_strides,
+                             std::vector<ck::index_t> conv_filter_dilations,
+                             std::vector<ck::index_t> input_left_pads,
+                             std::vector<ck::index_t> input_right_pads,
+                             InElementwiseOperation in_element_op,
+                             WeiElementwiseOperation wei_element_op,
+                             OutElementwiseOperation out_element_op)
+    {
+        return Argument{p_in,
+                        p_wei,
+                        p_out,
+                        N,
+                        K,
+                        C,
+                        input_spatial_lengths,
+                        filter_spatial_lengths,
+                        output_spatial_lengths,
+                        conv_filter_strides,
+                        conv_filter_dilations,
+                        input_left_pads,
+                        input_right_pads,
+                        in_element_op,
+                        wei_element_op,
+                        out_element_op};
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    std::unique_ptr<BaseArgument>
+    MakeArgumentPointer(const void* p_in,
+                        const void* p_wei,
+                        void* p_out,
+                        ck::index_t N,
+                        ck::index_t K,
+                        ck::index_t C,
+                        std::vector<ck::index_t> input_spatial_lengths,
+                        std::vector<ck::index_t> filter_spatial_lengths,
+                        std::vector<ck::index_t> output_spatial_lengths,
+                        std::vector<ck::index_t> conv_filter_strides,
+                        std::vector<ck::index_t> conv_filter_dilations,
+                        std::vector<ck::index_t> input_left_pads,
+                        std::vector<ck::index_t> input_right_pads,
+                        InElementwiseOperation in_element_op,
+                        WeiElementwiseOperation wei_element_op,
+                        OutElementwiseOperation out_element_op) override
+    {
+        return std::make_unique<Argument>(static_cast<const InDataType*>(p_in),
+                                          static_cast<const WeiDataType*>(p_wei),
+                                          static_cast<OutDataType*>(p_out),
+                                          N,
+                                          K,
+                                          C,
+                                          input_spatial_lengths,
+                                          filter_spatial_lengths,
+                                          output_spatial_lengths,
+                                          conv_filter_strides,
+                                          conv_filter_dilations,
+                                          input_left_pads,
+                                          input_right_pads,
+                                          in_element_op,
+                                          wei_element_op,
+                                          out_element_op);
+    }
+
+    std::unique_ptr<BaseInvoker> MakeInvokerPointer() override
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "DeviceConv2dFwdCpu_Input_N_Hi_Wi_C_Weight_K_Y_X_C_Output_N_Ho_Wo_K"
+            << "<"
+            << get_host_simd_isa_name(Isa) << ", "
+            << ConvForwardSpecialization << ", "
+            << MPerBlock << ", "
+            << NPerBlock << ", "
+            << KPerBlock
+            << ">";
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
+#endif
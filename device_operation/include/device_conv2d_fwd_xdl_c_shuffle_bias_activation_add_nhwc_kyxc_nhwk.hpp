@@ -929,6 +929,7 @@ struct
         str << "DeviceConv2dFwdXdl_C_Shuffle_Bias_Activation_Add_Input_N_Hi_Wi_C_Weight_K_Y_X_C_Output_N_Ho_Wo_K"
             << "<"
             << BlockSize << ", "
+            << ConvForwardSpecialization << ", "
             << MPerBlock << ", "
             << NPerBlock << ", "
             << K0PerBlock
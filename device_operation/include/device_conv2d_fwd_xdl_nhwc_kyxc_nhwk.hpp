@@ -703,6 +703,7 @@ struct DeviceConv2dFwdXdl_Input_N_Hi_Wi_C_Weight_K_Y_X_C_Output_N_Ho_Wo_K
         str << "DeviceConv2dFwdXdl_Input_N_Hi_Wi_C_Weight_K_Y_X_C_Output_N_Ho_Wo_K"
             << "<"
             << BlockSize << ", "
+            << ConvForwardSpecialization << ", "
             << MPerBlock << ", "
             << NPerBlock << ", "
             << K0PerBlock
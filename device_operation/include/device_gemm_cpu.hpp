@@ -0,0 +1,244 @@
+#ifndef DEVICE_GEMM_CPU_HPP
+#define DEVICE_GEMM_CPU_HPP
+
+#include <iostream>
+#include <sstream>
+#include <type_traits>
+#include "config.hpp"
+#include "device_base.hpp"
+#include "device_gemm.hpp"
+#include "tensor_layout.hpp"
+#include "host_gemm_blocked.hpp"
+#include "host_timer.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+
+// DeviceGemm that runs on the host with the blocked host GEMM. Pointers passed to
+// MakeArgumentPointer are host pointers. Instances differ in cache blocking (MC, NC, KC) and in
+// the micro-kernel ISA; an instance whose ISA the host does not support is not supported.
+template <typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename AccDataType,
+          typename ALayout,
+          typename BLayout,
+          typename CLayout,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CElementwiseOperation,
+          HostSimdIsa_t Isa,
+          ck::index_t MPerBlock,
+          ck::index_t NPerBlock,
+          ck::index_t KPerBlock>
+struct DeviceGemmCpu
+    : public DeviceGemm<AElementwiseOperation, BElementwiseOperation, CElementwiseOperation>
+{
+    static constexpr bool IsRowMajorA =
+        std::is_same<ALayout, ck::tensor_layout::gemm::RowMajor>::value;
+    static constexpr bool IsRowMajorB =
+        std::is_same<BLayout, ck::tensor_layout::gemm::RowMajor>::value;
+    static constexpr bool IsRowMajorC =
+        std::is_same<CLayout, ck::tensor_layout::gemm::RowMajor>::value;
+
+    // Argument
+    struct Argument : public BaseArgument
+    {
+        Argument(const ADataType* p_a,
+                 const BDataType* p_b,
+                 CDataType* p_c,
+                 index_t M,
+                 index_t N,
+                 index_t K,
+                 index_t StrideA,
+                 index_t StrideB,
+                 index_t StrideC,
+                 AElementwiseOperation a_element_op,
+                 BElementwiseOperation b_element_op,
+                 CElementwiseOperation c_element_op)
+            : p_a_{p_a},
+              p_b_{p_b},
+              p_c_{p_c},
+              M_{M},
+              N_{N},
+              K_{K},
+              StrideA_{StrideA},
+              StrideB_{StrideB},
+              StrideC_{StrideC},
+              a_element_op_{a_element_op},
+              b_element_op_{b_element_op},
+              c_element_op_{c_element_op}
+        {
+        }
+
+        //  private:
+        const ADataType* p_a_;
+        const BDataType* p_b_;
+        CDataType* p_c_;
+        index_t M_;
+        index_t N_;
+        index_t K_;
+        index_t StrideA_;
+        index_t StrideB_;
+        index_t StrideC_;
+        AElementwiseOperation a_element_op_;
+        BElementwiseOperation b_element_op_;
+        CElementwiseOperation c_element_op_;
+    };
+
+    // Invoker
+    struct Invoker : public BaseInvoker
+    {
+        using Argument = DeviceGemmCpu::Argument;
+
+        float Run(const Argument& arg, int nrepeat = 1)
+        {
+            if(!DeviceGemmCpu::IsSupportedArgument(arg))
+            {
+                throw std::runtime_error("wrong! DeviceGemmCpu has invalid setting");
+            }
+
+            const std::size_t StrideA = arg.StrideA_;
+            const std::size_t StrideB = arg.StrideB_;
+            const std::size_t StrideC = arg.StrideC_;
+
+            const HostGemmBlocking blocking{MPerBlock, NPerBlock, KPerBlock};
+
+            auto f_gemm = [&]() {
+                host_gemm_blocked<AccDataType>(arg.M_,
+                                               arg.N_,
+                                               arg.K_,
+                                               arg.p_a_,
+                                               IsRowMajorA ? StrideA : 1,
+                                               IsRowMajorA ? 1 : StrideA,
+                                               arg.p_b_,
+                                               IsRowMajorB ? StrideB : 1,
+                                               IsRowMajorB ? 1 : StrideB,
+                                               arg.p_c_,
+                                               IsRowMajorC ? StrideC : 1,
+                                               IsRowMajorC ? 1 : StrideC,
+                                               arg.a_element_op_,
+                                               arg.b_element_op_,
+                                               arg.c_element_op_,
+                                               blocking,
+                                               get_host_num_threads(),
+                                               Isa);
+            };
+
+            return launch_and_time_host_kernel(f_gemm, nrepeat);
+        }
+
+        // polymorphic
+        float Run(const BaseArgument* p_arg, int nrepeat = 1) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg), nrepeat);
+        }
+    };
+
+    static bool IsSupportedArgument(const Argument& arg)
+    {
+        if(Isa > get_host_simd_isa())
+            return false;
+
+        if(arg.M_ <= 0 || arg.N_ <= 0 || arg.K_ <= 0)
+            return false;
+
+        // leading dimensions cover a row (RowMajor) or a column (ColumnMajor)
+        return arg.StrideA_ >= (IsRowMajorA ? arg.K_ : arg.M_) &&
+               arg.StrideB_ >= (IsRowMajorB ? arg.N_ : arg.K_) &&
+               arg.StrideC_ >= (IsRowMajorC ? arg.N_ : arg.M_);
+    }
+
+    // polymorphic
+    bool IsSupportedArgument(const BaseArgument* p_arg) override
+    {
+        return IsSupportedArgument(*dynamic_cast<const Argument*>(p_arg));
+    }
+
+    static auto MakeArgument(const ADataType* p_a,
+                             const BDataType* p_b,
+                             CDataType* p_c,
+                             index_t M,
+                             index_t N,
+                             index_t K,
+                             index_t StrideA,
+                             index_t StrideB,
+                             index_t StrideC,
+                             AElementwiseOperation a_element_op,
+                             BElementwiseOperation b_element_op,
+                             CElementwiseOperation c_element_op)
+    {
+        return Argument{p_a,
+                        p_b,
+                        p_c,
+                        M,
+                        N,
+                        K,
+                        StrideA,
+                        StrideB,
+                        StrideC,
+                        a_element_op,
+                        b_element_op,
+                        c_element_op};
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    // polymorphic
+    std::unique_ptr<BaseArgument> MakeArgumentPointer(const void* p_a,
+                                                      const void* p_b,
+                                                      void* p_c,
+                                                      index_t M,
+                                                      index_t N,
+                                                      index_t K,
+                                                      index_t StrideA,
+                                                      index_t StrideB,
+                                                      index_t StrideC,
+                                                      AElementwiseOperation a_element_op,
+                                                      BElementwiseOperation b_element_op,
+                                                      CElementwiseOperation c_element_op) override
+    {
+        return std::make_unique<Argument>(static_cast<const ADataType*>(p_a),
+                                          static_cast<const BDataType*>(p_b),
+                                          static_cast<CDataType*>(p_c),
+                                          M,
+                                          N,
+                                          K,
+                                          StrideA,
+                                          StrideB,
+                                          StrideC,
+                                          a_element_op,
+                                          b_element_op,
+                                          c_element_op);
+    }
+
+    // polymorphic
+    std::unique_ptr<BaseInvoker> MakeInvokerPointer() override
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    // polymorphic
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "DeviceGemmCpu"
+            << "<"
+            << get_host_simd_isa_name(Isa) << ", "
+            << MPerBlock << ", "
+            << NPerBlock << ", "
+            << KPerBlock
+            << ">";
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
+#endif
@@ -20,6 +20,18 @@ void add_device_gemm_instance(
                               ck::tensor_operation::element_wise::PassThrough,
                               ck::tensor_operation::element_wise::PassThrough>>&);
 
+// instances that run on the host, they take host pointers
+template <typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename ALayout,
+          typename BLayout,
+          typename CLayout>
+void add_device_gemm_cpu_instance(
+    std::vector<DeviceGemmPtr<ck::tensor_operation::element_wise::PassThrough,
+                              ck::tensor_operation::element_wise::PassThrough,
+                              ck::tensor_operation::element_wise::PassThrough>>&);
+
 } // namespace device_gemm_instance
 } // namespace device
 } // namespace tensor_operation
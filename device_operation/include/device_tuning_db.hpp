@@ -0,0 +1,314 @@
+#ifndef DEVICE_TUNING_DB_HPP
+#define DEVICE_TUNING_DB_HPP
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "config.hpp"
+#include "data_type.hpp"
+#include "tensor_layout.hpp"
+#include "element_wise_operation.hpp"
+#include "device.hpp"
+#include "host_simd.hpp"
+#include "host_thread_pool.hpp"
+#include "tuning_db.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+
+// named problem sizes, in the order they appear in a tuning db key
+using TuningDbProblem = std::vector<std::pair<std::string, int64_t>>;
+
+template <typename T>
+const char* get_data_type_name()
+{
+    if constexpr(std::is_same<T, float>::value)
+        return "fp32";
+    else if constexpr(std::is_same<T, ck::half_t>::value)
+        return "fp16";
+    else if constexpr(std::is_same<T, ushort>::value)
+        return "bf16";
+    else if constexpr(std::is_same<T, int8_t>::value)
+        return "int8";
+    else if constexpr(std::is_same<T, int32_t>::value)
+        return "int32";
+    else
+        return "unknown";
+}
+
+// "fp16" if all operands are fp16, "fp16_fp16_fp32" otherwise
+template <typename T, typename... Ts>
+std::string get_data_type_string()
+{
+    std::string str = get_data_type_name<T>();
+
+    if constexpr(sizeof...(Ts) > 0)
+    {
+        if(!(std::is_same<T, Ts>::value && ...))
+            ((str += std::string("_") + get_data_type_name<Ts>()), ...);
+    }
+
+    return str;
+}
+
+template <typename ALayout, typename BLayout, typename CLayout>
+std::string get_gemm_layout_string()
+{
+    using Row = ck::tensor_layout::gemm::RowMajor;
+
+    return std::string(std::is_same<ALayout, Row>::value ? "mk" : "km") + "_" +
+           (std::is_same<BLayout, Row>::value ? "kn" : "nk") + "_" +
+           (std::is_same<CLayout, Row>::value ? "mn" : "nm");
+}
+
+template <typename Layout>
+const char* get_conv_layout_name()
+{
+    namespace conv = ck::tensor_layout::convolution;
+
+    if constexpr(std::is_same<Layout, conv::NCHW>::value)
+        return "nchw";
+    else if constexpr(std::is_same<Layout, conv::KCYX>::value)
+        return "kcyx";
+    else if constexpr(std::is_same<Layout, conv::NKHW>::value)
+        return "nkhw";
+    else if constexpr(std::is_same<Layout, conv::NHWC>::value)
+        return "nhwc";
+    else if constexpr(std::is_same<Layout, conv::KYXC>::value)
+        return "kyxc";
+    else
+        return "nhwk";
+}
+
+template <typename InLayout, typename WeiLayout, typename OutLayout>
+std::string get_conv_layout_string()
+{
+    return std::string(get_conv_layout_name<InLayout>()) + "_" +
+           get_conv_layout_name<WeiLayout>() + "_" + get_conv_layout_name<OutLayout>();
+}
+
+// the parameters of an operation (e.g. the requantization scale) are not part of the name
+template <typename Op>
+const char* get_element_wise_op_name()
+{
+    namespace element_wise = ck::tensor_operation::element_wise;
+
+    if constexpr(std::is_same<Op, element_wise::PassThrough>::value)
+        return "PassThrough";
+    else if constexpr(std::is_same<Op, element_wise::AddRelu>::value)
+        return "AddRelu";
+    else if constexpr(std::is_same<Op, element_wise::AddReluAdd>::value)
+        return "AddReluAdd";
+    else if constexpr(std::is_same<Op, element_wise::AddLeakyReluAdd>::value)
+        return "AddLeakyReluAdd";
+    else if constexpr(std::is_same<Op, element_wise::Requantize>::value)
+        return "Requantize";
+    else if constexpr(std::is_same<Op, element_wise::RequantizeRelu>::value)
+        return "RequantizeRelu";
+    else
+        return "unknown";
+}
+
+template <typename... Ops>
+std::string get_element_wise_op_string()
+{
+    std::string str;
+
+    ((str += (str.empty() ? "" : "_") + std::string(get_element_wise_op_name<Ops>())), ...);
+
+    return str;
+}
+
+inline TuningDbProblem make_gemm_problem(ck::index_t M,
+                                         ck::index_t N,
+                                         ck::index_t K,
+                                         ck::index_t StrideA,
+                                         ck::index_t StrideB,
+                                         ck::index_t StrideC)
+{
+    return {{"M", M},
+            {"N", N},
+            {"K", K},
+            {"StrideA", StrideA},
+            {"StrideB", StrideB},
+            {"StrideC", StrideC}};
+}
+
+inline TuningDbProblem make_batched_gemm_problem(ck::index_t M,
+                                                 ck::index_t N,
+                                                 ck::index_t K,
+                                                 ck::index_t StrideA,
+                                                 ck::index_t StrideB,
+                                                 ck::index_t StrideC,
+                                                 ck::index_t BatchCount)
+{
+    auto problem = make_gemm_problem(M, N, K, StrideA, StrideB, StrideC);
+
+    problem.emplace_back("BatchCount", BatchCount);
+
+    return problem;
+}
+
+// 2D forward conv
+inline TuningDbProblem make_conv_fwd_problem(ck::index_t N,
+                                             ck::index_t K,
+                                             ck::index_t C,
+                                             const std::vector<ck::index_t>& input_spatial_lengths,
+                                             const std::vector<ck::index_t>& filter_spatial_lengths,
+                                             const std::vector<ck::index_t>& conv_filter_strides,
+                                             const std::vector<ck::index_t>& conv_filter_dilations,
+                                             const std::vector<ck::index_t>& input_left_pads,
+                                             const std::vector<ck::index_t>& input_right_pads)
+{
+    return {{"N", N},
+            {"K", K},
+            {"C", C},
+            {"Y", filter_spatial_lengths[0]},
+            {"X", filter_spatial_lengths[1]},
+            {"Hi", input_spatial_lengths[0]},
+            {"Wi", input_spatial_lengths[1]},
+            {"Sy", conv_filter_strides[0]},
+            {"Sx", conv_filter_strides[1]},
+            {"Dy", conv_filter_dilations[0]},
+            {"Dx", conv_filter_dilations[1]},
+            {"LeftPy", input_left_pads[0]},
+            {"LeftPx", input_left_pads[1]},
+            {"RightPy", input_right_pads[0]},
+            {"RightPx", input_right_pads[1]}};
+}
+
+// "host:<isa>:<threads>" for host instances, "<arch>:<compute units>" of the current device
+// otherwise; the best instance usually changes with either
+inline std::string get_tuning_db_backend(bool on_host)
+{
+    if(on_host)
+        return std::string("host:") + get_host_simd_isa_name(get_host_simd_isa()) + ":" +
+               std::to_string(get_host_num_threads());
+    else
+        return get_device_name();
+}
+
+// op|data types|layouts|problem|element-wise ops|backend
+inline std::string make_tuning_db_key(const std::string& op,
+                                      const std::string& data_type,
+                                      const std::string& layout,
+                                      const TuningDbProblem& problem,
+                                      const std::string& element_wise_op,
+                                      const std::string& backend)
+{
+    std::string problem_str;
+
+    for(const auto& field : problem)
+        problem_str += (problem_str.empty() ? "" : ",") + field.first + "=" +
+                       std::to_string(field.second);
+
+    return op + "|" + data_type + "|" + layout + "|" + problem_str + "|" + element_wise_op + "|" +
+           backend;
+}
+
+template <typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename ALayout,
+          typename BLayout,
+          typename CLayout,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CElementwiseOperation>
+std::string make_gemm_tuning_db_key(ck::index_t M,
+                                    ck::index_t N,
+                                    ck::index_t K,
+                                    ck::index_t StrideA,
+                                    ck::index_t StrideB,
+                                    ck::index_t StrideC,
+                                    bool on_host)
+{
+    return make_tuning_db_key(
+        "gemm",
+        get_data_type_string<ADataType, BDataType, CDataType>(),
+        get_gemm_layout_string<ALayout, BLayout, CLayout>(),
+        make_gemm_problem(M, N, K, StrideA, StrideB, StrideC),
+        get_element_wise_op_string<AElementwiseOperation,
+                                   BElementwiseOperation,
+                                   CElementwiseOperation>(),
+        get_tuning_db_backend(on_host));
+}
+
+// op is the profiler name of the operation: conv_fwd, conv_fwd_bias_relu, ...
+template <typename InDataType,
+          typename WeiDataType,
+          typename OutDataType,
+          typename InLayout,
+          typename WeiLayout,
+          typename OutLayout,
+          typename InElementwiseOperation,
+          typename WeiElementwiseOperation,
+          typename OutElementwiseOperation>
+std::string make_conv_fwd_tuning_db_key(const std::string& op,
+                                        ck::index_t N,
+                                        ck::index_t K,
+                                        ck::index_t C,
+                                        const std::vector<ck::index_t>& input_spatial_lengths,
+                                        const std::vector<ck::index_t>& filter_spatial_lengths,
+                                        const std::vector<ck::index_t>& conv_filter_strides,
+                                        const std::vector<ck::index_t>& conv_filter_dilations,
+                                        const std::vector<ck::index_t>& input_left_pads,
+                                        const std::vector<ck::index_t>& input_right_pads,
+                                        bool on_host)
+{
+    return make_tuning_db_key(op,
+                              get_data_type_string<InDataType, WeiDataType, OutDataType>(),
+                              get_conv_layout_string<InLayout, WeiLayout, OutLayout>(),
+                              make_conv_fwd_problem(N,
+                                                    K,
+                                                    C,
+                                                    input_spatial_lengths,
+                                                    filter_spatial_lengths,
+                                                    conv_filter_strides,
+                                                    conv_filter_dilations,
+                                                    input_left_pads,
+                                                    input_right_pads),
+                              get_element_wise_op_string<InElementwiseOperation,
+                                                         WeiElementwiseOperation,
+                                                         OutElementwiseOperation>(),
+                              get_tuning_db_backend(on_host));
+}
+
+// Instance of op_ptrs that the tuning db holds for the key, nullptr if the key was not tuned, the
+// tuned instance is not in op_ptrs (e.g. the db was written by a build with other instances) or
+// more than one instance of op_ptrs has its type string, which then does not tell which one was
+// tuned. op_ptrs is what add_device_*_instance() returned for the problem.
+template <typename OpPtr>
+auto find_tuned_device_instance(const std::vector<OpPtr>& op_ptrs,
+                                const std::string& key,
+                                TuningDb& db = TuningDb::GetInstance())
+    -> decltype(op_ptrs[0].get())
+{
+    TuningDbRecord record;
+
+    if(!db.Find(key, record))
+        return nullptr;
+
+    decltype(op_ptrs[0].get()) found = nullptr;
+
+    for(const auto& op_ptr : op_ptrs)
+    {
+        if(op_ptr->GetTypeString() != record.mInstance)
+            continue;
+
+        if(found != nullptr)
+            return nullptr;
+
+        found = op_ptr.get();
+    }
+
+    return found;
+}
+
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
+#endif
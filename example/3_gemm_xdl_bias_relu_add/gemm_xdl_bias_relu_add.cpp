@@ -259,15 +259,18 @@ int main(int argc, char* argv[])
     case 0: break;
     case 1:
         a_m_k.GenerateTensorValue(GeneratorTensor_2<ADataType>{-5, 5});
-        b_k_n.GenerateTensorValue(GeneratorTensor_2<BDataType>{-5, 5});
-        c0_m_n.GenerateTensorValue(GeneratorTensor_2<CDataType>{-5, 5});
-        c1_m_n.GenerateTensorValue(GeneratorTensor_2<CDataType>{-5, 5});
+        b_k_n.GenerateTensorValue(GeneratorTensor_2<BDataType>{-5, 5, get_host_generator_seed(1)});
+        c0_m_n.GenerateTensorValue(GeneratorTensor_2<CDataType>{-5, 5, get_host_generator_seed(2)});
+        c1_m_n.GenerateTensorValue(GeneratorTensor_2<CDataType>{-5, 5, get_host_generator_seed(3)});
         break;
     default:
         a_m_k.GenerateTensorValue(GeneratorTensor_3<ADataType>{0.0, 1.0});
-        b_k_n.GenerateTensorValue(GeneratorTensor_3<BDataType>{-0.5, 0.5});
-        c0_m_n.GenerateTensorValue(GeneratorTensor_3<CDataType>{0.0, 1.0});
-        c1_m_n.GenerateTensorValue(GeneratorTensor_3<CDataType>{0.0, 1.0});
+        b_k_n.GenerateTensorValue(
+            GeneratorTensor_3<BDataType>{-0.5, 0.5, get_host_generator_seed(1)});
+        c0_m_n.GenerateTensorValue(
+            GeneratorTensor_3<CDataType>{0.0, 1.0, get_host_generator_seed(2)});
+        c1_m_n.GenerateTensorValue(
+            GeneratorTensor_3<CDataType>{0.0, 1.0, get_host_generator_seed(3)});
     }
 
     DeviceMem a_m_k_device_buf(sizeof(ADataType) * a_m_k.mDesc.GetElementSpace());
@@ -213,13 +213,17 @@ int main(int argc, char* argv[])
     case 0: break;
     case 1:
         in_n_c_hi_wi.GenerateTensorValue(GeneratorTensor_2<InDataType>{-5, 5});
-        wei_k_c_y_x.GenerateTensorValue(GeneratorTensor_2<WeiDataType>{-5, 5});
-        bias_k.GenerateTensorValue(GeneratorTensor_2<OutDataType>{-5, 5});
+        wei_k_c_y_x.GenerateTensorValue(
+            GeneratorTensor_2<WeiDataType>{-5, 5, get_host_generator_seed(1)});
+        bias_k.GenerateTensorValue(
+            GeneratorTensor_2<OutDataType>{-5, 5, get_host_generator_seed(2)});
         break;
     default:
         in_n_c_hi_wi.GenerateTensorValue(GeneratorTensor_3<InDataType>{0.0, 1.0});
-        wei_k_c_y_x.GenerateTensorValue(GeneratorTensor_3<WeiDataType>{-0.5, 0.5});
-        bias_k.GenerateTensorValue(GeneratorTensor_3<OutDataType>{0.0, 1.0});
+        wei_k_c_y_x.GenerateTensorValue(
+            GeneratorTensor_3<WeiDataType>{-0.5, 0.5, get_host_generator_seed(1)});
+        bias_k.GenerateTensorValue(
+            GeneratorTensor_3<OutDataType>{0.0, 1.0, get_host_generator_seed(2)});
     }
 
     DeviceMem in_device_buf(sizeof(InDataType) * in_n_c_hi_wi.mDesc.GetElementSpace());
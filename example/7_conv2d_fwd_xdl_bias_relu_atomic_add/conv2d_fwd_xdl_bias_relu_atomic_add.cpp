@@ -213,15 +213,21 @@ int main(int argc, char* argv[])
     case 0: break;
     case 1:
         in_n_c_hi_wi.GenerateTensorValue(GeneratorTensor_2<InDataType>{-5, 5});
-        wei_k_c_y_x.GenerateTensorValue(GeneratorTensor_2<WeiDataType>{-5, 5});
-        out_n_k_ho_wo_host_result.GenerateTensorValue(GeneratorTensor_2<OutDataType>{-5, 5});
-        bias_k.GenerateTensorValue(GeneratorTensor_2<OutDataType>{-5, 5});
+        wei_k_c_y_x.GenerateTensorValue(
+            GeneratorTensor_2<WeiDataType>{-5, 5, get_host_generator_seed(1)});
+        out_n_k_ho_wo_host_result.GenerateTensorValue(
+            GeneratorTensor_2<OutDataType>{-5, 5, get_host_generator_seed(2)});
+        bias_k.GenerateTensorValue(
+            GeneratorTensor_2<OutDataType>{-5, 5, get_host_generator_seed(3)});
         break;
     default:
         in_n_c_hi_wi.GenerateTensorValue(GeneratorTensor_3<InDataType>{0.0, 1.0});
-        wei_k_c_y_x.GenerateTensorValue(GeneratorTensor_3<WeiDataType>{-0.5, 0.5});
-        out_n_k_ho_wo_host_result.GenerateTensorValue(GeneratorTensor_3<OutDataType>{-0.5, 0.5});
-        bias_k.GenerateTensorValue(GeneratorTensor_3<OutDataType>{0.0, 1.0});
+        wei_k_c_y_x.GenerateTensorValue(
+            GeneratorTensor_3<WeiDataType>{-0.5, 0.5, get_host_generator_seed(1)});
+        out_n_k_ho_wo_host_result.GenerateTensorValue(
+            GeneratorTensor_3<OutDataType>{-0.5, 0.5, get_host_generator_seed(2)});
+        bias_k.GenerateTensorValue(
+            GeneratorTensor_3<OutDataType>{0.0, 1.0, get_host_generator_seed(3)});
     }
 
     DeviceMem in_device_buf(sizeof(InDataType) * in_n_c_hi_wi.mDesc.GetElementSpace());
@@ -11,15 +11,49 @@
 #include "host_tensor.hpp"
 #include "host_tensor_generator.hpp"
 #include "conv_common.hpp"
+#include "host_conv.hpp"
+#include "host_timer.hpp"
 #include "device_tensor.hpp"
 #include "device_convolution_add_forward_implicit_gemm_v5r1_dlops_nc0hwc1_kc0yxc1_nk0hwk1.hpp"
 
 #define USE_DYNAMIC_MODE 0
 #define USE_CONV_FWD_V5R1_NCHWC 1
+#define USE_CONV_FWD_HOST_NCHWC 1
 
 enum ConvForwardAlgo
 {
-    V5R1NCHWC // 0
+    V5R1NCHWC, // 0
+    HostNCHWC, // 1
+};
+
+// v = activ(conv(in, wei) + bias) is stored to out, and v + add to the 2 x 2 pixels of add_out
+// it is upsampled to
+template <typename TOut, typename TAdd>
+struct HostConvBiasActivAddNchwc : public HostIndexedElementwiseOperation
+{
+    HostConvBiasActivNchwc<TOut> bias_activ;
+    const Tensor<TAdd>* p_add;
+    Tensor<TAdd>* p_add_out;
+    std::size_t K1;
+
+    template <typename T>
+    T operator()(T v, std::size_t n, std::size_t k, std::size_t ho, std::size_t wo) const
+    {
+        v = bias_activ(v, n, k, ho, wo);
+
+        const std::size_t k0 = k / K1;
+        const std::size_t k1 = k % K1;
+
+        for(std::size_t hox2 = ho * 2; hox2 < ho * 2 + 2; ++hox2)
+            for(std::size_t wox2 = wo * 2; wox2 < wo * 2 + 2; ++wox2)
+            {
+                const T a = host_type_convert<T>((*p_add)(n, k0, hox2, wox2, k1));
+
+                (*p_add_out)(n, k0, hox2, wox2, k1) = host_type_convert<TAdd>(v + a);
+            }
+
+        return v;
+    }
 };
 
 template <typename TIn,
@@ -38,60 +72,21 @@ void host_direct_convolution_add_nchwc(const Tensor<TIn>& in,
                                        const ConvStrides& conv_strides,
                                        const ConvDilations& conv_dilations,
                                        const InLeftPads& in_left_pads,
-                                       const InRightPads&,
+                                       const InRightPads& in_right_pads,
                                        const ck::ActivTypeEnum_t activ_type)
 {
-    using namespace ck;
-
-    constexpr auto I0 = Number<0>{};
-    constexpr auto I1 = Number<1>{};
-
-    auto f_nchw = [&](auto n, auto k0, auto ho, auto wo, auto k1) {
-        double v = 0;
-        auto k   = k0 * out_host.mDesc.GetLengths()[4] + k1;
-
-        for(int c0 = 0; c0 < wei.mDesc.GetLengths()[1]; ++c0)
-        {
-            for(int y = 0; y < wei.mDesc.GetLengths()[2]; ++y)
-            {
-                int hi = ho * conv_strides[I0] + y * conv_dilations[I0] - in_left_pads[I0];
-                for(int x = 0; x < wei.mDesc.GetLengths()[3]; ++x)
-                {
-                    int wi = wo * conv_strides[I1] + x * conv_dilations[I1] - in_left_pads[I1];
-                    if(hi >= 0 && hi < in.mDesc.GetLengths()[2] && wi >= 0 &&
-                       wi < in.mDesc.GetLengths()[3])
-                    {
-
-                        for(int c1 = 0; c1 < wei.mDesc.GetLengths()[4]; ++c1)
-                        {
-                            v += static_cast<const double>(in(n, c0, hi, wi, c1)) *
-                                 static_cast<const double>(wei(k, c0, y, x, c1));
-                        }
-                    }
-                }
-            }
-        }
-
-        v += bias(k0, k1);
-        v = activ(v, activ_type);
-
-        const int hox2 = ho * 2;
-        const int wox2 = wo * 2;
-
-        out_host(n, k0, ho, wo, k1) = v;
-
-        add_host(n, k0, hox2, wox2, k1)         = v + add(n, k0, hox2, wox2, k1);
-        add_host(n, k0, hox2, wox2 + 1, k1)     = v + add(n, k0, hox2, wox2 + 1, k1);
-        add_host(n, k0, hox2 + 1, wox2, k1)     = v + add(n, k0, hox2 + 1, wox2, k1);
-        add_host(n, k0, hox2 + 1, wox2 + 1, k1) = v + add(n, k0, hox2 + 1, wox2 + 1, k1);
-    };
-
-    make_ParallelTensorFunctor(f_nchw,
-                               out_host.mDesc.GetLengths()[0],
-                               out_host.mDesc.GetLengths()[1],
-                               out_host.mDesc.GetLengths()[2],
-                               out_host.mDesc.GetLengths()[3],
-                               out_host.mDesc.GetLengths()[4])(std::thread::hardware_concurrency());
+    const HostConvBiasActivAddNchwc<TOut, TOut> bias_activ_add{
+        {}, {{}, bias.mData.data(), activ_type}, &add, &add_host, out_host.mDesc.GetLengths()[4]};
+
+    host_conv_nc0hwc1_kc0yxc1_nk0hwk1(in,
+                                      wei,
+                                      out_host,
+                                      conv_strides,
+                                      conv_dilations,
+                                      in_left_pads,
+                                      in_right_pads,
+                                      bias_activ_add,
+                                      HostGemmPrecision_t::Strict);
 }
 
 int main(int argc, char* argv[])
@@ -310,36 +305,42 @@ int main(int argc, char* argv[])
         // no initialization
         break;
     case 1:
-        in.GenerateTensorValue(GeneratorTensor_1{}, num_thread);
-        wei.GenerateTensorValue(GeneratorTensor_1{}, num_thread);
+        in.GenerateTensorValue(GeneratorTensor_1<in_data_t>{}, num_thread);
+        wei.GenerateTensorValue(GeneratorTensor_1<in_data_t>{}, num_thread);
         break;
     case 2:
-        in.GenerateTensorValue(GeneratorTensor_1{}, num_thread);
-        wei.GenerateTensorValue(GeneratorTensor_2{-5, 5}, num_thread);
+        in.GenerateTensorValue(GeneratorTensor_1<in_data_t>{}, num_thread);
+        wei.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5, get_host_generator_seed(1)},
+                                num_thread);
         break;
     case 3:
-        in.GenerateTensorValue(GeneratorTensor_2{-5, 5}, num_thread);
-        wei.GenerateTensorValue(GeneratorTensor_1{}, num_thread);
+        in.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5}, num_thread);
+        wei.GenerateTensorValue(GeneratorTensor_1<in_data_t>{}, num_thread);
         break;
     case 4:
-        in.GenerateTensorValue(GeneratorTensor_2{-5, 5}, num_thread);
-        wei.GenerateTensorValue(GeneratorTensor_2{-5, 5}, num_thread);
+        in.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5}, num_thread);
+        wei.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5, get_host_generator_seed(1)},
+                                num_thread);
         break;
     case 5:
         in.GenerateTensorValue(GeneratorTensor_3<float>{0.0, 1.0}, num_thread);
-        wei.GenerateTensorValue(GeneratorTensor_3<float>{-0.5, 0.5}, num_thread);
+        wei.GenerateTensorValue(GeneratorTensor_3<float>{-0.5, 0.5, get_host_generator_seed(1)},
+                                num_thread);
         break;
     default:
-        in.GenerateTensorValue(GeneratorTensor_2{1, 5}, num_thread);
+        in.GenerateTensorValue(GeneratorTensor_2<in_data_t>{1, 5}, num_thread);
 
-        auto gen_wei = [](auto... is) {
-            return GeneratorTensor_2{1, 5}(is...) * GeneratorTensor_Checkboard{}(is...);
+        // one generator for all elements, so they share a seed
+        const GeneratorTensor_2<in_data_t> gen{1, 5, get_host_generator_seed(1)};
+
+        auto gen_wei = [gen](auto... is) {
+            return gen(is...) * GeneratorTensor_Checkboard{}(is...);
         };
         wei.GenerateTensorValue(gen_wei, num_thread);
     }
 
-    bias.GenerateTensorValue(GeneratorTensor_1{}, num_thread);
-    add.GenerateTensorValue(GeneratorTensor_1{}, num_thread);
+    bias.GenerateTensorValue(GeneratorTensor_1<out_data_t>{}, num_thread);
+    add.GenerateTensorValue(GeneratorTensor_1<out_data_t>{}, num_thread);
 
     auto f_make_for_device_nchwc = [&]() {
         const auto in_lengths_dev     = make_tuple(N, C0, Hi, Wi, C1);
@@ -387,6 +388,36 @@ int main(int argc, char* argv[])
     }
 #endif
 
+#if USE_CONV_FWD_HOST_NCHWC
+    if(algo == ConvForwardAlgo::HostNCHWC)
+    {
+        Tensor<out_data_t> out_device(out_lengths_host);
+
+        const HostConvBiasActivAddNchwc<out_data_t, in_data_t> bias_activ_add{
+            {}, {{}, bias.mData.data(), activ_type}, &add, &add_device, std::size_t(K1)};
+
+        auto f_conv = [&]() {
+            host_conv_nc0hwc1_kc0yxc1_nk0hwk1(in,
+                                              wei,
+                                              out_device,
+                                              make_tuple(conv_stride_h, conv_stride_w),
+                                              make_tuple(conv_dilation_h, conv_dilation_w),
+                                              make_tuple(in_left_pad_h, in_left_pad_w),
+                                              make_tuple(in_right_pad_h, in_right_pad_w),
+                                              bias_activ_add,
+                                              HostGemmPrecision_t::Fast);
+        };
+
+        const float ave_time = launch_and_time_host_kernel(f_conv, nrepeat);
+
+        const float perf =
+            static_cast<float>(std::size_t(2) * N * K0 * K1 * Ho * Wo * C0 * C1 * Y * X) /
+            (std::size_t(1000) * 1000 * 1000) / ave_time;
+
+        std::cout << "Average time : " << ave_time << " ms, " << perf << " TFlop/s" << std::endl;
+    }
+#endif
+
     if(do_verification)
     {
         host_direct_convolution_add_nchwc(in,
@@ -11,6 +11,7 @@
 #include "host_tensor.hpp"
 #include "host_tensor_generator.hpp"
 #include "conv_common.hpp"
+#include "host_conv_bwd_data.hpp"
 #include "device_tensor.hpp"
 #include "device_convolution_backward_data_implicit_gemm_v4r1_xdlops_nhwc_kyxc_nhwk.hpp"
 #include "device_convolution_backward_data_implicit_gemm_v4r1r2_xdlops_nhwc_kyxc_nhwk.hpp"
@@ -48,125 +49,51 @@ void host_convolution_backward_data(Tensor<TIn>& in,
                                     const ConvStrides& conv_strides,
                                     const ConvDilations& conv_dilations,
                                     const InLeftPads& in_left_pads,
-                                    const InRightPads& /* in_right_pads */,
+                                    const InRightPads& in_right_pads,
                                     const ConvTensorLayout layout = ConvTensorLayout::NCHW)
 {
     using namespace ck;
 
     constexpr auto I0 = Number<0>{};
     constexpr auto I1 = Number<1>{};
-    constexpr auto I2 = Number<2>{};
-    constexpr auto I3 = Number<3>{};
-
-    auto f_nchw = [&](auto n, auto c, auto hi, auto wi) {
-        std::size_t K = wei.mDesc.GetLengths()[I0];
-        std::size_t Y = wei.mDesc.GetLengths()[I2];
-        std::size_t X = wei.mDesc.GetLengths()[I3];
-
-        std::size_t Ho = out.mDesc.GetLengths()[I2];
-        std::size_t Wo = out.mDesc.GetLengths()[I3];
-
-        double v = 0;
-
-        for(int y = 0; y < Y; ++y)
-        {
-            int h_tmp = hi + in_left_pads[I0] - y * conv_dilations[I0];
-
-            if(h_tmp % conv_strides[I0] == 0)
-            {
-                int ho = h_tmp / conv_strides[I0];
-
-                if(ho >= 0 && ho < Ho)
-                {
-                    for(int x = 0; x < X; ++x)
-                    {
-                        int w_tmp = wi + in_left_pads[I1] - x * conv_dilations[I1];
-
-                        if(w_tmp % conv_strides[I1] == 0)
-                        {
-                            int wo = w_tmp / conv_strides[I1];
-
-                            if(wo >= 0 && wo < Wo)
-                            {
-                                for(int k = 0; k < K; ++k)
-                                {
-                                    v += out(n, k, ho, wo) * wei(k, c, y, x);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-
-        in(n, c, hi, wi) = v;
-    };
 
-    auto f_nhwc = [&](auto n, auto hi, auto wi, auto c) {
-        std::size_t K = wei.mDesc.GetLengths()[I0];
-        std::size_t Y = wei.mDesc.GetLengths()[I1];
-        std::size_t X = wei.mDesc.GetLengths()[I2];
-
-        std::size_t Ho = out.mDesc.GetLengths()[I1];
-        std::size_t Wo = out.mDesc.GetLengths()[I2];
-
-        double v = 0;
-
-        for(int y = 0; y < Y; ++y)
-        {
-            int h_tmp = hi + in_left_pads[I0] - y * conv_dilations[I0];
-
-            if(h_tmp % conv_strides[I0] == 0)
-            {
-                int ho = h_tmp / conv_strides[I0];
-
-                if(ho >= 0 && ho < Ho)
-                {
-                    for(int x = 0; x < X; ++x)
-                    {
-                        int w_tmp = wi + in_left_pads[I1] - x * conv_dilations[I1];
-
-                        if(w_tmp % conv_strides[I1] == 0)
-                        {
-                            int wo = w_tmp / conv_strides[I1];
-
-                            if(wo >= 0 && wo < Wo)
-                            {
-                                for(int k = 0; k < K; ++k)
-                                {
-                                    v += out(n, ho, wo, k) * wei(k, y, x, c);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-
-        in(n, hi, wi, c) = v;
-    };
+    HostConvTensorLayout_t host_layout;
 
     if(layout == ConvTensorLayout::NCHW)
     {
-        make_ParallelTensorFunctor(f_nchw,
-                                   in.mDesc.GetLengths()[0],
-                                   in.mDesc.GetLengths()[1],
-                                   in.mDesc.GetLengths()[2],
-                                   in.mDesc.GetLengths()[3])(std::thread::hardware_concurrency());
+        host_layout = HostConvTensorLayout_t::NCHW;
     }
     else if(layout == ConvTensorLayout::NHWC)
     {
-        make_ParallelTensorFunctor(f_nhwc,
-                                   in.mDesc.GetLengths()[0],
-                                   in.mDesc.GetLengths()[1],
-                                   in.mDesc.GetLengths()[2],
-                                   in.mDesc.GetLengths()[3])(std::thread::hardware_concurrency());
+        host_layout = HostConvTensorLayout_t::NHWC;
     }
     else
     {
         throw std::runtime_error("wrong! not supported layout");
     }
+
+    const auto problem = make_HostConvProblem(
+        in.mDesc,
+        wei.mDesc,
+        out.mDesc,
+        {static_cast<std::size_t>(conv_strides[I0]), static_cast<std::size_t>(conv_strides[I1])},
+        {static_cast<std::size_t>(conv_dilations[I0]),
+         static_cast<std::size_t>(conv_dilations[I1])},
+        {static_cast<std::size_t>(in_left_pads[I0]), static_cast<std::size_t>(in_left_pads[I1])},
+        {static_cast<std::size_t>(in_right_pads[I0]), static_cast<std::size_t>(in_right_pads[I1])},
+        host_layout);
+
+    auto pass_through = [](auto v) { return v; };
+
+    host_conv_bwd_data_gemm<double>(problem,
+                                    in.mData.data(),
+                                    wei.mData.data(),
+                                    out.mData.data(),
+                                    pass_through,
+                                    pass_through,
+                                    pass_through);
 }
+
 int main(int argc, char* argv[])
 {
     using namespace ck;
@@ -330,7 +257,8 @@ int main(int argc, char* argv[])
         break;
     case 2:
         out.GenerateTensorValue(GeneratorTensor_1<out_data_t>{}, num_thread);
-        wei.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5}, num_thread);
+        wei.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5, get_host_generator_seed(1)},
+                                num_thread);
         break;
     case 3:
         out.GenerateTensorValue(GeneratorTensor_2<out_data_t>{-5, 5}, num_thread);
@@ -338,17 +266,22 @@ int main(int argc, char* argv[])
         break;
     case 4:
         out.GenerateTensorValue(GeneratorTensor_2<out_data_t>{-5, 5}, num_thread);
-        wei.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5}, num_thread);
+        wei.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5, get_host_generator_seed(1)},
+                                num_thread);
         break;
     case 5:
         out.GenerateTensorValue(GeneratorTensor_3<out_data_t>{0.0, 1.0}, num_thread);
-        wei.GenerateTensorValue(GeneratorTensor_3<in_data_t>{-0.5, 0.5}, num_thread);
+        wei.GenerateTensorValue(GeneratorTensor_3<in_data_t>{-0.5, 0.5, get_host_generator_seed(1)},
+                                num_thread);
         break;
     default:
         out.GenerateTensorValue(GeneratorTensor_2<out_data_t>{1, 5}, num_thread);
 
-        auto gen_wei = [](auto... is) {
-            return GeneratorTensor_2<in_data_t>{1, 5}(is...) * GeneratorTensor_Checkboard{}(is...);
+        // one generator for all elements, so they share a seed
+        const GeneratorTensor_2<in_data_t> gen{1, 5, get_host_generator_seed(1)};
+
+        auto gen_wei = [gen](auto... is) {
+            return gen(is...) * GeneratorTensor_Checkboard{}(is...);
         };
         wei.GenerateTensorValue(gen_wei, num_thread);
     }
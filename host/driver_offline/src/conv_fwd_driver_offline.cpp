@@ -10,7 +10,9 @@
 #include "device.hpp"
 #include "host_tensor.hpp"
 #include "host_tensor_generator.hpp"
+#include "host_tensor_file.hpp"
 #include "conv_common.hpp"
+#include "host_conv_fwd_im2col.hpp"
 #include "device_tensor.hpp"
 #include "device_convolution_forward_implicit_gemm_v4r4_dlops_nchw_kcyx_nkhw.hpp"
 #include "device_convolution_forward_implicit_gemm_v4r4r2_dlops_nhwc_kyxc_nhwk.hpp"
@@ -56,7 +58,7 @@ void host_convolution_forward(const Tensor<TIn>& in,
                               const ConvStrides& conv_strides,
                               const ConvDilations& conv_dilations,
                               const InLeftPads& in_left_pads,
-                              const InRightPads&,
+                              const InRightPads& in_right_pads,
                               const ConvTensorLayout layout = ConvTensorLayout::NCHW)
 {
     using namespace ck;
@@ -64,101 +66,42 @@ void host_convolution_forward(const Tensor<TIn>& in,
     constexpr auto I0 = Number<0>{};
     constexpr auto I1 = Number<1>{};
 
-    auto f_nchw = [&](auto n, auto k, auto ho, auto wo) {
-        double v = 0;
-        for(int c = 0; c < wei.mDesc.GetLengths()[1]; ++c)
-        {
-            for(int y = 0; y < wei.mDesc.GetLengths()[2]; ++y)
-            {
-                int hi = ho * conv_strides[I0] + y * conv_dilations[I0] - in_left_pads[I0];
-                for(int x = 0; x < wei.mDesc.GetLengths()[3]; ++x)
-                {
-                    int wi = wo * conv_strides[I1] + x * conv_dilations[I1] - in_left_pads[I1];
-                    if(hi >= 0 && hi < in.mDesc.GetLengths()[2] && wi >= 0 &&
-                       wi < in.mDesc.GetLengths()[3])
-                    {
-                        if constexpr(is_same<TIn, ushort>::value)
-                        {
-                            v += ck::type_convert<float>(in(n, c, hi, wi)) *
-                                 ck::type_convert<float>(wei(k, c, y, x));
-                        }
-                        else
-                        {
-                            v += static_cast<const double>(in(n, c, hi, wi)) *
-                                 static_cast<const double>(wei(k, c, y, x));
-                        }
-                    }
-                }
-            }
-        }
-
-        if constexpr(is_same<TOut, ushort>::value)
-        {
-            out(n, k, ho, wo) = ck::type_convert<ushort>(static_cast<float>(v));
-        }
-        else
-        {
-            out(n, k, ho, wo) = v;
-        }
-    };
-
-    auto f_nhwc = [&](auto n, auto ho, auto wo, auto k) {
-        double v = 0;
-        for(int c = 0; c < wei.mDesc.GetLengths()[3]; ++c)
-        {
-            for(int y = 0; y < wei.mDesc.GetLengths()[1]; ++y)
-            {
-                int hi = ho * conv_strides[I0] + y * conv_dilations[I0] - in_left_pads[I0];
-                for(int x = 0; x < wei.mDesc.GetLengths()[2]; ++x)
-                {
-                    int wi = wo * conv_strides[I1] + x * conv_dilations[I1] - in_left_pads[I1];
-                    if(hi >= 0 && hi < in.mDesc.GetLengths()[1] && wi >= 0 &&
-                       wi < in.mDesc.GetLengths()[2])
-                    {
-                        if constexpr(is_same<TIn, ushort>::value)
-                        {
-                            v += ck::type_convert<float>(in(n, hi, wi, c)) *
-                                 ck::type_convert<float>(wei(k, y, x, c));
-                        }
-                        else
-                        {
-                            v += static_cast<const double>(in(n, hi, wi, c)) *
-                                 static_cast<const double>(wei(k, y, x, c));
-                        }
-                    }
-                }
-            }
-        }
-        if constexpr(is_same<TOut, ushort>::value)
-        {
-            out(n, ho, wo, k) = ck::type_convert<ushort>(static_cast<float>(v));
-        }
-        else
-        {
-            out(n, ho, wo, k) = v;
-        }
-    };
+    HostConvTensorLayout_t host_layout;
 
     if(layout == ConvTensorLayout::NCHW)
     {
-        make_ParallelTensorFunctor(f_nchw,
-                                   out.mDesc.GetLengths()[0],
-                                   out.mDesc.GetLengths()[1],
-                                   out.mDesc.GetLengths()[2],
-                                   out.mDesc.GetLengths()[3])(std::thread::hardware_concurrency());
+        host_layout = HostConvTensorLayout_t::NCHW;
     }
     else if(layout == ConvTensorLayout::NHWC)
     {
-        make_ParallelTensorFunctor(f_nhwc,
-                                   out.mDesc.GetLengths()[0],
-                                   out.mDesc.GetLengths()[1],
-                                   out.mDesc.GetLengths()[2],
-                                   out.mDesc.GetLengths()[3])(std::thread::hardware_concurrency());
+        host_layout = HostConvTensorLayout_t::NHWC;
     }
     else
     {
         throw std::runtime_error("wrong! not supported layout");
     }
+
+    const auto problem = make_HostConvProblem(
+        in.mDesc,
+        wei.mDesc,
+        out.mDesc,
+        {static_cast<std::size_t>(conv_strides[I0]), static_cast<std::size_t>(conv_strides[I1])},
+        {static_cast<std::size_t>(conv_dilations[I0]),
+         static_cast<std::size_t>(conv_dilations[I1])},
+        {static_cast<std::size_t>(in_left_pads[I0]), static_cast<std::size_t>(in_left_pads[I1])},
+        {static_cast<std::size_t>(in_right_pads[I0]), static_cast<std::size_t>(in_right_pads[I1])},
+        host_layout);
+
+    // bf16 (ushort) in, wei and out are converted by the engine
+    auto pass_through = [](auto v) { return v; };
+
+    host_conv_fwd_im2col<double>(problem,
+                                 in.mData.data(),
+                                 wei.mData.data(),
+                                 out.mData.data(),
+                                 pass_through,
+                                 pass_through,
+                                 pass_through);
 }
 
 int main(int argc, char* argv[])
@@ -332,7 +275,8 @@ int main(int argc, char* argv[])
         break;
     case 2:
         in.GenerateTensorValue(GeneratorTensor_1<in_data_t>{}, num_thread);
-        wei.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5}, num_thread);
+        wei.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5, get_host_generator_seed(1)},
+                                num_thread);
         break;
     case 3:
         in.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5}, num_thread);
@@ -340,17 +284,22 @@ int main(int argc, char* argv[])
         break;
     case 4:
         in.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5}, num_thread);
-        wei.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5}, num_thread);
+        wei.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5, get_host_generator_seed(1)},
+                                num_thread);
         break;
     case 5:
         in.GenerateTensorValue(GeneratorTensor_3<in_data_t>{0.0, 1.0}, num_thread);
-        wei.GenerateTensorValue(GeneratorTensor_3<in_data_t>{-0.5, 0.5}, num_thread);
+        wei.GenerateTensorValue(GeneratorTensor_3<in_data_t>{-0.5, 0.5, get_host_generator_seed(1)},
+                                num_thread);
         break;
     default:
         in.GenerateTensorValue(GeneratorTensor_2<in_data_t>{1, 5}, num_thread);
 
-        auto gen_wei = [](auto... is) {
-            return GeneratorTensor_2<in_data_t>{1, 5}(is...) * GeneratorTensor_Checkboard{}(is...);
+        // one generator for all elements, so they share a seed
+        const GeneratorTensor_2<in_data_t> gen{1, 5, get_host_generator_seed(1)};
+
+        auto gen_wei = [gen](auto... is) {
+            return gen(is...) * GeneratorTensor_Checkboard{}(is...);
         };
         wei.GenerateTensorValue(gen_wei, num_thread);
     }
@@ -525,14 +474,33 @@ int main(int argc, char* argv[])
 
     if(do_verification)
     {
-        host_convolution_forward(in,
-                                 wei,
-                                 out_host,
-                                 make_tuple(conv_stride_h, conv_stride_w),
-                                 make_tuple(conv_dilation_h, conv_dilation_w),
-                                 make_tuple(in_left_pad_h, in_left_pad_w),
-                                 make_tuple(in_right_pad_h, in_right_pad_w),
-                                 layout);
+        // reused from CK_HOST_TENSOR_CACHE if the same problem was verified before
+        HostTensorCache::GetInstance().GetOrCreate(
+            out_host,
+            [&] {
+                return make_host_tensor_cache_key("conv_fwd",
+                                                  layout,
+                                                  in,
+                                                  wei,
+                                                  conv_stride_h,
+                                                  conv_stride_w,
+                                                  conv_dilation_h,
+                                                  conv_dilation_w,
+                                                  in_left_pad_h,
+                                                  in_left_pad_w,
+                                                  in_right_pad_h,
+                                                  in_right_pad_w);
+            },
+            [&](auto& out) {
+                host_convolution_forward(in,
+                                         wei,
+                                         out,
+                                         make_tuple(conv_stride_h, conv_stride_w),
+                                         make_tuple(conv_dilation_h, conv_dilation_w),
+                                         make_tuple(in_left_pad_h, in_left_pad_w),
+                                         make_tuple(in_right_pad_h, in_right_pad_w),
+                                         layout);
+            });
 
         check_error(out_host, out_device);
 
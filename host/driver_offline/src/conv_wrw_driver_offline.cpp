@@ -11,6 +11,7 @@
 #include "host_tensor.hpp"
 #include "host_tensor_generator.hpp"
 #include "conv_common.hpp"
+#include "host_conv_bwd_weight.hpp"
 #include "device_tensor.hpp"
 #include "device_convolution_backward_weight_implicit_gemm_v4r4r2_xdlops_nchw_kcyx_nkhw.hpp"
 #include "device_convolution_backward_weight_implicit_gemm_v4r4r4_xdlops_nhwc_kyxc_nhwk.hpp"
@@ -56,77 +57,49 @@ void host_convolution_backward_weight(const Tensor<TOut>& out,
                                       const ConvStrides& conv_strides,
                                       const ConvDilations& conv_dilations,
                                       const InLeftPads& in_left_pads,
-                                      const InRightPads&,
+                                      const InRightPads& in_right_pads,
                                       const ConvTensorLayout layout = ConvTensorLayout::NCHW)
 {
     using namespace ck;
 
     constexpr auto I0 = Number<0>{};
     constexpr auto I1 = Number<1>{};
-    auto f_kcyx       = [&](auto k, auto c, auto y, auto x) {
-        double v = 0;
-        for(int n = 0; n < out.mDesc.GetLengths()[0]; ++n)
-        {
-            for(int ho = 0; ho < out.mDesc.GetLengths()[2]; ++ho)
-            {
-                int hi = ho * conv_strides[I0] + y * conv_dilations[I0] - in_left_pads[I0];
-                for(int wo = 0; wo < out.mDesc.GetLengths()[3]; ++wo)
-                {
-                    int wi = wo * conv_strides[I1] + x * conv_dilations[I1] - in_left_pads[I1];
-                    if(hi >= 0 && hi < in.mDesc.GetLengths()[2] && wi >= 0 &&
-                       wi < in.mDesc.GetLengths()[3])
-                    {
-                        v += static_cast<const double>(in(n, c, hi, wi)) *
-                             static_cast<const double>(out(n, k, ho, wo));
-                    }
-                }
-            }
-        }
-        wei(k, c, y, x) = v;
-    };
 
-    auto f_kyxc = [&](auto k, auto y, auto x, auto c) {
-        double v = 0;
-        for(int n = 0; n < out.mDesc.GetLengths()[0]; ++n)
-        {
-            for(int ho = 0; ho < out.mDesc.GetLengths()[1]; ++ho)
-            {
-                int hi = ho * conv_strides[I0] + y * conv_dilations[I0] - in_left_pads[I0];
-                for(int wo = 0; wo < out.mDesc.GetLengths()[2]; ++wo)
-                {
-                    int wi = wo * conv_strides[I1] + x * conv_dilations[I1] - in_left_pads[I1];
-                    if(hi >= 0 && hi < in.mDesc.GetLengths()[1] && wi >= 0 &&
-                       wi < in.mDesc.GetLengths()[2])
-                    {
-                        v += static_cast<const double>(in(n, hi, wi, c)) *
-                             static_cast<const double>(out(n, ho, wo, k));
-                    }
-                }
-            }
-        }
-        wei(k, y, x, c) = v;
-    };
+    HostConvTensorLayout_t host_layout;
 
     if(layout == ConvTensorLayout::NCHW)
     {
-        make_ParallelTensorFunctor(f_kcyx,
-                                   wei.mDesc.GetLengths()[0],
-                                   wei.mDesc.GetLengths()[1],
-                                   wei.mDesc.GetLengths()[2],
-                                   wei.mDesc.GetLengths()[3])(std::thread::hardware_concurrency());
+        host_layout = HostConvTensorLayout_t::NCHW;
     }
     else if(layout == ConvTensorLayout::NHWC)
     {
-        make_ParallelTensorFunctor(f_kyxc,
-                                   wei.mDesc.GetLengths()[0],
-                                   wei.mDesc.GetLengths()[1],
-                                   wei.mDesc.GetLengths()[2],
-                                   wei.mDesc.GetLengths()[3])(std::thread::hardware_concurrency());
+        host_layout = HostConvTensorLayout_t::NHWC;
     }
     else
     {
         throw std::runtime_error("wrong! not supported layout");
     }
+
+    const auto problem = make_HostConvProblem(
+        in.mDesc,
+        wei.mDesc,
+        out.mDesc,
+        {static_cast<std::size_t>(conv_strides[I0]), static_cast<std::size_t>(conv_strides[I1])},
+        {static_cast<std::size_t>(conv_dilations[I0]),
+         static_cast<std::size_t>(conv_dilations[I1])},
+        {static_cast<std::size_t>(in_left_pads[I0]), static_cast<std::size_t>(in_left_pads[I1])},
+        {static_cast<std::size_t>(in_right_pads[I0]), static_cast<std::size_t>(in_right_pads[I1])},
+        host_layout);
+
+    auto pass_through = [](auto v) { return v; };
+
+    host_conv_bwd_weight_gemm<double>(problem,
+                                      in.mData.data(),
+                                      wei.mData.data(),
+                                      out.mData.data(),
+                                      pass_through,
+                                      pass_through,
+                                      pass_through);
 }
 
 int main(int argc, char* argv[])
@@ -302,7 +275,8 @@ int main(int argc, char* argv[])
         break;
     case 2:
         in.GenerateTensorValue(GeneratorTensor_1<in_data_t>{}, num_thread);
-        out.GenerateTensorValue(GeneratorTensor_2<out_data_t>{-5, 5}, num_thread);
+        out.GenerateTensorValue(GeneratorTensor_2<out_data_t>{-5, 5, get_host_generator_seed(1)},
+                                num_thread);
         break;
     case 3:
         in.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5}, num_thread);
@@ -310,17 +284,22 @@ int main(int argc, char* argv[])
         break;
     case 4:
         in.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5}, num_thread);
-        out.GenerateTensorValue(GeneratorTensor_2<out_data_t>{-5, 5}, num_thread);
+        out.GenerateTensorValue(GeneratorTensor_2<out_data_t>{-5, 5, get_host_generator_seed(1)},
+                                num_thread);
         break;
     case 5:
         in.GenerateTensorValue(GeneratorTensor_3<in_data_t>{-0.1, 0.1}, num_thread);
-        out.GenerateTensorValue(GeneratorTensor_3<out_data_t>{-0.1, 0.1}, num_thread);
+        out.GenerateTensorValue(
+            GeneratorTensor_3<out_data_t>{-0.1, 0.1, get_host_generator_seed(1)}, num_thread);
         break;
     default:
         in.GenerateTensorValue(GeneratorTensor_2<in_data_t>{1, 5}, num_thread);
 
-        auto gen_out = [](auto... is) {
-            return GeneratorTensor_2<out_data_t>{1, 5}(is...) * GeneratorTensor_Checkboard{}(is...);
+        // one generator for all elements, so they share a seed
+        const GeneratorTensor_2<out_data_t> gen{1, 5, get_host_generator_seed(1)};
+
+        auto gen_out = [gen](auto... is) {
+            return gen(is...) * GeneratorTensor_Checkboard{}(is...);
         };
         out.GenerateTensorValue(gen_out, num_thread);
     }
@@ -11,6 +11,7 @@
 #include "host_tensor.hpp"
 #include "host_tensor_generator.hpp"
 #include "host_gemm.hpp"
+#include "element_wise_operation.hpp"
 #include "device_tensor.hpp"
 #include "device_gemm_xdlops_mk_kn_mn.hpp"
 #include "device_gemm_xdlops_mk_nk_mn.hpp"
@@ -60,155 +61,49 @@ void host_gemm(const Tensor<AType>& a,
                Tensor<CType>& c,
                const GemmMatrixLayout layout)
 {
-    if(layout == GemmMatrixLayout::MK_KN_MN)
-    {
-        auto f_mk_kn_mn = [&](auto m, auto n) {
-            const int K = a.mDesc.GetLengths()[1];
-
-            double v = 0;
-
-            for(int k = 0; k < K; ++k)
-            {
-                v += static_cast<const double>(a(m, k)) * static_cast<const double>(b(k, n));
-            }
-
-            c(m, n) = v;
-        };
-
-        make_ParallelTensorFunctor(f_mk_kn_mn, c.mDesc.GetLengths()[0], c.mDesc.GetLengths()[1])(
-            std::thread::hardware_concurrency());
-    }
-    else if(layout == GemmMatrixLayout::MK_NK_MN)
-    {
-        auto f_mk_nk_mn = [&](auto m, auto n) {
-            const int K = a.mDesc.GetLengths()[1];
-
-            double v = 0;
-
-            for(int k = 0; k < K; ++k)
-            {
-                v += static_cast<const double>(a(m, k)) * static_cast<const double>(b(n, k));
-            }
-
-            c(m, n) = v;
-        };
-
-        make_ParallelTensorFunctor(f_mk_nk_mn, c.mDesc.GetLengths()[0], c.mDesc.GetLengths()[1])(
-            std::thread::hardware_concurrency());
-    }
-    else if(layout == GemmMatrixLayout::KM_KN_MN)
-    {
-        auto f_km_kn_mn = [&](auto m, auto n) {
-            const int K = a.mDesc.GetLengths()[0];
-
-            double v = 0;
-
-            for(int k = 0; k < K; ++k)
-            {
-                v += static_cast<const double>(a(k, m)) * static_cast<const double>(b(k, n));
-            }
-
-            c(m, n) = v;
-        };
-
-        make_ParallelTensorFunctor(f_km_kn_mn, c.mDesc.GetLengths()[0], c.mDesc.GetLengths()[1])(
-            std::thread::hardware_concurrency());
-    }
-    else if(layout == GemmMatrixLayout::KM_NK_MN)
-    {
-        auto f_km_nk_mn = [&](auto m, auto n) {
-            const int K = a.mDesc.GetLengths()[0];
-
-            double v = 0;
-
-            for(int k = 0; k < K; ++k)
-            {
-                v += static_cast<const double>(a(k, m)) * static_cast<const double>(b(n, k));
-            }
-
-            c(m, n) = v;
-        };
-
-        make_ParallelTensorFunctor(f_km_nk_mn, c.mDesc.GetLengths()[0], c.mDesc.GetLengths()[1])(
-            std::thread::hardware_concurrency());
-    }
-    else if(layout == GemmMatrixLayout::MK_KN_NM)
-    {
-        auto f_mk_kn_nm = [&](auto n, auto m) {
-            const int K = a.mDesc.GetLengths()[1];
-
-            double v = 0;
-
-            for(int k = 0; k < K; ++k)
-            {
-                v += static_cast<const double>(a(m, k)) * static_cast<const double>(b(k, n));
-            }
-
-            c(n, m) = v;
-        };
-
-        make_ParallelTensorFunctor(f_mk_kn_nm, c.mDesc.GetLengths()[0], c.mDesc.GetLengths()[1])(
-            std::thread::hardware_concurrency());
-    }
-    else if(layout == GemmMatrixLayout::MK_NK_NM)
-    {
-        auto f_mk_nk_nm = [&](auto n, auto m) {
-            const int K = a.mDesc.GetLengths()[1];
-
-            double v = 0;
-
-            for(int k = 0; k < K; ++k)
-            {
-                v += static_cast<const double>(a(m, k)) * static_cast<const double>(b(n, k));
-            }
-
-            c(n, m) = v;
-        };
-
-        make_ParallelTensorFunctor(f_mk_nk_nm, c.mDesc.GetLengths()[0], c.mDesc.GetLengths()[1])(
-            std::thread::hardware_concurrency());
-    }
-    else if(layout == GemmMatrixLayout::KM_KN_NM)
-    {
-        auto f_km_kn_nm = [&](auto n, auto m) {
-            const int K = a.mDesc.GetLengths()[0];
-
-            double v = 0;
-
-            for(int k = 0; k < K; ++k)
-            {
-                v += static_cast<const double>(a(k, m)) * static_cast<const double>(b(k, n));
-            }
-
-            c(n, m) = v;
-        };
-
-        make_ParallelTensorFunctor(f_km_kn_nm, c.mDesc.GetLengths()[0], c.mDesc.GetLengths()[1])(
-            std::thread::hardware_concurrency());
-    }
-    else if(layout == GemmMatrixLayout::KM_NK_NM)
-    {
-        auto f_km_nk_nm = [&](auto n, auto m) {
-            const int K = a.mDesc.GetLengths()[0];
-
-            double v = 0;
-
-            for(int k = 0; k < K; ++k)
-            {
-                v += static_cast<const double>(a(k, m)) * static_cast<const double>(b(n, k));
-            }
-
-            c(n, m) = v;
-        };
-
-        make_ParallelTensorFunctor(f_km_nk_nm, c.mDesc.GetLengths()[0], c.mDesc.GetLengths()[1])(
-            std::thread::hardware_concurrency());
-    }
-    else
+    if(layout < GemmMatrixLayout::MK_KN_MN || layout > GemmMatrixLayout::KM_NK_NM)
     {
         throw std::runtime_error("wrong! not supported layout");
     }
+
+    const bool a_km = layout == GemmMatrixLayout::KM_KN_MN ||
+                      layout == GemmMatrixLayout::KM_NK_MN ||
+                      layout == GemmMatrixLayout::KM_KN_NM || layout == GemmMatrixLayout::KM_NK_NM;
+    const bool b_nk = layout == GemmMatrixLayout::MK_NK_MN ||
+                      layout == GemmMatrixLayout::KM_NK_MN ||
+                      layout == GemmMatrixLayout::MK_NK_NM || layout == GemmMatrixLayout::KM_NK_NM;
+    const bool c_nm = layout == GemmMatrixLayout::MK_KN_NM ||
+                      layout == GemmMatrixLayout::MK_NK_NM ||
+                      layout == GemmMatrixLayout::KM_KN_NM || layout == GemmMatrixLayout::KM_NK_NM;
+
+    const auto& a_strides = a.mDesc.GetStrides();
+    const auto& b_strides = b.mDesc.GetStrides();
+    const auto& c_strides = c.mDesc.GetStrides();
+
+    const std::size_t M = c.mDesc.GetLengths()[c_nm ? 1 : 0];
+    const std::size_t N = c.mDesc.GetLengths()[c_nm ? 0 : 1];
+    const std::size_t K = a.mDesc.GetLengths()[a_km ? 0 : 1];
+
+    using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+    // all 8 layouts only differ in which stride walks M/N/K
+    host_gemm_blocked<double>(M,
+                              N,
+                              K,
+                              a.mData.data(),
+                              a_km ? a_strides[1] : a_strides[0],
+                              a_km ? a_strides[0] : a_strides[1],
+                              b.mData.data(),
+                              b_nk ? b_strides[1] : b_strides[0],
+                              b_nk ? b_strides[0] : b_strides[1],
+                              c.mData.data(),
+                              c_nm ? c_strides[1] : c_strides[0],
+                              c_nm ? c_strides[0] : c_strides[1],
+                              PassThrough{},
+                              PassThrough{},
+                              PassThrough{});
 }
+
 int main(int argc, char* argv[])
 {
     using namespace ck;
@@ -326,7 +221,8 @@ int main(int argc, char* argv[])
         break;
     case 2:
         a.GenerateTensorValue(GeneratorTensor_1<ab_data_t>{}, num_thread);
-        b.GenerateTensorValue(GeneratorTensor_2<ab_data_t>{-5, 5}, num_thread);
+        b.GenerateTensorValue(GeneratorTensor_2<ab_data_t>{-5, 5, get_host_generator_seed(1)},
+                              num_thread);
         break;
     case 3:
         a.GenerateTensorValue(GeneratorTensor_2<ab_data_t>{-5, 5}, num_thread);
@@ -334,11 +230,13 @@ int main(int argc, char* argv[])
         break;
     case 4:
         a.GenerateTensorValue(GeneratorTensor_2<ab_data_t>{-5, 5}, num_thread);
-        b.GenerateTensorValue(GeneratorTensor_2<ab_data_t>{-5, 5}, num_thread);
+        b.GenerateTensorValue(GeneratorTensor_2<ab_data_t>{-5, 5, get_host_generator_seed(1)},
+                              num_thread);
         break;
     default:
         a.GenerateTensorValue(GeneratorTensor_3<ab_data_t>{0.0, 1.0}, num_thread);
-        b.GenerateTensorValue(GeneratorTensor_3<ab_data_t>{-0.5, 0.5}, num_thread);
+        b.GenerateTensorValue(GeneratorTensor_3<ab_data_t>{-0.5, 0.5, get_host_generator_seed(1)},
+                              num_thread);
     }
 
 #if USE_GEMM_XDL_MK_KN_MN
@@ -0,0 +1,253 @@
+#include <iostream>
+#include <numeric>
+#include <initializer_list>
+#include <cstdlib>
+#include <stdlib.h>
+#include <half.hpp>
+#include "config.hpp"
+#include "print.hpp"
+#include "host_tensor.hpp"
+#include "host_tensor_generator.hpp"
+#include "host_reduction.hpp"
+#include "host_timer.hpp"
+
+// element-by-element reduction in the order of the flattened to-reduce dimensions, in double
+template <typename TIn, typename TOut, typename TIndex>
+void host_direct_reduce(const Tensor<TIn>& in,
+                        Tensor<TOut>& out,
+                        Tensor<TIndex>& indices,
+                        const std::vector<int>& reduce_dims,
+                        ck::ReduceTensorOp_t op,
+                        ck::NanPropagation_t nan_opt)
+{
+    using ck::ReduceTensorOp_t;
+
+    const auto& lengths = in.mDesc.GetLengths();
+    const auto& strides = in.mDesc.GetStrides();
+
+    std::vector<std::size_t> invariant_dims, to_reduce_dims;
+
+    for(std::size_t d = 0; d < lengths.size(); ++d)
+    {
+        if(std::count(reduce_dims.begin(), reduce_dims.end(), int(d)) > 0)
+            to_reduce_dims.push_back(d);
+        else
+            invariant_dims.push_back(d);
+    }
+
+    auto f_offset = [&](const std::vector<std::size_t>& dims, std::size_t i) {
+        std::size_t offset = 0;
+
+        for(std::size_t k = dims.size(); k-- > 0;)
+        {
+            offset += i % lengths[dims[k]] * strides[dims[k]];
+            i /= lengths[dims[k]];
+        }
+
+        return offset;
+    };
+
+    std::size_t reduce_length = 1;
+
+    for(auto d : to_reduce_dims)
+        reduce_length *= lengths[d];
+
+    const bool indexable = op == ReduceTensorOp_t::MIN || op == ReduceTensorOp_t::MAX ||
+                           op == ReduceTensorOp_t::AMAX;
+    const bool propagate_nan = nan_opt == ck::NanPropagation_t::PROPAGATE_NAN;
+
+    for(std::size_t o = 0; o < out.mData.size(); ++o)
+    {
+        const std::size_t in_offset = f_offset(invariant_dims, o);
+
+        double acc = op == ReduceTensorOp_t::MUL   ? 1
+                     : op == ReduceTensorOp_t::MIN ? std::numeric_limits<double>::max()
+                     : op == ReduceTensorOp_t::MAX ? std::numeric_limits<double>::lowest()
+                                                   : 0;
+        int64_t index = 0;
+
+        for(std::size_t r = 0; r < reduce_length; ++r)
+        {
+            double v = static_cast<double>(in.mData[in_offset + f_offset(to_reduce_dims, r)]);
+
+            if(op == ReduceTensorOp_t::NORM1 || op == ReduceTensorOp_t::AMAX)
+                v = std::abs(v);
+            else if(op == ReduceTensorOp_t::NORM2)
+                v = v * v;
+
+            if(indexable)
+            {
+                const bool replace = op == ReduceTensorOp_t::MIN ? acc > v : acc < v;
+
+                if((propagate_nan && std::isnan(v)) || replace)
+                {
+                    acc   = v;
+                    index = r;
+                }
+            }
+            else
+            {
+                acc = op == ReduceTensorOp_t::MUL ? acc * v : acc + v;
+            }
+        }
+
+        if(op == ReduceTensorOp_t::AVG)
+            acc /= reduce_length;
+        else if(op == ReduceTensorOp_t::NORM2)
+            acc = std::sqrt(acc);
+
+        out.mData[o]     = static_cast<TOut>(acc);
+        indices.mData[o] = static_cast<TIndex>(index);
+    }
+}
+
+template <typename TIndex>
+void run_reduce(const std::vector<std::size_t>& in_lengths,
+                const std::vector<int>& reduce_dims,
+                ck::ReduceTensorOp_t op,
+                ck::NanPropagation_t nan_opt,
+                bool do_verification,
+                int init_method,
+                bool do_log,
+                int nrepeat)
+{
+#if 1
+    using in_data_t  = float;
+    using acc_data_t = float;
+    using out_data_t = float;
+#elif 1
+    using in_data_t  = half_t;
+    using acc_data_t = float;
+    using out_data_t = half_t;
+#endif
+
+    std::vector<std::size_t> out_lengths;
+
+    for(std::size_t d = 0; d < in_lengths.size(); ++d)
+        if(std::count(reduce_dims.begin(), reduce_dims.end(), int(d)) == 0)
+            out_lengths.push_back(in_lengths[d]);
+
+    // all dimensions reduced
+    if(out_lengths.empty())
+        out_lengths.push_back(1);
+
+    Tensor<in_data_t> in(in_lengths);
+    Tensor<out_data_t> out_host(out_lengths);
+    Tensor<out_data_t> out_ref(out_lengths);
+    Tensor<TIndex> indices_host(out_lengths);
+    Tensor<TIndex> indices_ref(out_lengths);
+
+    ostream_HostTensorDescriptor(in.mDesc, std::cout << "in: ");
+    ostream_HostTensorDescriptor(out_host.mDesc, std::cout << "out: ");
+
+    std::size_t num_thread = get_host_num_threads();
+
+    switch(init_method)
+    {
+    case 0: break;
+    case 1: in.GenerateTensorValue(GeneratorTensor_1<in_data_t>{}, num_thread); break;
+    case 2: in.GenerateTensorValue(GeneratorTensor_2<in_data_t>{-5, 5}, num_thread); break;
+    default: in.GenerateTensorValue(GeneratorTensor_3<float>{-1.0, 1.0}, num_thread);
+    }
+
+    auto f_reduce = [&]() {
+        host_reduce<acc_data_t>(in, out_host, &indices_host, reduce_dims, op, nan_opt);
+    };
+
+    const float ave_time = launch_and_time_host_kernel(f_reduce, nrepeat);
+
+    const std::size_t num_bytes =
+        in.mData.size() * sizeof(in_data_t) + out_host.mData.size() * sizeof(out_data_t);
+
+    std::cout << "Average time : " << ave_time << " ms, " << num_bytes / 1.E6 / ave_time
+              << " GB/s" << std::endl;
+
+    if(do_verification)
+    {
+        host_direct_reduce(in, out_ref, indices_ref, reduce_dims, op, nan_opt);
+
+        check_error(out_ref, out_host);
+
+        if(op == ck::ReduceTensorOp_t::MIN || op == ck::ReduceTensorOp_t::MAX ||
+           op == ck::ReduceTensorOp_t::AMAX)
+        {
+            const std::size_t num_mismatch = std::inner_product(indices_ref.mData.begin(),
+                                                                indices_ref.mData.end(),
+                                                                indices_host.mData.begin(),
+                                                                std::size_t{0},
+                                                                std::plus<std::size_t>(),
+                                                                std::not_equal_to<TIndex>());
+
+            std::cout << "indices mismatch: " << num_mismatch << std::endl;
+        }
+
+        if(do_log)
+        {
+            LogRangeAsType<float>(std::cout << "out_ref : ", out_ref.mData, ",") << std::endl;
+            LogRangeAsType<float>(std::cout << "out_host: ", out_host.mData, ",") << std::endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace ck;
+
+    if(argc < 10)
+    {
+        printf("arg1 to 7: reduce_op (0: add, 1: mul, 2: min, 3: max, 4: amax, 5: avg, 6: norm1, "
+               "7: norm2), nan_propagation, indices_type (0: 32 bit, 1: 64 bit, 2: 16 bit, "
+               "3: 8 bit), do_verification, init_method, do_log, nrepeat\n");
+        printf("arg8: to-reduce dimensions, e.g. 0,2\n");
+        printf("rest: lengths of in\n");
+        exit(1);
+    }
+
+    const auto op              = static_cast<ReduceTensorOp_t>(std::stoi(argv[1]));
+    const auto nan_opt         = static_cast<NanPropagation_t>(std::stoi(argv[2]));
+    const auto indices_type    = static_cast<IndicesType_t>(std::stoi(argv[3]));
+    const bool do_verification = std::stoi(argv[4]);
+    const int init_method      = std::stoi(argv[5]);
+    const bool do_log          = std::stoi(argv[6]);
+    const int nrepeat          = std::stoi(argv[7]);
+
+    std::vector<int> reduce_dims;
+
+    for(const char* p = argv[8]; *p != '\0';)
+    {
+        char* end;
+
+        const long d = std::strtol(p, &end, 10);
+
+        if(end == p)
+            break;
+
+        reduce_dims.push_back(d);
+
+        p = *end == ',' ? end + 1 : end;
+    }
+
+    std::vector<std::size_t> in_lengths;
+
+    for(int i = 9; i < argc; ++i)
+        in_lengths.push_back(std::stoul(argv[i]));
+
+    switch(indices_type)
+    {
+    case IndicesType_t::INDICES_64BIT:
+        run_reduce<HostReduceIndicesType<IndicesType_t::INDICES_64BIT>::type>(
+            in_lengths, reduce_dims, op, nan_opt, do_verification, init_method, do_log, nrepeat);
+        break;
+    case IndicesType_t::INDICES_16BIT:
+        run_reduce<HostReduceIndicesType<IndicesType_t::INDICES_16BIT>::type>(
+            in_lengths, reduce_dims, op, nan_opt, do_verification, init_method, do_log, nrepeat);
+        break;
+    case IndicesType_t::INDICES_8BIT:
+        run_reduce<HostReduceIndicesType<IndicesType_t::INDICES_8BIT>::type>(
+            in_lengths, reduce_dims, op, nan_opt, do_verification, init_method, do_log, nrepeat);
+        break;
+    default:
+        run_reduce<HostReduceIndicesType<IndicesType_t::INDICES_32BIT>::type>(
+            in_lengths, reduce_dims, op, nan_opt, do_verification, init_method, do_log, nrepeat);
+    }
+}
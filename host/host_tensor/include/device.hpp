@@ -2,11 +2,14 @@
 #define DEVICE_HPP
 
 #include <memory>
+#include <string>
 #include <functional>
 #include <thread>
+#include <vector>
 #include <chrono>
 #include "hip/hip_runtime.h"
 #include "hip/hip_fp16.h"
+#include "timing_stats.hpp"
 
 struct DeviceMem
 {
@@ -15,12 +18,40 @@ struct DeviceMem
     void* GetDeviceBuffer();
     void ToDevice(const void* p);
     void FromDevice(void* p);
+    // copies the first num_bytes of the buffer only
+    void ToDevice(const void* p, std::size_t num_bytes);
+    void FromDevice(void* p, std::size_t num_bytes);
     ~DeviceMem();
 
     void* mpDeviceBuf;
     std::size_t mMemSize;
 };
 
+// Grow-only device buffers for profiling many problems in one process. Slot i keeps the largest
+// buffer requested from it so far, so a sweep only allocates when a problem needs more memory in
+// a slot than all problems before it. The buffer contents are undefined.
+struct DeviceMemPool
+{
+    static DeviceMemPool& GetInstance();
+
+    // buffer of at least num_bytes, valid until the slot is requested again with more bytes
+    DeviceMem& Get(std::size_t slot, std::size_t num_bytes);
+
+    // frees all buffers
+    void Release();
+
+    DeviceMemPool(const DeviceMemPool&) = delete;
+    DeviceMemPool& operator=(const DeviceMemPool&) = delete;
+
+    private:
+    DeviceMemPool() = default;
+
+    std::vector<std::unique_ptr<DeviceMem>> mBuffers;
+};
+
+// architecture and compute unit count of the current device, e.g. "gfx908:120"
+std::string get_device_name();
+
 struct KernelTimerImpl;
 
 struct KernelTimer
@@ -34,6 +65,22 @@ struct KernelTimer
     std::unique_ptr<KernelTimerImpl> impl;
 };
 
+struct KernelSampleTimerImpl;
+
+// Records events on the default stream without waiting for them, the time between two
+// consecutive events is one sample. Timing each of many back-to-back launches this way keeps the
+// host out of the measurement.
+struct KernelSampleTimer
+{
+    KernelSampleTimer();
+    ~KernelSampleTimer();
+    void Record();
+    // waits for the last event, returns the samples and starts over
+    std::vector<float> GetSamples();
+
+    std::unique_ptr<KernelSampleTimerImpl> impl;
+};
+
 using device_stream_t = hipStream_t;
 
 template <typename... Args, typename F>
@@ -44,11 +91,13 @@ void launch_kernel(F kernel, dim3 grid_dim, dim3 block_dim, std::size_t lds_byte
     hipLaunchKernelGGL(kernel, grid_dim, block_dim, lds_byte, stream_id, args...);
 }
 
+// times each launch separately, see TimingOptions for the number of runs and TimingStatsRecorder
+// for the per-run times; returns the mean time of the timed runs
 template <typename... Args, typename F>
 float launch_and_time_kernel(
     F kernel, int nrepeat, dim3 grid_dim, dim3 block_dim, std::size_t lds_byte, Args... args)
 {
-    KernelTimer timer;
+    KernelSampleTimer timer;
 
     printf("%s: grid_dim {%d, %d, %d}, block_dim {%d, %d, %d} \n",
            __func__,
@@ -59,26 +108,22 @@ float launch_and_time_kernel(
            block_dim.y,
            block_dim.z);
 
-    printf("Warm up\n");
-
     hipStream_t stream_id = nullptr;
 
-    // warm up
-    hipLaunchKernelGGL(kernel, grid_dim, block_dim, lds_byte, stream_id, args...);
-
-    printf("Start running %d times...\n", nrepeat);
-
-    timer.Start();
-
-    for(int i = 0; i < nrepeat; ++i)
-    {
-        hipLaunchKernelGGL(kernel, grid_dim, block_dim, lds_byte, stream_id, args...);
-    }
+    return time_runs(
+        [&] { hipLaunchKernelGGL(kernel, grid_dim, block_dim, lds_byte, stream_id, args...); },
+        [&](int num_run) {
+            timer.Record();
 
-    timer.End();
+            for(int i = 0; i < num_run; ++i)
+            {
+                hipLaunchKernelGGL(kernel, grid_dim, block_dim, lds_byte, stream_id, args...);
 
-    // std::this_thread::sleep_for (std::chrono::microseconds(10));
+                timer.Record();
+            }
 
-    return timer.GetElapsedTime() / nrepeat;
+            return timer.GetSamples();
+        },
+        nrepeat);
 }
 #endif
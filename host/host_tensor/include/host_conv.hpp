@@ -1,7 +1,78 @@
 #pragma once
 #include "host_tensor.hpp"
 #include "conv_common.hpp"
+#include "host_conv_fwd_im2col.hpp"
+#include "host_conv_fwd_nchwc.hpp"
 
+template <typename TIn,
+          typename TWei,
+          typename TOut,
+          typename ConvStrides,
+          typename ConvDilations,
+          typename InLeftPads,
+          typename InRightPads>
+void host_conv_fwd(const Tensor<TIn>& in,
+                   const Tensor<TWei>& wei,
+                   Tensor<TOut>& out,
+                   const ConvStrides& conv_strides,
+                   const ConvDilations& conv_dilations,
+                   const InLeftPads& in_left_pads,
+                   const InRightPads& in_right_pads,
+                   HostConvTensorLayout_t layout,
+                   HostGemmPrecision_t precision)
+{
+    constexpr auto I0 = ck::Number<0>{};
+    constexpr auto I1 = ck::Number<1>{};
+
+    auto f_pair = [](const auto& v) {
+        return std::array<std::size_t, 2>{static_cast<std::size_t>(v[I0]),
+                                          static_cast<std::size_t>(v[I1])};
+    };
+
+    const auto problem = make_HostConvProblem(in.mDesc,
+                                              wei.mDesc,
+                                              out.mDesc,
+                                              f_pair(conv_strides),
+                                              f_pair(conv_dilations),
+                                              f_pair(in_left_pads),
+                                              f_pair(in_right_pads),
+                                              layout);
+
+    auto pass_through = [](auto v) { return v; };
+
+    if constexpr(is_host_gemm_int8<TIn, TWei>)
+    {
+        host_conv_fwd_im2col<int32_t>(problem,
+                                      in.mData.data(),
+                                      wei.mData.data(),
+                                      out.mData.data(),
+                                      pass_through,
+                                      pass_through,
+                                      pass_through);
+    }
+    else if(precision == HostGemmPrecision_t::Strict)
+    {
+        host_conv_fwd_im2col<double>(problem,
+                                     in.mData.data(),
+                                     wei.mData.data(),
+                                     out.mData.data(),
+                                     pass_through,
+                                     pass_through,
+                                     pass_through);
+    }
+    else
+    {
+        host_conv_fwd_im2col<float>(problem,
+                                    in.mData.data(),
+                                    wei.mData.data(),
+                                    out.mData.data(),
+                                    pass_through,
+                                    pass_through,
+                                    pass_through);
+    }
+}
+
+// tensors indexed as in(n, c, hi, wi), wei(k, c, y, x), out(n, k, ho, wo), any memory layout
 template <typename TIn,
           typename TWei,
           typename TOut,
@@ -15,36 +86,226 @@ void host_conv_nchw_kcyx_nkhw(const Tensor<TIn>& in,
                               const ConvStrides& conv_strides,
                               const ConvDilations& conv_dilations,
                               const InLeftPads& in_left_pads,
-                              const InRightPads&)
+                              const InRightPads& in_right_pads,
+                              HostGemmPrecision_t precision = HostGemmPrecision_t::Strict)
+{
+    host_conv_fwd(in,
+                  wei,
+                  out,
+                  conv_strides,
+                  conv_dilations,
+                  in_left_pads,
+                  in_right_pads,
+                  HostConvTensorLayout_t::NCHW,
+                  precision);
+}
+
+// tensors indexed as in(n, hi, wi, c), wei(k, y, x, c), out(n, ho, wo, k), any memory layout
+template <typename TIn,
+          typename TWei,
+          typename TOut,
+          typename ConvStrides,
+          typename ConvDilations,
+          typename InLeftPads,
+          typename InRightPads>
+void host_conv_nhwc_kyxc_nhwk(const Tensor<TIn>& in,
+                              const Tensor<TWei>& wei,
+                              Tensor<TOut>& out,
+                              const ConvStrides& conv_strides,
+                              const ConvDilations& conv_dilations,
+                              const InLeftPads& in_left_pads,
+                              const InRightPads& in_right_pads,
+                              HostGemmPrecision_t precision = HostGemmPrecision_t::Strict)
+{
+    host_conv_fwd(in,
+                  wei,
+                  out,
+                  conv_strides,
+                  conv_dilations,
+                  in_left_pads,
+                  in_right_pads,
+                  HostConvTensorLayout_t::NHWC,
+                  precision);
+}
+
+// tensors indexed as in(n, c0, hi, wi, c1), wei(k, c0, y, x, c1), out(n, k0, ho, wo, k1) with
+// c = c0 * C1 + c1 and k = k0 * K1 + k1. out_element_op is applied to the accumulator, an
+// indexed one as out_op(v, n, k, ho, wo)
+template <typename TIn,
+          typename TWei,
+          typename TOut,
+          typename ConvStrides,
+          typename ConvDilations,
+          typename InLeftPads,
+          typename InRightPads,
+          typename OutElementwiseOperation>
+void host_conv_nc0hwc1_kc0yxc1_nk0hwk1(const Tensor<TIn>& in,
+                                       const Tensor<TWei>& wei,
+                                       Tensor<TOut>& out,
+                                       const ConvStrides& conv_strides,
+                                       const ConvDilations& conv_dilations,
+                                       const InLeftPads& in_left_pads,
+                                       const InRightPads& in_right_pads,
+                                       const OutElementwiseOperation& out_element_op,
+                                       HostGemmPrecision_t precision = HostGemmPrecision_t::Strict)
 {
     constexpr auto I0 = ck::Number<0>{};
     constexpr auto I1 = ck::Number<1>{};
 
-    auto f_nchw = [&](auto n, auto k, auto ho, auto wo) {
-        double v = 0;
-        for(int c = 0; c < wei.mDesc.GetLengths()[1]; ++c)
-        {
-            for(int y = 0; y < wei.mDesc.GetLengths()[2]; ++y)
-            {
-                int hi = ho * conv_strides[I0] + y * conv_dilations[I0] - in_left_pads[I0];
-                for(int x = 0; x < wei.mDesc.GetLengths()[3]; ++x)
-                {
-                    int wi = wo * conv_strides[I1] + x * conv_dilations[I1] - in_left_pads[I1];
-                    if(hi >= 0 && hi < in.mDesc.GetLengths()[2] && wi >= 0 &&
-                       wi < in.mDesc.GetLengths()[3])
-                    {
-                        v += static_cast<const double>(in(n, c, hi, wi)) *
-                             static_cast<const double>(wei(k, c, y, x));
-                    }
-                }
-            }
-        }
-        out(n, k, ho, wo) = v;
+    auto f_pair = [](const auto& v) {
+        return std::array<std::size_t, 2>{static_cast<std::size_t>(v[I0]),
+                                          static_cast<std::size_t>(v[I1])};
     };
 
-    make_ParallelTensorFunctor(f_nchw,
-                               out.mDesc.GetLengths()[0],
-                               out.mDesc.GetLengths()[1],
-                               out.mDesc.GetLengths()[2],
-                               out.mDesc.GetLengths()[3])(std::thread::hardware_concurrency());
+    const auto problem = make_HostConvNchwcProblem(in.mDesc,
+                                                   wei.mDesc,
+                                                   out.mDesc,
+                                                   f_pair(conv_strides),
+                                                   f_pair(conv_dilations),
+                                                   f_pair(in_left_pads),
+                                                   f_pair(in_right_pads));
+
+    auto pass_through = [](auto v) { return v; };
+
+    if(precision == HostGemmPrecision_t::Strict)
+    {
+        host_conv_fwd_nchwc<double>(problem,
+                                    in.mData.data(),
+                                    wei.mData.data(),
+                                    out.mData.data(),
+                                    pass_through,
+                                    pass_through,
+                                    out_element_op);
+    }
+    else
+    {
+        host_conv_fwd_nchwc<float>(problem,
+                                   in.mData.data(),
+                                   wei.mData.data(),
+                                   out.mData.data(),
+                                   pass_through,
+                                   pass_through,
+                                   out_element_op);
+    }
 }
+
+// host_conv_nc0hwc1_kc0yxc1_nk0hwk1 followed by a max pooling of out with non-overlapping
+// pool_windows (h, w) into max(n, k0, hp, wp, k1), in one pass over the output. p_out may be
+// null, the conv output is then only kept in cache for the pooling.
+template <typename TIn,
+          typename TWei,
+          typename TOut,
+          typename TPool,
+          typename ConvStrides,
+          typename ConvDilations,
+          typename InLeftPads,
+          typename InRightPads,
+          typename OutElementwiseOperation>
+void host_conv_maxpool_nc0hwc1_kc0yxc1_nk0hwk1(
+    const Tensor<TIn>& in,
+    const Tensor<TWei>& wei,
+    Tensor<TOut>* p_out,
+    Tensor<TPool>& max,
+    const ConvStrides& conv_strides,
+    const ConvDilations& conv_dilations,
+    const InLeftPads& in_left_pads,
+    const InRightPads& in_right_pads,
+    const std::array<std::size_t, 2>& pool_windows,
+    const OutElementwiseOperation& out_element_op,
+    HostGemmPrecision_t precision = HostGemmPrecision_t::Strict)
+{
+    constexpr auto I0 = ck::Number<0>{};
+    constexpr auto I1 = ck::Number<1>{};
+
+    auto f_pair = [](const auto& v) {
+        return std::array<std::size_t, 2>{static_cast<std::size_t>(v[I0]),
+                                          static_cast<std::size_t>(v[I1])};
+    };
+
+    const auto strides    = f_pair(conv_strides);
+    const auto dilations  = f_pair(conv_dilations);
+    const auto left_pads  = f_pair(in_left_pads);
+    const auto right_pads = f_pair(in_right_pads);
+
+    const auto& in_lengths  = in.mDesc.GetLengths();
+    const auto& wei_lengths = wei.mDesc.GetLengths();
+    const auto& max_lengths = max.mDesc.GetLengths();
+
+    // without out, its lengths follow from the conv
+    auto f_out_length = [&](std::size_t i) {
+        const std::size_t eff = (wei_lengths[2 + i] - 1) * dilations[i] + 1;
+
+        return (in_lengths[2 + i] + left_pads[i] + right_pads[i] - eff) / strides[i] + 1;
+    };
+
+    const HostTensorDescriptor out_desc =
+        p_out != nullptr ? p_out->mDesc
+                         : HostTensorDescriptor(std::vector<std::size_t>{in_lengths[0],
+                                                                         max_lengths[1],
+                                                                         f_out_length(0),
+                                                                         f_out_length(1),
+                                                                         max_lengths[4]});
+
+    const auto problem = make_HostConvNchwcProblem(
+        in.mDesc, wei.mDesc, out_desc, strides, dilations, left_pads, right_pads);
+
+    if(max_lengths[0] != problem.N || max_lengths[1] != problem.K0 ||
+       max_lengths[4] != problem.K1)
+    {
+        throw std::runtime_error("wrong! inconsistent host NCHWc maxpool tensor lengths");
+    }
+
+    HostConvNchwcMaxPool<TPool> pool;
+
+    pool.p_pool  = max.mData.data();
+    pool.WindowH = pool_windows[0];
+    pool.WindowW = pool_windows[1];
+    pool.Hp      = max_lengths[2];
+    pool.Wp      = max_lengths[3];
+
+    std::copy_n(max.mDesc.GetStrides().begin(), 5, pool.Strides.begin());
+
+    TOut* p_out_data = p_out != nullptr ? p_out->mData.data() : nullptr;
+
+    auto pass_through = [](auto v) { return v; };
+
+    if(precision == HostGemmPrecision_t::Strict)
+    {
+        host_conv_fwd_maxpool_nchwc<double>(problem,
+                                            in.mData.data(),
+                                            wei.mData.data(),
+                                            p_out_data,
+                                            pool,
+                                            pass_through,
+                                            pass_through,
+                                            out_element_op);
+    }
+    else
+    {
+        host_conv_fwd_maxpool_nchwc<float>(problem,
+                                           in.mData.data(),
+                                           wei.mData.data(),
+                                           p_out_data,
+                                           pool,
+                                           pass_through,
+                                           pass_through,
+                                           out_element_op);
+    }
+}
+
+// out = activ(acc + bias[k]), the epilogue of the v5r1 NCHWc drivers for
+// host_conv_nc0hwc1_kc0yxc1_nk0hwk1. activ is evaluated in double, whatever the accumulator
+template <typename TBias>
+struct HostConvBiasActivNchwc : public HostIndexedElementwiseOperation
+{
+    const TBias* p_bias;
+    ck::ActivTypeEnum_t activ_type;
+
+    template <typename T>
+    T operator()(T v, std::size_t, std::size_t k, std::size_t, std::size_t) const
+    {
+        const double b = host_type_convert<double>(p_bias[k]);
+
+        return static_cast<T>(activ(static_cast<double>(v) + b, activ_type));
+    }
+};
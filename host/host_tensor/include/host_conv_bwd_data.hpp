@@ -0,0 +1,253 @@
+#ifndef HOST_CONV_BWD_DATA_HPP
+#define HOST_CONV_BWD_DATA_HPP
+
+#include <vector>
+#include <algorithm>
+#include "host_conv_problem.hpp"
+#include "host_gemm_blocked.hpp"
+
+// Host backward-data convolution lowered to the blocked host GEMM.
+//   in[n, c, hi, wi] = in_op(sum_{k, y, x} out_op(out[n, k, ho, wo]) * wei_op(wei[k, c, y, x]))
+//   over all (y, x) with hi = ho * ConvStrideH + y * ConvDilationH - InLeftPadH (same for w)
+//
+// Input pixels are split into ConvStrideH * ConvStrideW phases (hi + InLeftPadH) % ConvStrideH,
+// (wi + InLeftPadW) % ConvStrideW. All pixels of a phase see the same filter taps, and for a tap
+// the output pixel is the pixel's phase index minus a per-tap offset, so each phase is a dense
+// GEMM with M = phase pixels, N = C and K = K * taps. This is the decomposition used by
+// transform_backward_data_convolution_into_gemm_v4r1r2 on the device. Tap lists are computed once
+// per phase, no per-element divisibility tests are left in the inner loops.
+
+struct HostConvBwdDataTap
+{
+    std::size_t mFilter; // y or x
+    std::size_t mOffset; // phase index minus output index
+};
+
+// taps of one spatial dimension contributing to input phase `phase`
+inline std::vector<HostConvBwdDataTap> get_host_conv_bwd_data_taps(std::size_t filter_length,
+                                                                   std::size_t conv_stride,
+                                                                   std::size_t conv_dilation,
+                                                                   std::size_t phase)
+{
+    std::vector<HostConvBwdDataTap> taps;
+
+    for(std::size_t y = 0; y < filter_length; ++y)
+    {
+        const std::size_t d = y * conv_dilation;
+
+        if(d % conv_stride == phase)
+        {
+            taps.push_back({y, (d - phase) / conv_stride});
+        }
+    }
+
+    return taps;
+}
+
+template <typename AccDataType,
+          typename TIn,
+          typename TWei,
+          typename TOut,
+          typename InElementwiseOperation,
+          typename WeiElementwiseOperation,
+          typename OutElementwiseOperation>
+void host_conv_bwd_data_gemm(const HostConvProblem& problem,
+                             TIn* p_in,
+                             const TWei* p_wei,
+                             const TOut* p_out,
+                             const InElementwiseOperation& in_element_op,
+                             const WeiElementwiseOperation& wei_element_op,
+                             const OutElementwiseOperation& out_element_op,
+                             std::size_t num_thread = get_host_num_threads())
+{
+    const std::size_t N  = problem.N;
+    const std::size_t K  = problem.K;
+    const std::size_t C  = problem.C;
+    const std::size_t Hi = problem.Hi;
+    const std::size_t Wi = problem.Wi;
+    const std::size_t Ho = problem.Ho;
+    const std::size_t Wo = problem.Wo;
+
+    const std::size_t SH = std::max<std::size_t>(problem.ConvStrideH, 1);
+    const std::size_t SW = std::max<std::size_t>(problem.ConvStrideW, 1);
+
+    if(N * C * Hi * Wi == 0)
+        return;
+
+    const auto& in_strides  = problem.InStrides;
+    const auto& wei_strides = problem.WeiStrides;
+    const auto& out_strides = problem.OutStrides;
+
+    // K innermost: reduction ordered (y, x, k), otherwise (k, y, x)
+    const bool tap_yxk = out_strides[1] < out_strides[3];
+
+    auto pass_through = [](AccDataType v) { return v; };
+
+    num_thread = std::max<std::size_t>(num_thread, 1);
+
+    std::vector<AccDataType> wei_pack;
+
+    for(std::size_t rh = 0; rh < SH; ++rh)
+    {
+        // first input row of the phase
+        const std::size_t hi0 = (rh + SH - problem.InLeftPadH % SH) % SH;
+
+        const std::size_t Hp = hi0 < Hi ? (Hi - hi0 + SH - 1) / SH : 0;
+
+        for(std::size_t rw = 0; rw < SW; ++rw)
+        {
+            const std::size_t wi0 = (rw + SW - problem.InLeftPadW % SW) % SW;
+
+            const std::size_t Wp = wi0 < Wi ? (Wi - wi0 + SW - 1) / SW : 0;
+
+            if(Hp * Wp == 0)
+                continue;
+
+            const auto taps_y =
+                get_host_conv_bwd_data_taps(problem.Y, SH, problem.ConvDilationH, rh);
+            const auto taps_x =
+                get_host_conv_bwd_data_taps(problem.X, SW, problem.ConvDilationW, rw);
+
+            const std::size_t TY  = taps_y.size();
+            const std::size_t TX  = taps_x.size();
+            const std::size_t KTT = K * TY * TX;
+
+            // phase index of the first pixel
+            const std::size_t qh0 = (hi0 + problem.InLeftPadH) / SH;
+            const std::size_t qw0 = (wi0 + problem.InLeftPadW) / SW;
+
+            auto f_tap = [&](std::size_t k, std::size_t ty, std::size_t tx) {
+                return tap_yxk ? (ty * TX + tx) * K + k : (k * TY + ty) * TX + tx;
+            };
+
+            // weights of the phase as a [C, K * TY * TX] matrix in reduction order
+            wei_pack.resize(C * KTT);
+
+            auto f_pack_wei = [&](std::size_t c) {
+                for(std::size_t k = 0; k < K; ++k)
+                    for(std::size_t ty = 0; ty < TY; ++ty)
+                        for(std::size_t tx = 0; tx < TX; ++tx)
+                        {
+                            wei_pack[c * KTT + f_tap(k, ty, tx)] =
+                                static_cast<AccDataType>(wei_element_op(
+                                    p_wei[k * wei_strides[0] + c * wei_strides[1] +
+                                          taps_y[ty].mFilter * wei_strides[2] +
+                                          taps_x[tx].mFilter * wei_strides[3]]));
+                        }
+            };
+
+            make_ParallelTensorFunctor(f_pack_wei, C)(num_thread);
+
+            const std::size_t P = Hp * Wp;
+
+            std::size_t slab = std::max<std::size_t>(
+                host_conv_im2col_panel_bytes / std::max<std::size_t>(KTT * sizeof(AccDataType), 1),
+                64);
+
+            slab = std::min(
+                slab, std::max<std::size_t>((N * P + 4 * num_thread - 1) / (4 * num_thread), 16));
+            slab = std::min(slab, P);
+
+            const std::size_t num_slab = (P + slab - 1) / slab;
+
+            auto f_unit = [&](std::size_t n, std::size_t is) {
+                thread_local std::vector<AccDataType> col;
+                thread_local std::vector<TIn> in_tile;
+
+                const std::size_t p0 = is * slab;
+                const std::size_t np = std::min(slab, P - p0);
+
+                const TOut* p_out_n = p_out + n * out_strides[0];
+                TIn* p_in_n         = p_in + n * in_strides[0];
+
+                in_tile.resize(np * C);
+
+                if(KTT == 0)
+                {
+                    // no tap reaches this phase
+                    std::fill(in_tile.begin(),
+                              in_tile.end(),
+                              static_cast<TIn>(in_element_op(AccDataType{0})));
+                }
+                else
+                {
+                    // panel is [np, KTT] for (y, x, k) order and [KTT, np] for (k, y, x) order
+                    col.resize(np * KTT);
+
+                    const std::size_t col_stride_m = tap_yxk ? KTT : 1;
+                    const std::size_t col_stride_k = tap_yxk ? 1 : np;
+                    const std::size_t tap_stride_k = (tap_yxk ? 1 : TY * TX) * col_stride_k;
+
+                    for(std::size_t ip = 0; ip < np; ++ip)
+                    {
+                        const std::size_t qh = qh0 + (p0 + ip) / Wp;
+                        const std::size_t qw = qw0 + (p0 + ip) % Wp;
+
+                        AccDataType* p_col = col.data() + ip * col_stride_m;
+
+                        for(std::size_t ty = 0; ty < TY; ++ty)
+                        {
+                            // unsigned wrap-around turns negative indices into out-of-range ones
+                            const std::size_t ho = qh - taps_y[ty].mOffset;
+
+                            for(std::size_t tx = 0; tx < TX; ++tx)
+                            {
+                                const std::size_t wo = qw - taps_x[tx].mOffset;
+
+                                AccDataType* p_col_tap = p_col + f_tap(0, ty, tx) * col_stride_k;
+
+                                if(ho < Ho && wo < Wo)
+                                {
+                                    const TOut* p_out_pixel =
+                                        p_out_n + ho * out_strides[2] + wo * out_strides[3];
+
+                                    for(std::size_t k = 0; k < K; ++k)
+                                        p_col_tap[k * tap_stride_k] = static_cast<AccDataType>(
+                                            out_element_op(p_out_pixel[k * out_strides[1]]));
+                                }
+                                else
+                                {
+                                    for(std::size_t k = 0; k < K; ++k)
+                                        p_col_tap[k * tap_stride_k] = AccDataType{0};
+                                }
+                            }
+                        }
+                    }
+
+                    host_gemm_blocked<AccDataType>(np,
+                                                   C,
+                                                   KTT,
+                                                   col.data(),
+                                                   col_stride_m,
+                                                   col_stride_k,
+                                                   wei_pack.data(),
+                                                   1,
+                                                   KTT,
+                                                   in_tile.data(),
+                                                   C,
+                                                   1,
+                                                   pass_through,
+                                                   pass_through,
+                                                   in_element_op,
+                                                   HostGemmBlocking{},
+                                                   1);
+                }
+
+                for(std::size_t ip = 0; ip < np; ++ip)
+                {
+                    const std::size_t hi = hi0 + SH * ((p0 + ip) / Wp);
+                    const std::size_t wi = wi0 + SW * ((p0 + ip) % Wp);
+
+                    TIn* p_in_pixel = p_in_n + hi * in_strides[2] + wi * in_strides[3];
+
+                    for(std::size_t c = 0; c < C; ++c)
+                        p_in_pixel[c * in_strides[1]] = in_tile[ip * C + c];
+                }
+            };
+
+            make_ParallelTensorFunctor(f_unit, N, num_slab)(num_thread, 1);
+        }
+    }
+}
+
+#endif
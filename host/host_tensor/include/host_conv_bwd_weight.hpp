@@ -0,0 +1,210 @@
+#ifndef HOST_CONV_BWD_WEIGHT_HPP
+#define HOST_CONV_BWD_WEIGHT_HPP
+
+#include <vector>
+#include <algorithm>
+#include "host_conv_problem.hpp"
+#include "host_conv_fwd_im2col.hpp"
+
+// Host backward-weight convolution lowered to the blocked host GEMM.
+//   wei[k, c, y, x] = wei_op(sum_{n, ho, wo} out_op(out[n, k, ho, wo]) * in_op(in[n, c, hi, wi]))
+//
+// Work items are (KBatch, K block) pairs. The N * Ho * Wo reduction is split into KBatch
+// contiguous ranges of (image, pixel slab) units, the host counterpart of the GemmKBatch split of
+// the atomic device kernels, and the K rows of the weights into blocks of at least
+// host_conv_bwd_weight_min_k_rows. Each item adds the GEMMs of its units straight into the rows
+// of its batch's [K, C * Y * X] partial sums (beta = 1). K blocks come first, so there are only
+// as many partials as it takes to give every thread an item, at most
+// host_conv_bwd_weight_partial_bytes; they are merged with a pairwise tree reduction.
+
+constexpr std::size_t host_conv_bwd_weight_partial_bytes = std::size_t{256} << 20;
+
+// fewer rows would gather the same input panel too often
+constexpr std::size_t host_conv_bwd_weight_min_k_rows = 16;
+
+// GEMM epilogue c = partial[m, n] + v, the GEMM then adds its product to the partial sums
+template <typename AccDataType>
+struct HostConvBwdWeightAccumulate : public HostIndexedElementwiseOperation
+{
+    const AccDataType* mPartial;
+    std::size_t mStride;
+
+    AccDataType operator()(AccDataType v, std::size_t m, std::size_t n) const
+    {
+        return mPartial[m * mStride + n] + v;
+    }
+};
+
+template <typename AccDataType,
+          typename TIn,
+          typename TWei,
+          typename TOut,
+          typename InElementwiseOperation,
+          typename WeiElementwiseOperation,
+          typename OutElementwiseOperation>
+void host_conv_bwd_weight_gemm(const HostConvProblem& problem,
+                               const TIn* p_in,
+                               TWei* p_wei,
+                               const TOut* p_out,
+                               const InElementwiseOperation& in_element_op,
+                               const WeiElementwiseOperation& wei_element_op,
+                               const OutElementwiseOperation& out_element_op,
+                               std::size_t num_thread = get_host_num_threads())
+{
+    const std::size_t N   = problem.N;
+    const std::size_t K   = problem.K;
+    const std::size_t C   = problem.C;
+    const std::size_t Y   = problem.Y;
+    const std::size_t X   = problem.X;
+    const std::size_t P   = problem.Ho * problem.Wo;
+    const std::size_t CYX = C * Y * X;
+
+    if(K * CYX == 0)
+        return;
+
+    const auto& in_strides  = problem.InStrides;
+    const auto& wei_strides = problem.WeiStrides;
+    const auto& out_strides = problem.OutStrides;
+
+    // C innermost: taps ordered (y, x, c), otherwise (c, y, x)
+    const bool tap_yxc = in_strides[1] < in_strides[3];
+
+    // K innermost: output panel is [np, K], otherwise [K, np]
+    const bool out_pk = out_strides[1] < out_strides[3];
+
+    auto pass_through = [](AccDataType v) { return v; };
+
+    num_thread = std::max<std::size_t>(num_thread, 1);
+
+    std::size_t slab = std::max<std::size_t>(
+        host_conv_im2col_panel_bytes / std::max<std::size_t>(CYX * sizeof(AccDataType), 1), 64);
+
+    slab = std::min(slab, std::max<std::size_t>(P, 1));
+
+    const std::size_t num_slab = (P + slab - 1) / slab;
+    const std::size_t num_unit = N * num_slab;
+
+    const std::size_t partial_size = K * CYX;
+
+    const std::size_t num_k_block =
+        std::min(num_thread,
+                 std::max<std::size_t>(K / host_conv_bwd_weight_min_k_rows, std::size_t{1}));
+
+    std::size_t k_batch = std::min((num_thread + num_k_block - 1) / num_k_block, num_unit);
+
+    k_batch = std::min(k_batch,
+                       host_conv_bwd_weight_partial_bytes /
+                           std::max<std::size_t>(partial_size * sizeof(AccDataType), 1));
+
+    k_batch = std::max<std::size_t>(k_batch, 1);
+
+    std::vector<AccDataType> partials(k_batch * partial_size, AccDataType{0});
+
+    // a single item threads its GEMMs instead
+    const std::size_t gemm_num_thread = k_batch * num_k_block == 1 ? num_thread : 1;
+
+    auto f_item = [&](std::size_t ib, std::size_t ikb) {
+        thread_local std::vector<AccDataType> col, out_panel;
+
+        const std::size_t k0 = K * ikb / num_k_block;
+        const std::size_t kk = K * (ikb + 1) / num_k_block - k0;
+
+        AccDataType* p_partial = partials.data() + ib * partial_size + k0 * CYX;
+
+        const HostConvBwdWeightAccumulate<AccDataType> accumulate{{}, p_partial, CYX};
+
+        const std::size_t unit_begin = num_unit * ib / k_batch;
+        const std::size_t unit_end   = num_unit * (ib + 1) / k_batch;
+
+        for(std::size_t iu = unit_begin; iu < unit_end; ++iu)
+        {
+            const std::size_t n  = iu / num_slab;
+            const std::size_t p0 = (iu % num_slab) * slab;
+            const std::size_t np = std::min(slab, P - p0);
+
+            col.resize(np * CYX);
+            out_panel.resize(np * kk);
+
+            host_conv_im2col_gather(
+                problem, p_in + n * in_strides[0], p0, np, tap_yxc, col.data(), in_element_op);
+
+            const TOut* p_out_n = p_out + n * out_strides[0] + k0 * out_strides[1];
+
+            for(std::size_t ip = 0; ip < np; ++ip)
+            {
+                const std::size_t ho = (p0 + ip) / problem.Wo;
+                const std::size_t wo = (p0 + ip) % problem.Wo;
+
+                const TOut* p_out_pixel = p_out_n + ho * out_strides[2] + wo * out_strides[3];
+
+                for(std::size_t k = 0; k < kk; ++k)
+                {
+                    out_panel[out_pk ? ip * kk + k : k * np + ip] =
+                        static_cast<AccDataType>(out_element_op(p_out_pixel[k * out_strides[1]]));
+                }
+            }
+
+            // [kk, np] x [np, CYX], reduction over the pixels of the unit
+            host_gemm_blocked<AccDataType>(kk,
+                                           CYX,
+                                           np,
+                                           out_panel.data(),
+                                           out_pk ? 1 : np,
+                                           out_pk ? kk : 1,
+                                           col.data(),
+                                           tap_yxc ? CYX : 1,
+                                           tap_yxc ? 1 : np,
+                                           p_partial,
+                                           CYX,
+                                           1,
+                                           pass_through,
+                                           pass_through,
+                                           accumulate,
+                                           HostGemmBlocking{},
+                                           gemm_num_thread);
+        }
+    };
+
+    make_ParallelTensorFunctor(f_item, k_batch, num_k_block)(num_thread, 1);
+
+    // tree reduction of the partials into partials[0], each level split into chunks
+    const std::size_t chunk     = 4096;
+    const std::size_t num_chunk = (partial_size + chunk - 1) / chunk;
+
+    for(std::size_t step = 1; step < k_batch; step *= 2)
+    {
+        const std::size_t num_pair = (k_batch - step + 2 * step - 1) / (2 * step);
+
+        auto f_merge = [&](std::size_t ipair, std::size_t ichunk) {
+            AccDataType* p_dst       = partials.data() + 2 * step * ipair * partial_size;
+            const AccDataType* p_src = p_dst + step * partial_size;
+
+            const std::size_t begin = ichunk * chunk;
+            const std::size_t end   = std::min(begin + chunk, partial_size);
+
+            for(std::size_t i = begin; i < end; ++i)
+                p_dst[i] += p_src[i];
+        };
+
+        make_ParallelTensorFunctor(f_merge, num_pair, num_chunk)(num_thread);
+    }
+
+    auto f_tap = [&](std::size_t c, std::size_t y, std::size_t x) {
+        return tap_yxc ? (y * X + x) * C + c : (c * Y + y) * X + x;
+    };
+
+    auto f_store = [&](std::size_t k) {
+        for(std::size_t c = 0; c < C; ++c)
+            for(std::size_t y = 0; y < Y; ++y)
+                for(std::size_t x = 0; x < X; ++x)
+                {
+                    p_wei[k * wei_strides[0] + c * wei_strides[1] + y * wei_strides[2] +
+                          x * wei_strides[3]] =
+                        static_cast<TWei>(wei_element_op(partials[k * CYX + f_tap(c, y, x)]));
+                }
+    };
+
+    make_ParallelTensorFunctor(f_store, K)(num_thread);
+}
+
+#endif
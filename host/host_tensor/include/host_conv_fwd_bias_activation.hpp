@@ -0,0 +1,115 @@
+#ifndef HOST_CONV_FWD_BIAS_ACTIVATION_HPP
+#define HOST_CONV_FWD_BIAS_ACTIVATION_HPP
+
+#include <array>
+#include "host_conv_problem.hpp"
+#include "host_conv_fwd_im2col.hpp"
+
+// Output epilogues of the host conv engines that fuse bias, activation and residual add into the
+// store of the accumulator tile, so out is written once and never read back:
+//   out[n, k, ho, wo] = out_op(acc, bias[k])                      (AddRelu, ...)
+//   out[n, k, ho, wo] = out_op(acc, bias[k], resi[n, k, ho, wo])  (AddReluAdd, ...)
+// bias is a contiguous vector of K elements, resi is addressed with (n, k, ho, wo) strides.
+
+template <typename TBias, typename OutElementwiseOperation>
+struct HostConvBiasActivationEpilogue : public HostIndexedElementwiseOperation
+{
+    const TBias* p_bias;
+    OutElementwiseOperation out_element_op;
+
+    template <typename T>
+    auto operator()(T v, std::size_t, std::size_t k, std::size_t, std::size_t) const
+    {
+        return out_element_op(v, static_cast<T>(p_bias[k]));
+    }
+};
+
+template <typename TBias, typename TResi, typename OutElementwiseOperation>
+struct HostConvBiasActivationAddEpilogue : public HostIndexedElementwiseOperation
+{
+    const TBias* p_bias;
+    const TResi* p_resi;
+    std::array<std::size_t, 4> resi_strides;
+    OutElementwiseOperation out_element_op;
+
+    template <typename T>
+    auto operator()(T v, std::size_t n, std::size_t k, std::size_t ho, std::size_t wo) const
+    {
+        const TResi resi = p_resi[n * resi_strides[0] + k * resi_strides[1] +
+                                  ho * resi_strides[2] + wo * resi_strides[3]];
+
+        return out_element_op(v, static_cast<T>(p_bias[k]), static_cast<T>(resi));
+    }
+};
+
+// Unfused counterpart of the epilogues, the baseline they are measured against: the conv stores
+// its result, then an element-wise pass reads it back and applies the epilogue in place.
+template <typename AccDataType, typename TIn, typename TWei, typename TOut, typename Epilogue>
+void host_conv_fwd_bias_activation_unfused(const HostConvProblem& problem,
+                                           const TIn* p_in,
+                                           const TWei* p_wei,
+                                           TOut* p_out,
+                                           const Epilogue& epilogue,
+                                           std::size_t num_thread = get_host_num_threads())
+{
+    auto pass_through = [](auto v) { return v; };
+
+    host_conv_fwd_im2col<AccDataType>(
+        problem, p_in, p_wei, p_out, pass_through, pass_through, pass_through, num_thread);
+
+    const auto& out_strides = problem.OutStrides;
+
+    auto f_row = [&](std::size_t n, std::size_t ho) {
+        for(std::size_t wo = 0; wo < problem.Wo; ++wo)
+        {
+            TOut* p_out_pixel =
+                p_out + n * out_strides[0] + ho * out_strides[2] + wo * out_strides[3];
+
+            for(std::size_t k = 0; k < problem.K; ++k)
+            {
+                TOut& out = p_out_pixel[k * out_strides[1]];
+
+                out = host_type_convert<TOut>(
+                    epilogue(host_type_convert<AccDataType>(out), n, k, ho, wo));
+            }
+        }
+    };
+
+    make_ParallelTensorFunctor(f_row, problem.N, problem.Ho)(std::max<std::size_t>(num_thread, 1));
+}
+
+// Bytes moved by conv + bias + activation (+ residual add), fused into the conv epilogue and as
+// an unfused pipeline, where the conv stores out and an element-wise pass reads it back together
+// with bias (and resi) and stores it again.
+struct HostConvBiasActivationTraffic
+{
+    std::size_t fused_bytes   = 0;
+    std::size_t unfused_bytes = 0;
+};
+
+inline HostConvBiasActivationTraffic
+get_host_conv_bias_activation_traffic(const HostConvProblem& problem,
+                                      std::size_t in_bytes,
+                                      std::size_t wei_bytes,
+                                      std::size_t out_bytes,
+                                      bool has_resi)
+{
+    const std::size_t in_size  = problem.N * problem.C * problem.Hi * problem.Wi;
+    const std::size_t wei_size = problem.K * problem.C * problem.Y * problem.X;
+    const std::size_t out_size = problem.N * problem.K * problem.Ho * problem.Wo;
+
+    // in, wei, bias and resi are read once, out is written once
+    const std::size_t fused = in_size * in_bytes + wei_size * wei_bytes + problem.K * out_bytes +
+                              (has_resi ? out_size * out_bytes : 0) + out_size * out_bytes;
+
+    HostConvBiasActivationTraffic traffic;
+
+    traffic.fused_bytes = fused;
+
+    // plus the round trip of the conv result through memory
+    traffic.unfused_bytes = fused + 2 * out_size * out_bytes;
+
+    return traffic;
+}
+
+#endif
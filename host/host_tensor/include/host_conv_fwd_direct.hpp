@@ -0,0 +1,359 @@
+#ifndef HOST_CONV_FWD_DIRECT_HPP
+#define HOST_CONV_FWD_DIRECT_HPP
+
+#include <vector>
+#include <algorithm>
+#include "host_conv_problem.hpp"
+#include "host_gemm_blocked.hpp"
+
+// Host direct forward convolution, for problems with few input channels, where the im2col panel
+// of host_conv_fwd_im2col is too narrow to pay for its gather.
+//   out[n, k, ho, wo] = out_op(sum_{c, y, x} in_op(in[n, c, hi, wi]) * wei_op(wei[k, c, y, x]))
+// Work is split into (image, output row) units. A unit converts the Y input rows it reads into
+// zero-padded, C-innermost rows of AccDataType, so every tap of an output pixel sits at a fixed
+// offset and needs no bounds check. The WR x KR micro-kernel then accumulates WR output pixels
+// by KR output channels against weights packed as [K / KR, Y, X, C, KR]. With unit dilation
+// along W, the X * C taps of one filter row are contiguous in both the padded row and the packed
+// weights, and are reduced in a single pass. out_op is applied to the WR x KR accumulator tile
+// as it is stored, an indexed out_op (HostIndexedElementwiseOperation) as out_op(v, n, k, ho, wo).
+
+// acc[i, j] += sum_t in[i * in_stride + t] * wei[t, j] for WR pixels i and KR channels j
+template <typename AccDataType, int WR, int KR, int VL>
+CK_HOST_ALWAYS_INLINE void host_conv_direct_micro_kernel(std::size_t len,
+                                                         const AccDataType* __restrict__ p_in,
+                                                         std::size_t in_stride,
+                                                         const AccDataType* __restrict__ p_wei,
+                                                         AccDataType* __restrict__ p_acc)
+{
+    static_assert(KR % VL == 0, "wrong! KR should be multiple of VL");
+
+    using vec_t = host_vector_t<AccDataType, VL>;
+
+    constexpr int NV = KR / VL;
+
+    vec_t acc[WR][NV];
+
+    for(int i = 0; i < WR; ++i)
+        for(int j = 0; j < NV; ++j)
+            acc[i][j] = host_vector_load<AccDataType, VL>(p_acc + i * KR + j * VL);
+
+    for(std::size_t t = 0; t < len; ++t)
+    {
+        vec_t w[NV];
+
+        for(int j = 0; j < NV; ++j)
+            w[j] = host_vector_load<AccDataType, VL>(p_wei + t * KR + j * VL);
+
+        for(int i = 0; i < WR; ++i)
+        {
+            const vec_t a = host_vector_broadcast<AccDataType, VL>(p_in[i * in_stride + t]);
+
+            for(int j = 0; j < NV; ++j)
+                acc[i][j] += a * w[j];
+        }
+    }
+
+    for(int i = 0; i < WR; ++i)
+        for(int j = 0; j < NV; ++j)
+            host_vector_store<AccDataType, VL>(p_acc + i * KR + j * VL, acc[i][j]);
+}
+
+// register tiles are those of the GEMM micro-kernel for the same ISA
+template <typename AccDataType, HostSimdIsa_t Isa>
+struct HostConvDirectMicroKernel;
+
+template <typename AccDataType>
+struct HostConvDirectMicroKernel<AccDataType, HostSimdIsa_t::Scalar>
+{
+    static constexpr int VL = HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Scalar>::VL;
+    static constexpr int WR = HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Scalar>::MR;
+    static constexpr int KR = HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Scalar>::NR;
+
+    static void Run(std::size_t len,
+                    const AccDataType* p_in,
+                    std::size_t in_stride,
+                    const AccDataType* p_wei,
+                    AccDataType* p_acc)
+    {
+        host_conv_direct_micro_kernel<AccDataType, WR, KR, VL>(len, p_in, in_stride, p_wei, p_acc);
+    }
+};
+
+template <typename AccDataType>
+struct HostConvDirectMicroKernel<AccDataType, HostSimdIsa_t::Avx2>
+{
+    static constexpr int VL = HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Avx2>::VL;
+    static constexpr int WR = HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Avx2>::MR;
+    static constexpr int KR = HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Avx2>::NR;
+
+    CK_HOST_TARGET_AVX2 static void Run(std::size_t len,
+                                        const AccDataType* p_in,
+                                        std::size_t in_stride,
+                                        const AccDataType* p_wei,
+                                        AccDataType* p_acc)
+    {
+        host_conv_direct_micro_kernel<AccDataType, WR, KR, VL>(len, p_in, in_stride, p_wei, p_acc);
+    }
+};
+
+template <typename AccDataType>
+struct HostConvDirectMicroKernel<AccDataType, HostSimdIsa_t::Avx512>
+{
+    static constexpr int VL = HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Avx512>::VL;
+    static constexpr int WR = HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Avx512>::MR;
+    static constexpr int KR = HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Avx512>::NR;
+
+    CK_HOST_TARGET_AVX512 static void Run(std::size_t len,
+                                          const AccDataType* p_in,
+                                          std::size_t in_stride,
+                                          const AccDataType* p_wei,
+                                          AccDataType* p_acc)
+    {
+        host_conv_direct_micro_kernel<AccDataType, WR, KR, VL>(len, p_in, in_stride, p_wei, p_acc);
+    }
+};
+
+template <typename MicroKernel,
+          typename AccDataType,
+          typename TIn,
+          typename TWei,
+          typename TOut,
+          typename InElementwiseOperation,
+          typename WeiElementwiseOperation,
+          typename OutElementwiseOperation>
+void host_conv_fwd_direct_impl(const HostConvProblem& problem,
+                               const TIn* p_in,
+                               const TWei* p_wei,
+                               TOut* p_out,
+                               const InElementwiseOperation& in_element_op,
+                               const WeiElementwiseOperation& wei_element_op,
+                               const OutElementwiseOperation& out_element_op,
+                               std::size_t num_thread)
+{
+    constexpr std::size_t WR = MicroKernel::WR;
+    constexpr std::size_t KR = MicroKernel::KR;
+
+    const std::size_t N  = problem.N;
+    const std::size_t K  = problem.K;
+    const std::size_t C  = problem.C;
+    const std::size_t Y  = problem.Y;
+    const std::size_t X  = problem.X;
+    const std::size_t Ho = problem.Ho;
+    const std::size_t Wo = problem.Wo;
+
+    if(N * K * Ho * Wo == 0)
+        return;
+
+    const auto& in_strides  = problem.InStrides;
+    const auto& wei_strides = problem.WeiStrides;
+    const auto& out_strides = problem.OutStrides;
+
+    const std::size_t num_kb = (K + KR - 1) / KR;
+    const std::size_t XC     = X * C;
+
+    num_thread = std::max<std::size_t>(num_thread, 1);
+
+    // weights as [K / KR, Y, X, C, KR], zero padded along K
+    std::vector<AccDataType> wei_pack(num_kb * Y * XC * KR);
+
+    auto f_pack_wei = [&](std::size_t kb) {
+        for(std::size_t y = 0; y < Y; ++y)
+            for(std::size_t x = 0; x < X; ++x)
+                for(std::size_t c = 0; c < C; ++c)
+                {
+                    AccDataType* p_tap = wei_pack.data() + ((kb * Y + y) * XC + x * C + c) * KR;
+
+                    const std::size_t kr = std::min(KR, K - kb * KR);
+
+                    host_convert_elementwise(p_tap,
+                                             1,
+                                             p_wei + kb * KR * wei_strides[0] + c * wei_strides[1] +
+                                                 y * wei_strides[2] + x * wei_strides[3],
+                                             wei_strides[0],
+                                             kr,
+                                             wei_element_op);
+
+                    std::fill(p_tap + kr, p_tap + KR, AccDataType{0});
+                }
+    };
+
+    make_ParallelTensorFunctor(f_pack_wei, num_kb)(num_thread);
+
+    // padded input row: wide enough for Wo rounded up to WR pixels, so partial pixel tiles
+    // read zeros instead of running past the row
+    const std::size_t wo_pad = (Wo + WR - 1) / WR * WR;
+    const std::size_t wi_pad =
+        std::max((wo_pad - 1) * problem.ConvStrideW + (X - 1) * problem.ConvDilationW + 1,
+                 problem.InLeftPadW + problem.Wi);
+
+    const bool merge_x = problem.ConvDilationW == 1;
+
+    const bool in_row_linear = in_strides[1] == 1 && in_strides[3] == C;
+
+    auto f_row = [&](std::size_t n, std::size_t ho) {
+        thread_local std::vector<AccDataType> rows;
+        thread_local std::vector<AccDataType> acc;
+        thread_local std::vector<char> valid;
+
+        rows.resize(Y * wi_pad * C);
+        acc.resize(WR * KR);
+        valid.resize(Y);
+
+        const TIn* p_in_n = p_in + n * in_strides[0];
+
+        for(std::size_t y = 0; y < Y; ++y)
+        {
+            // unsigned wrap-around turns negative coordinates into out-of-range ones
+            const std::size_t hi =
+                ho * problem.ConvStrideH + y * problem.ConvDilationH - problem.InLeftPadH;
+
+            valid[y] = hi < problem.Hi;
+
+            if(!valid[y])
+                continue;
+
+            AccDataType* p_row = rows.data() + y * wi_pad * C;
+
+            std::fill(p_row, p_row + problem.InLeftPadW * C, AccDataType{0});
+
+            if(in_row_linear)
+            {
+                // NHWC: the input row is a single run of Wi * C elements
+                host_convert_elementwise(p_row + problem.InLeftPadW * C,
+                                         1,
+                                         p_in_n + hi * in_strides[2],
+                                         1,
+                                         problem.Wi * C,
+                                         in_element_op);
+            }
+            else
+            {
+                for(std::size_t wi = 0; wi < problem.Wi; ++wi)
+                    host_convert_elementwise(p_row + (problem.InLeftPadW + wi) * C,
+                                             1,
+                                             p_in_n + hi * in_strides[2] + wi * in_strides[3],
+                                             in_strides[1],
+                                             C,
+                                             in_element_op);
+            }
+
+            std::fill(p_row + (problem.InLeftPadW + problem.Wi) * C,
+                      p_row + wi_pad * C,
+                      AccDataType{0});
+        }
+
+        TOut* p_out_row = p_out + n * out_strides[0] + ho * out_strides[2];
+
+        const std::size_t in_stride = problem.ConvStrideW * C;
+
+        for(std::size_t kb = 0; kb < num_kb; ++kb)
+        {
+            const std::size_t kr = std::min(KR, K - kb * KR);
+
+            for(std::size_t wo0 = 0; wo0 < Wo; wo0 += WR)
+            {
+                std::fill(acc.begin(), acc.end(), AccDataType{0});
+
+                for(std::size_t y = 0; y < Y; ++y)
+                {
+                    if(!valid[y])
+                        continue;
+
+                    const AccDataType* p_row =
+                        rows.data() + y * wi_pad * C + wo0 * problem.ConvStrideW * C;
+
+                    const AccDataType* p_tap = wei_pack.data() + (kb * Y + y) * XC * KR;
+
+                    if(merge_x)
+                    {
+                        MicroKernel::Run(XC, p_row, in_stride, p_tap, acc.data());
+                    }
+                    else
+                    {
+                        for(std::size_t x = 0; x < X; ++x)
+                            MicroKernel::Run(C,
+                                             p_row + x * problem.ConvDilationW * C,
+                                             in_stride,
+                                             p_tap + x * C * KR,
+                                             acc.data());
+                    }
+                }
+
+                const std::size_t wr = std::min(WR, Wo - wo0);
+
+                for(std::size_t i = 0; i < wr; ++i)
+                {
+                    TOut* p_out_pixel = p_out_row + (wo0 + i) * out_strides[3];
+
+                    for(std::size_t j = 0; j < kr; ++j)
+                        p_out_pixel[(kb * KR + j) * out_strides[1]] =
+                            host_type_convert<TOut>(host_apply_elementwise_operation(
+                                out_element_op, acc[i * KR + j], n, kb * KR + j, ho, wo0 + i));
+                }
+            }
+        }
+    };
+
+    make_ParallelTensorFunctor(f_row, N, Ho)(num_thread, 1);
+}
+
+template <typename AccDataType,
+          typename TIn,
+          typename TWei,
+          typename TOut,
+          typename InElementwiseOperation,
+          typename WeiElementwiseOperation,
+          typename OutElementwiseOperation>
+void host_conv_fwd_direct(const HostConvProblem& problem,
+                          const TIn* p_in,
+                          const TWei* p_wei,
+                          TOut* p_out,
+                          const InElementwiseOperation& in_element_op,
+                          const WeiElementwiseOperation& wei_element_op,
+                          const OutElementwiseOperation& out_element_op,
+                          std::size_t num_thread = get_host_num_threads(),
+                          HostSimdIsa_t isa      = get_host_simd_isa())
+{
+    static_assert(std::is_same<AccDataType, float>::value ||
+                      std::is_same<AccDataType, double>::value,
+                  "wrong! host conv accumulates in float or double");
+
+    // an ISA the host does not support falls back to the best one it does
+    switch(std::min(isa, get_host_simd_isa()))
+    {
+    case HostSimdIsa_t::Avx512:
+        host_conv_fwd_direct_impl<HostConvDirectMicroKernel<AccDataType, HostSimdIsa_t::Avx512>,
+                                  AccDataType>(problem,
+                                               p_in,
+                                               p_wei,
+                                               p_out,
+                                               in_element_op,
+                                               wei_element_op,
+                                               out_element_op,
+                                               num_thread);
+        break;
+    case HostSimdIsa_t::Avx2:
+        host_conv_fwd_direct_impl<HostConvDirectMicroKernel<AccDataType, HostSimdIsa_t::Avx2>,
+                                  AccDataType>(problem,
+                                               p_in,
+                                               p_wei,
+                                               p_out,
+                                               in_element_op,
+                                               wei_element_op,
+                                               out_element_op,
+                                               num_thread);
+        break;
+    default:
+        host_conv_fwd_direct_impl<HostConvDirectMicroKernel<AccDataType, HostSimdIsa_t::Scalar>,
+                                  AccDataType>(problem,
+                                               p_in,
+                                               p_wei,
+                                               p_out,
+                                               in_element_op,
+                                               wei_element_op,
+                                               out_element_op,
+                                               num_thread);
+    }
+}
+
+#endif
@@ -0,0 +1,366 @@
+#ifndef HOST_CONV_FWD_IM2COL_HPP
+#define HOST_CONV_FWD_IM2COL_HPP
+
+#include <vector>
+#include <algorithm>
+#include "host_conv_problem.hpp"
+#include "host_gemm_blocked.hpp"
+
+// Host forward convolution lowered to the blocked host GEMM.
+//   out[n, k, ho, wo] = out_op(sum_{c, y, x} in_op(in[n, c, hi, wi]) * wei_op(wei[k, c, y, x]))
+// Work is split into (image, slab of output pixels) units. Each unit gathers its im2col panel
+// into a thread-local buffer sized to stay in L2 and runs a serial GEMM against the weights,
+// which are packed once into a [K, C * Y * X] matrix in the same tap order as the panel.
+// Taps are ordered (y, x, c) when C is the fastest input dimension (NHWC) and (c, y, x)
+// otherwise, so the gather always walks memory in order.
+// The blocking and micro-kernel ISA of the per-unit GEMMs can be chosen by the caller.
+// half_t inputs are widened to float in bulk once per call, in_op then sees float values.
+// bf16 (ushort) inputs and weights with a float accumulator stay bf16 in the panel and the packed
+// weights, the GEMM runs on bf16 tiles; in_op and wei_op results are rounded to bf16. Likewise
+// int8 inputs and weights with an int32 accumulator run on int8 tiles.
+// An indexed out_op (HostIndexedElementwiseOperation) is called as out_op(v, n, k, ho, wo) in the
+// store of the GEMM C tile.
+//
+// Specializations, detected from the problem:
+//   Filter1x1Stride1Pad0: the input is used as the GEMM A matrix directly, no gather
+//   Filter1x1Pad0:        strided gather without bounds checks
+
+enum class HostConvFwdSpecialization_t
+{
+    Default              = 0,
+    Filter1x1Pad0        = 1,
+    Filter1x1Stride1Pad0 = 2,
+};
+
+inline HostConvFwdSpecialization_t get_host_conv_fwd_specialization(const HostConvProblem& problem)
+{
+    if(problem.IsFilter1x1Stride1Pad0() && problem.Ho == problem.Hi && problem.Wo == problem.Wi)
+        return HostConvFwdSpecialization_t::Filter1x1Stride1Pad0;
+
+    if(problem.IsFilter1x1Pad0())
+        return HostConvFwdSpecialization_t::Filter1x1Pad0;
+
+    return HostConvFwdSpecialization_t::Default;
+}
+
+// Gather output pixels [p0, p0 + np) of one image into an im2col panel: [np, C * Y * X] with
+// (y, x, c) taps if tap_yxc, otherwise [C * Y * X, np] with (c, y, x) taps. Padding reads as zero.
+template <typename ColDataType, typename TIn, typename InElementwiseOperation>
+void host_conv_im2col_gather(const HostConvProblem& problem,
+                             const TIn* p_in_n,
+                             std::size_t p0,
+                             std::size_t np,
+                             bool tap_yxc,
+                             ColDataType* p_col,
+                             const InElementwiseOperation& in_element_op)
+{
+    const std::size_t C = problem.C;
+    const std::size_t Y = problem.Y;
+    const std::size_t X = problem.X;
+
+    const auto& in_strides = problem.InStrides;
+
+    const std::size_t col_stride_m = tap_yxc ? C * Y * X : 1;
+    const std::size_t col_stride_k = tap_yxc ? 1 : np;
+
+    // distance between channels of the same (y, x) tap
+    const std::size_t tap_stride_c = (tap_yxc ? 1 : Y * X) * col_stride_k;
+
+    const bool pad0 = problem.IsFilter1x1Pad0();
+
+    for(std::size_t ip = 0; ip < np; ++ip)
+    {
+        const std::size_t ho = (p0 + ip) / problem.Wo;
+        const std::size_t wo = (p0 + ip) % problem.Wo;
+
+        ColDataType* p_col_pixel = p_col + ip * col_stride_m;
+
+        if(pad0)
+        {
+            // Filter1x1Pad0: every tap is in range
+            const TIn* p_in_pixel = p_in_n + ho * problem.ConvStrideH * in_strides[2] +
+                                    wo * problem.ConvStrideW * in_strides[3];
+
+            host_convert_elementwise(
+                p_col_pixel, tap_stride_c, p_in_pixel, in_strides[1], C, in_element_op);
+
+            continue;
+        }
+
+        for(std::size_t y = 0; y < Y; ++y)
+        {
+            // unsigned wrap-around turns negative coordinates into out-of-range ones
+            const std::size_t hi =
+                ho * problem.ConvStrideH + y * problem.ConvDilationH - problem.InLeftPadH;
+
+            for(std::size_t x = 0; x < X; ++x)
+            {
+                const std::size_t wi =
+                    wo * problem.ConvStrideW + x * problem.ConvDilationW - problem.InLeftPadW;
+
+                ColDataType* p_col_tap =
+                    p_col_pixel + (tap_yxc ? (y * X + x) * C : y * X + x) * col_stride_k;
+
+                if(hi < problem.Hi && wi < problem.Wi)
+                {
+                    const TIn* p_in_pixel = p_in_n + hi * in_strides[2] + wi * in_strides[3];
+
+                    host_convert_elementwise(
+                        p_col_tap, tap_stride_c, p_in_pixel, in_strides[1], C, in_element_op);
+                }
+                else
+                {
+                    for(std::size_t c = 0; c < C; ++c)
+                        p_col_tap[c * tap_stride_c] = ColDataType{0};
+                }
+            }
+        }
+    }
+}
+
+// indexed out_op of a work unit as c_op of its GEMM, GEMM row m is output pixel p0 + m of image n
+template <typename OutElementwiseOperation>
+struct HostConvIm2colOutElementwiseOperation : public HostIndexedElementwiseOperation
+{
+    const OutElementwiseOperation& out_element_op;
+    std::size_t n;
+    std::size_t p0;
+    std::size_t Wo;
+
+    template <typename T>
+    auto operator()(T v, std::size_t m, std::size_t k) const
+    {
+        const std::size_t p = p0 + m;
+
+        return out_element_op(v, n, k, p / Wo, p % Wo);
+    }
+};
+
+template <typename AccDataType,
+          typename TIn,
+          typename TWei,
+          typename TOut,
+          typename InElementwiseOperation,
+          typename WeiElementwiseOperation,
+          typename OutElementwiseOperation>
+void host_conv_fwd_im2col(const HostConvProblem& problem,
+                          const TIn* p_in,
+                          const TWei* p_wei,
+                          TOut* p_out,
+                          const InElementwiseOperation& in_element_op,
+                          const WeiElementwiseOperation& wei_element_op,
+                          const OutElementwiseOperation& out_element_op,
+                          std::size_t num_thread    = get_host_num_threads(),
+                          HostGemmBlocking blocking = HostGemmBlocking{},
+                          HostSimdIsa_t isa         = get_host_simd_isa())
+{
+    const std::size_t N   = problem.N;
+    const std::size_t K   = problem.K;
+    const std::size_t C   = problem.C;
+    const std::size_t Y   = problem.Y;
+    const std::size_t X   = problem.X;
+    const std::size_t P   = problem.Ho * problem.Wo;
+    const std::size_t CYX = C * Y * X;
+
+    if(N * K * P == 0)
+        return;
+
+    if constexpr(std::is_same<TIn, ck::half_t>::value)
+    {
+        if(C * problem.Hi * problem.Wi > 0)
+        {
+            // every input element is gathered once per filter tap: widen the input to float in
+            // bulk once instead of converting it in every gather
+            const std::size_t in_space = 1 + (N - 1) * problem.InStrides[0] +
+                                         (C - 1) * problem.InStrides[1] +
+                                         (problem.Hi - 1) * problem.InStrides[2] +
+                                         (problem.Wi - 1) * problem.InStrides[3];
+
+            std::vector<float> in_f32(in_space);
+
+            HostThreadPool::GetInstance().ParallelFor(
+                in_space,
+                [&](std::size_t begin, std::size_t end) {
+                    host_convert_half_to_float(p_in + begin, in_f32.data() + begin, end - begin);
+                },
+                num_thread);
+
+            host_conv_fwd_im2col<AccDataType>(problem,
+                                              in_f32.data(),
+                                              p_wei,
+                                              p_out,
+                                              in_element_op,
+                                              wei_element_op,
+                                              out_element_op,
+                                              num_thread,
+                                              blocking,
+                                              isa);
+            return;
+        }
+    }
+
+    // element type of the im2col panel and the packed weights
+    using PackDataType = std::conditional_t<
+        std::is_same<TIn, ushort>::value && std::is_same<TWei, ushort>::value &&
+            std::is_same<AccDataType, float>::value,
+        ushort,
+        std::conditional_t<std::is_same<AccDataType, int32_t>::value, int8_t, AccDataType>>;
+
+    const auto& in_strides  = problem.InStrides;
+    const auto& wei_strides = problem.WeiStrides;
+    const auto& out_strides = problem.OutStrides;
+
+    const auto spec = get_host_conv_fwd_specialization(problem);
+
+    // C innermost: taps ordered (y, x, c), otherwise (c, y, x)
+    const bool tap_yxc = in_strides[1] < in_strides[3];
+
+    auto f_tap = [&](std::size_t c, std::size_t y, std::size_t x) {
+        return tap_yxc ? (y * X + x) * C + c : (c * Y + y) * X + x;
+    };
+
+    auto pass_through = [](AccDataType v) { return v; };
+
+    num_thread = std::max<std::size_t>(num_thread, 1);
+
+    // weights as a [K, CYX] matrix in tap order
+    std::vector<PackDataType> wei_pack(K * CYX);
+
+    // distance between channels of the same (y, x) tap
+    const std::size_t tap_stride_c = tap_yxc ? 1 : Y * X;
+
+    auto f_pack_wei = [&](std::size_t k) {
+        for(std::size_t y = 0; y < Y; ++y)
+            for(std::size_t x = 0; x < X; ++x)
+            {
+                host_convert_elementwise(wei_pack.data() + k * CYX + f_tap(0, y, x),
+                                         tap_stride_c,
+                                         p_wei + k * wei_strides[0] + y * wei_strides[2] +
+                                             x * wei_strides[3],
+                                         wei_strides[1],
+                                         C,
+                                         wei_element_op);
+            }
+    };
+
+    make_ParallelTensorFunctor(f_pack_wei, K)(num_thread);
+
+    // output pixels of one image are contiguous with a single stride
+    const bool out_linear = problem.Ho == 1 || out_strides[2] == problem.Wo * out_strides[3];
+
+    const bool in_linear = problem.Hi == 1 || in_strides[2] == problem.Wi * in_strides[3];
+
+    const bool direct = spec == HostConvFwdSpecialization_t::Filter1x1Stride1Pad0 && in_linear;
+
+    // slab of output pixels per work unit
+    std::size_t slab = std::max<std::size_t>(
+        host_conv_im2col_panel_bytes / std::max<std::size_t>(CYX * sizeof(PackDataType), 1), 64);
+
+    slab = std::min(
+        slab, std::max<std::size_t>((N * P + 4 * num_thread - 1) / (4 * num_thread), 16));
+    slab = std::min(slab, P);
+
+    const std::size_t num_slab = (P + slab - 1) / slab;
+
+    auto f_unit = [&](std::size_t n, std::size_t is) {
+        thread_local std::vector<PackDataType> col;
+        thread_local std::vector<TOut> out_tile;
+
+        const std::size_t p0 = is * slab;
+        const std::size_t np = std::min(slab, P - p0);
+
+        const TIn* p_in_n = p_in + n * in_strides[0];
+        TOut* p_out_n     = p_out + n * out_strides[0];
+
+        // GEMM output: straight into the tensor if possible, otherwise a [np, K] tile
+        TOut* p_c              = p_out_n + p0 * out_strides[3];
+        std::size_t c_stride_m = out_strides[3];
+        std::size_t c_stride_n = out_strides[1];
+
+        if(!out_linear)
+        {
+            out_tile.resize(np * K);
+
+            p_c        = out_tile.data();
+            c_stride_m = K;
+            c_stride_n = 1;
+        }
+
+        const auto c_element_op = [&]() {
+            if constexpr(is_host_indexed_elementwise_operation<OutElementwiseOperation>)
+                return HostConvIm2colOutElementwiseOperation<OutElementwiseOperation>{
+                    {}, out_element_op, n, p0, problem.Wo};
+            else
+                return out_element_op;
+        }();
+
+        if(direct)
+        {
+            host_gemm_blocked<AccDataType>(np,
+                                           K,
+                                           C,
+                                           p_in_n + p0 * in_strides[3],
+                                           in_strides[3],
+                                           in_strides[1],
+                                           wei_pack.data(),
+                                           1,
+                                           CYX,
+                                           p_c,
+                                           c_stride_m,
+                                           c_stride_n,
+                                           in_element_op,
+                                           pass_through,
+                                           c_element_op,
+                                           blocking,
+                                           1,
+                                           isa);
+        }
+        else
+        {
+            // panel is [np, CYX] for (y, x, c) taps and [CYX, np] for (c, y, x) taps
+            col.resize(np * CYX);
+
+            const std::size_t col_stride_m = tap_yxc ? CYX : 1;
+            const std::size_t col_stride_k = tap_yxc ? 1 : np;
+
+            host_conv_im2col_gather(problem, p_in_n, p0, np, tap_yxc, col.data(), in_element_op);
+
+            host_gemm_blocked<AccDataType>(np,
+                                           K,
+                                           CYX,
+                                           col.data(),
+                                           col_stride_m,
+                                           col_stride_k,
+                                           wei_pack.data(),
+                                           1,
+                                           CYX,
+                                           p_c,
+                                           c_stride_m,
+                                           c_stride_n,
+                                           pass_through,
+                                           pass_through,
+                                           c_element_op,
+                                           blocking,
+                                           1,
+                                           isa);
+        }
+
+        if(!out_linear)
+        {
+            for(std::size_t ip = 0; ip < np; ++ip)
+            {
+                const std::size_t ho = (p0 + ip) / problem.Wo;
+                const std::size_t wo = (p0 + ip) % problem.Wo;
+
+                TOut* p_out_pixel = p_out_n + ho * out_strides[2] + wo * out_strides[3];
+
+                for(std::size_t k = 0; k < K; ++k)
+                    p_out_pixel[k * out_strides[1]] = out_tile[ip * K + k];
+            }
+        }
+    };
+
+    make_ParallelTensorFunctor(f_unit, N, num_slab)(num_thread, 1);
+}
+
+#endif
@@ -0,0 +1,617 @@
+#ifndef HOST_CONV_FWD_NCHWC_HPP
+#define HOST_CONV_FWD_NCHWC_HPP
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include "host_conv_fwd_direct.hpp"
+
+// Host direct forward convolution in the channel-blocked layouts of the v5r1 dlops drivers:
+//   in[N, C0, Hi, Wi, C1], wei[K, C0, Y, X, C1], out[N, K0, Ho, Wo, K1]
+// with c = c0 * C1 + c1 and k = k0 * K1 + k1.
+//   out[n, k, ho, wo] = out_op(sum_{c, y, x} in_op(in[n, c, hi, wi]) * wei_op(wei[k, c, y, x]))
+// Work is split into (image, output row) units like host_conv_fwd_direct. A unit converts the
+// C0 x Y input rows it reads into zero-padded [Wi, C1] rows of AccDataType, weights are packed
+// as [K / KR, C0, Y, X, C1, KR]. The micro-kernel is specialized for KR = 8 or 16 output
+// channels and blocks WR output pixels along Wo in registers. With unit dilation along W, the
+// X * C1 taps of one filter row are contiguous in the padded row and in the packed weights.
+// out_op is applied as the tile is stored, an indexed out_op (HostIndexedElementwiseOperation)
+// as out_op(v, n, k, ho, wo) with the unblocked k. host_conv_fwd_maxpool_nchwc also max pools
+// the result of out_op while it is in cache, out itself may then be skipped.
+
+struct HostConvNchwcProblem
+{
+    std::size_t N  = 0;
+    std::size_t K0 = 0;
+    std::size_t K1 = 0;
+    std::size_t C0 = 0;
+    std::size_t C1 = 0;
+    std::size_t Y  = 0;
+    std::size_t X  = 0;
+    std::size_t Hi = 0;
+    std::size_t Wi = 0;
+    std::size_t Ho = 0;
+    std::size_t Wo = 0;
+
+    std::size_t ConvStrideH   = 1;
+    std::size_t ConvStrideW   = 1;
+    std::size_t ConvDilationH = 1;
+    std::size_t ConvDilationW = 1;
+    std::size_t InLeftPadH    = 0;
+    std::size_t InLeftPadW    = 0;
+    std::size_t InRightPadH   = 0;
+    std::size_t InRightPadW   = 0;
+
+    // in the order of the descriptors: (n, c0, hi, wi, c1), (k, c0, y, x, c1), (n, k0, ho, wo, k1)
+    std::array<std::size_t, 5> InStrides{};
+    std::array<std::size_t, 5> WeiStrides{};
+    std::array<std::size_t, 5> OutStrides{};
+
+    std::size_t GetK() const { return K0 * K1; }
+
+    std::size_t GetC() const { return C0 * C1; }
+
+    std::size_t CalculateFlop() const
+    {
+        return std::size_t(2) * N * GetK() * GetC() * Y * X * Ho * Wo;
+    }
+};
+
+inline HostConvNchwcProblem
+make_HostConvNchwcProblem(const HostTensorDescriptor& in_desc,
+                          const HostTensorDescriptor& wei_desc,
+                          const HostTensorDescriptor& out_desc,
+                          const std::array<std::size_t, 2>& conv_strides,
+                          const std::array<std::size_t, 2>& conv_dilations,
+                          const std::array<std::size_t, 2>& in_left_pads,
+                          const std::array<std::size_t, 2>& in_right_pads)
+{
+    if(in_desc.GetNumOfDimension() != 5 || wei_desc.GetNumOfDimension() != 5 ||
+       out_desc.GetNumOfDimension() != 5)
+    {
+        throw std::runtime_error("wrong! host NCHWc conv expects 5D tensors");
+    }
+
+    const auto& in_lengths  = in_desc.GetLengths();
+    const auto& wei_lengths = wei_desc.GetLengths();
+    const auto& out_lengths = out_desc.GetLengths();
+
+    HostConvNchwcProblem problem;
+
+    problem.N  = in_lengths[0];
+    problem.C0 = in_lengths[1];
+    problem.Hi = in_lengths[2];
+    problem.Wi = in_lengths[3];
+    problem.C1 = in_lengths[4];
+    problem.Y  = wei_lengths[2];
+    problem.X  = wei_lengths[3];
+    problem.K0 = out_lengths[1];
+    problem.Ho = out_lengths[2];
+    problem.Wo = out_lengths[3];
+    problem.K1 = out_lengths[4];
+
+    problem.ConvStrideH   = conv_strides[0];
+    problem.ConvStrideW   = conv_strides[1];
+    problem.ConvDilationH = conv_dilations[0];
+    problem.ConvDilationW = conv_dilations[1];
+    problem.InLeftPadH    = in_left_pads[0];
+    problem.InLeftPadW    = in_left_pads[1];
+    problem.InRightPadH   = in_right_pads[0];
+    problem.InRightPadW   = in_right_pads[1];
+
+    std::copy_n(in_desc.GetStrides().begin(), 5, problem.InStrides.begin());
+    std::copy_n(wei_desc.GetStrides().begin(), 5, problem.WeiStrides.begin());
+    std::copy_n(out_desc.GetStrides().begin(), 5, problem.OutStrides.begin());
+
+    if(wei_lengths[0] != problem.GetK() || wei_lengths[1] != problem.C0 ||
+       wei_lengths[4] != problem.C1 || out_lengths[0] != problem.N)
+    {
+        throw std::runtime_error("wrong! inconsistent host NCHWc conv tensor lengths");
+    }
+
+    return problem;
+}
+
+// 2D max pooling fused into host_conv_fwd_maxpool_nchwc: non-overlapping WindowH x WindowW windows
+// of out, pool[n, k0, hp, wp, k1] = max of the window at (hp * WindowH, wp * WindowW). Windows
+// that do not fit in out entirely are dropped, as with Hp = Ho / WindowH and Wp = Wo / WindowW.
+template <typename TPool>
+struct HostConvNchwcMaxPool
+{
+    TPool* p_pool = nullptr;
+
+    std::size_t WindowH = 1;
+    std::size_t WindowW = 1;
+    std::size_t Hp      = 0;
+    std::size_t Wp      = 0;
+
+    // in the order (n, k0, hp, wp, k1)
+    std::array<std::size_t, 5> Strides{};
+};
+
+// KR output channels by WR output pixels in 8 accumulator vectors. Larger tiles measured slower:
+// the compiler stops unrolling the pixel loop and keeps the accumulators in memory.
+template <typename AccDataType, int KPerTile, HostSimdIsa_t Isa>
+struct HostConvNchwcMicroKernel;
+
+template <typename AccDataType, int KPerTile>
+struct HostConvNchwcMicroKernel<AccDataType, KPerTile, HostSimdIsa_t::Scalar>
+{
+    static_assert(KPerTile == 8 || KPerTile == 16, "wrong! KPerTile should be 8 or 16");
+
+    static constexpr int KR = KPerTile;
+    static constexpr int VL = std::min<int>(KR, 16 / sizeof(AccDataType));
+    static constexpr int WR = std::max(8 / (KR / VL), 1);
+
+    static void Run(std::size_t len,
+                    const AccDataType* p_in,
+                    std::size_t in_stride,
+                    const AccDataType* p_wei,
+                    AccDataType* p_acc)
+    {
+        host_conv_direct_micro_kernel<AccDataType, WR, KR, VL>(len, p_in, in_stride, p_wei, p_acc);
+    }
+};
+
+template <typename AccDataType, int KPerTile>
+struct HostConvNchwcMicroKernel<AccDataType, KPerTile, HostSimdIsa_t::Avx2>
+{
+    static_assert(KPerTile == 8 || KPerTile == 16, "wrong! KPerTile should be 8 or 16");
+
+    static constexpr int KR = KPerTile;
+    static constexpr int VL = std::min<int>(KR, 32 / sizeof(AccDataType));
+    static constexpr int WR = 8 / (KR / VL);
+
+    CK_HOST_TARGET_AVX2 static void Run(std::size_t len,
+                                        const AccDataType* p_in,
+                                        std::size_t in_stride,
+                                        const AccDataType* p_wei,
+                                        AccDataType* p_acc)
+    {
+        host_conv_direct_micro_kernel<AccDataType, WR, KR, VL>(len, p_in, in_stride, p_wei, p_acc);
+    }
+};
+
+template <typename AccDataType, int KPerTile>
+struct HostConvNchwcMicroKernel<AccDataType, KPerTile, HostSimdIsa_t::Avx512>
+{
+    static_assert(KPerTile == 8 || KPerTile == 16, "wrong! KPerTile should be 8 or 16");
+
+    static constexpr int KR = KPerTile;
+    static constexpr int VL = std::min<int>(KR, 64 / sizeof(AccDataType));
+    static constexpr int WR = 8 / (KR / VL);
+
+    CK_HOST_TARGET_AVX512 static void Run(std::size_t len,
+                                          const AccDataType* p_in,
+                                          std::size_t in_stride,
+                                          const AccDataType* p_wei,
+                                          AccDataType* p_acc)
+    {
+        host_conv_direct_micro_kernel<AccDataType, WR, KR, VL>(len, p_in, in_stride, p_wei, p_acc);
+    }
+};
+
+// A work unit is one image by WindowH output rows (one row without pooling). Its output is
+// computed in blocks of KR channels by WoBlock = lcm(WR, WindowW) columns, all rows of a block
+// before the next one, so a block holds whole pooling windows. Values of the block after out_op
+// are reduced over the rows in a WoBlock x KR tile, that is pooled over the columns once the
+// last row is done. p_out may be null, out is then never written.
+template <typename MicroKernel,
+          typename AccDataType,
+          typename TIn,
+          typename TWei,
+          typename TOut,
+          typename TPool,
+          typename InElementwiseOperation,
+          typename WeiElementwiseOperation,
+          typename OutElementwiseOperation>
+void host_conv_fwd_nchwc_impl(const HostConvNchwcProblem& problem,
+                              const TIn* p_in,
+                              const TWei* p_wei,
+                              TOut* p_out,
+                              const HostConvNchwcMaxPool<TPool>& pool,
+                              const InElementwiseOperation& in_element_op,
+                              const WeiElementwiseOperation& wei_element_op,
+                              const OutElementwiseOperation& out_element_op,
+                              std::size_t num_thread)
+{
+    constexpr std::size_t KR = MicroKernel::KR;
+    constexpr std::size_t WR = MicroKernel::WR;
+
+    const std::size_t N  = problem.N;
+    const std::size_t K  = problem.GetK();
+    const std::size_t K1 = problem.K1;
+    const std::size_t C0 = problem.C0;
+    const std::size_t C1 = problem.C1;
+    const std::size_t Y  = problem.Y;
+    const std::size_t X  = problem.X;
+    const std::size_t Ho = problem.Ho;
+    const std::size_t Wo = problem.Wo;
+
+    if(N * K * Ho * Wo == 0)
+        return;
+
+    const auto& in_strides  = problem.InStrides;
+    const auto& wei_strides = problem.WeiStrides;
+    const auto& out_strides = problem.OutStrides;
+
+    const bool do_pool = pool.p_pool != nullptr;
+
+    const std::size_t ho_per_unit = do_pool ? pool.WindowH : 1;
+    const std::size_t wo_block    = do_pool ? std::lcm(WR, pool.WindowW) : WR;
+
+    const std::size_t num_kb = (K + KR - 1) / KR;
+    const std::size_t XC1    = X * C1;
+
+    num_thread = std::max<std::size_t>(num_thread, 1);
+
+    // weights as [K / KR, C0, Y, X, C1, KR], zero padded along K
+    std::vector<AccDataType> wei_pack(num_kb * C0 * Y * XC1 * KR);
+
+    auto f_pack_wei = [&](std::size_t kb, std::size_t c0) {
+        const std::size_t kr = std::min(KR, K - kb * KR);
+
+        for(std::size_t y = 0; y < Y; ++y)
+            for(std::size_t x = 0; x < X; ++x)
+                for(std::size_t c1 = 0; c1 < C1; ++c1)
+                {
+                    AccDataType* p_tap =
+                        wei_pack.data() + (((kb * C0 + c0) * Y + y) * XC1 + x * C1 + c1) * KR;
+
+                    host_convert_elementwise(p_tap,
+                                             1,
+                                             p_wei + kb * KR * wei_strides[0] +
+                                                 c0 * wei_strides[1] + y * wei_strides[2] +
+                                                 x * wei_strides[3] + c1 * wei_strides[4],
+                                             wei_strides[0],
+                                             kr,
+                                             wei_element_op);
+
+                    std::fill(p_tap + kr, p_tap + KR, AccDataType{0});
+                }
+    };
+
+    make_ParallelTensorFunctor(f_pack_wei, num_kb, C0)(num_thread);
+
+    // padded input row: wide enough for Wo rounded up to WR pixels, so partial pixel tiles
+    // read zeros instead of running past the row
+    const std::size_t wo_pad = (Wo + WR - 1) / WR * WR;
+    const std::size_t wi_pad =
+        std::max((wo_pad - 1) * problem.ConvStrideW + (X - 1) * problem.ConvDilationW + 1,
+                 problem.InLeftPadW + problem.Wi);
+
+    // input rows read by the output rows of a unit
+    const std::size_t hi_per_unit =
+        (ho_per_unit - 1) * problem.ConvStrideH + (Y - 1) * problem.ConvDilationH + 1;
+
+    const bool merge_x = problem.ConvDilationW == 1;
+
+    const bool in_row_linear = in_strides[4] == 1 && in_strides[3] == C1;
+
+    auto f_unit = [&](std::size_t n, std::size_t hu) {
+        thread_local std::vector<AccDataType> rows;
+        thread_local std::vector<AccDataType> acc;
+        thread_local std::vector<AccDataType> block;
+        thread_local std::vector<char> valid;
+
+        rows.resize(C0 * hi_per_unit * wi_pad * C1);
+        acc.resize(WR * KR);
+        block.resize(wo_block * KR);
+        valid.resize(hi_per_unit);
+
+        const std::size_t ho_begin = hu * ho_per_unit;
+        const std::size_t ho_end   = std::min(ho_begin + ho_per_unit, Ho);
+
+        for(std::size_t r = 0; r < hi_per_unit; ++r)
+        {
+            // unsigned wrap-around turns negative coordinates into out-of-range ones
+            const std::size_t hi = ho_begin * problem.ConvStrideH + r - problem.InLeftPadH;
+
+            valid[r] = hi < problem.Hi;
+
+            if(!valid[r])
+                continue;
+
+            for(std::size_t c0 = 0; c0 < C0; ++c0)
+            {
+                const TIn* p_in_row = p_in + n * in_strides[0] + c0 * in_strides[1] +
+                                      hi * in_strides[2];
+
+                AccDataType* p_row = rows.data() + (c0 * hi_per_unit + r) * wi_pad * C1;
+
+                std::fill(p_row, p_row + problem.InLeftPadW * C1, AccDataType{0});
+
+                if(in_row_linear)
+                {
+                    host_convert_elementwise(p_row + problem.InLeftPadW * C1,
+                                             1,
+                                             p_in_row,
+                                             1,
+                                             problem.Wi * C1,
+                                             in_element_op);
+                }
+                else
+                {
+                    for(std::size_t wi = 0; wi < problem.Wi; ++wi)
+                        host_convert_elementwise(p_row + (problem.InLeftPadW + wi) * C1,
+                                                 1,
+                                                 p_in_row + wi * in_strides[3],
+                                                 in_strides[4],
+                                                 C1,
+                                                 in_element_op);
+                }
+
+                std::fill(p_row + (problem.InLeftPadW + problem.Wi) * C1,
+                          p_row + wi_pad * C1,
+                          AccDataType{0});
+            }
+        }
+
+        const std::size_t in_stride = problem.ConvStrideW * C1;
+
+        // acc = sum over c0, y, x of the output row ho, pixels [wo0, wo0 + WR)
+        auto f_tile = [&](std::size_t kb, std::size_t ho, std::size_t wo0) {
+            std::fill(acc.begin(), acc.end(), AccDataType{0});
+
+            for(std::size_t c0 = 0; c0 < C0; ++c0)
+                for(std::size_t y = 0; y < Y; ++y)
+                {
+                    const std::size_t r =
+                        (ho - ho_begin) * problem.ConvStrideH + y * problem.ConvDilationH;
+
+                    if(!valid[r])
+                        continue;
+
+                    const AccDataType* p_row = rows.data() + (c0 * hi_per_unit + r) * wi_pad * C1 +
+                                               wo0 * problem.ConvStrideW * C1;
+
+                    const AccDataType* p_tap =
+                        wei_pack.data() + ((kb * C0 + c0) * Y + y) * XC1 * KR;
+
+                    if(merge_x)
+                    {
+                        MicroKernel::Run(XC1, p_row, in_stride, p_tap, acc.data());
+                    }
+                    else
+                    {
+                        for(std::size_t x = 0; x < X; ++x)
+                            MicroKernel::Run(C1,
+                                             p_row + x * problem.ConvDilationW * C1,
+                                             in_stride,
+                                             p_tap + x * C1 * KR,
+                                             acc.data());
+                    }
+                }
+        };
+
+        for(std::size_t kb = 0; kb < num_kb; ++kb)
+        {
+            const std::size_t kr = std::min(KR, K - kb * KR);
+
+            // offsets of the kr output channels of this block in an output pixel
+            std::array<std::size_t, KR> out_offsets, pool_offsets;
+
+            for(std::size_t j = 0; j < kr; ++j)
+            {
+                const std::size_t k0 = (kb * KR + j) / K1;
+                const std::size_t k1 = (kb * KR + j) % K1;
+
+                out_offsets[j]  = k0 * out_strides[1] + k1 * out_strides[4];
+                pool_offsets[j] = k0 * pool.Strides[1] + k1 * pool.Strides[4];
+            }
+
+            for(std::size_t wo_b = 0; wo_b < Wo; wo_b += wo_block)
+            {
+                const std::size_t wo_e = std::min(wo_b + wo_block, Wo);
+
+                for(std::size_t ho = ho_begin; ho < ho_end; ++ho)
+                {
+                    const std::size_t out_row = n * out_strides[0] + ho * out_strides[2];
+
+                    for(std::size_t wo0 = wo_b; wo0 < wo_e; wo0 += WR)
+                    {
+                        f_tile(kb, ho, wo0);
+
+                        const std::size_t wr = std::min(WR, wo_e - wo0);
+
+                        for(std::size_t i = 0; i < wr; ++i)
+                        {
+                            AccDataType* p_block = block.data() + (wo0 - wo_b + i) * KR;
+
+                            for(std::size_t j = 0; j < kr; ++j)
+                            {
+                                const auto v = host_apply_elementwise_operation(
+                                    out_element_op, acc[i * KR + j], n, kb * KR + j, ho, wo0 + i);
+
+                                if(p_out != nullptr)
+                                    p_out[out_row + (wo0 + i) * out_strides[3] + out_offsets[j]] =
+                                        host_type_convert<TOut>(v);
+
+                                if(do_pool)
+                                {
+                                    const AccDataType u = host_type_convert<AccDataType>(v);
+
+                                    p_block[j] = ho == ho_begin ? u : std::max(p_block[j], u);
+                                }
+                            }
+                        }
+                    }
+                }
+
+                const std::size_t hp = ho_begin / ho_per_unit;
+
+                if(!do_pool || hp >= pool.Hp)
+                    continue;
+
+                const std::size_t wp_end = std::min(wo_e / pool.WindowW, pool.Wp);
+
+                for(std::size_t wp = wo_b / pool.WindowW; wp < wp_end; ++wp)
+                {
+                    TPool* p_pool_pixel = pool.p_pool + n * pool.Strides[0] +
+                                          hp * pool.Strides[2] + wp * pool.Strides[3];
+
+                    const AccDataType* p_window =
+                        block.data() + (wp * pool.WindowW - wo_b) * KR;
+
+                    for(std::size_t j = 0; j < kr; ++j)
+                    {
+                        AccDataType v = p_window[j];
+
+                        for(std::size_t s = 1; s < pool.WindowW; ++s)
+                            v = std::max(v, p_window[s * KR + j]);
+
+                        p_pool_pixel[pool_offsets[j]] = host_type_convert<TPool>(v);
+                    }
+                }
+            }
+        }
+    };
+
+    make_ParallelTensorFunctor(f_unit, N, (Ho + ho_per_unit - 1) / ho_per_unit)(num_thread, 1);
+}
+
+// KR = 16 when K is a multiple of 16, 8 otherwise. KR blocks need not line up with K1 blocks,
+// with K1 = 8 a 16 channel block spans two of them.
+template <typename AccDataType,
+          HostSimdIsa_t Isa,
+          typename TIn,
+          typename TWei,
+          typename TOut,
+          typename TPool,
+          typename InElementwiseOperation,
+          typename WeiElementwiseOperation,
+          typename OutElementwiseOperation>
+void host_conv_fwd_nchwc_isa(const HostConvNchwcProblem& problem,
+                             const TIn* p_in,
+                             const TWei* p_wei,
+                             TOut* p_out,
+                             const HostConvNchwcMaxPool<TPool>& pool,
+                             const InElementwiseOperation& in_element_op,
+                             const WeiElementwiseOperation& wei_element_op,
+                             const OutElementwiseOperation& out_element_op,
+                             std::size_t num_thread)
+{
+    if(problem.GetK() % 16 == 0)
+        host_conv_fwd_nchwc_impl<HostConvNchwcMicroKernel<AccDataType, 16, Isa>, AccDataType>(
+            problem,
+            p_in,
+            p_wei,
+            p_out,
+            pool,
+            in_element_op,
+            wei_element_op,
+            out_element_op,
+            num_thread);
+    else
+        host_conv_fwd_nchwc_impl<HostConvNchwcMicroKernel<AccDataType, 8, Isa>, AccDataType>(
+            problem,
+            p_in,
+            p_wei,
+            p_out,
+            pool,
+            in_element_op,
+            wei_element_op,
+            out_element_op,
+            num_thread);
+}
+
+template <typename AccDataType,
+          typename TIn,
+          typename TWei,
+          typename TOut,
+          typename TPool,
+          typename InElementwiseOperation,
+          typename WeiElementwiseOperation,
+          typename OutElementwiseOperation>
+void host_conv_fwd_maxpool_nchwc(const HostConvNchwcProblem& problem,
+                                 const TIn* p_in,
+                                 const TWei* p_wei,
+                                 TOut* p_out,
+                                 const HostConvNchwcMaxPool<TPool>& pool,
+                                 const InElementwiseOperation& in_element_op,
+                                 const WeiElementwiseOperation& wei_element_op,
+                                 const OutElementwiseOperation& out_element_op,
+                                 std::size_t num_thread = get_host_num_threads(),
+                                 HostSimdIsa_t isa      = get_host_simd_isa())
+{
+    static_assert(std::is_same<AccDataType, float>::value ||
+                      std::is_same<AccDataType, double>::value,
+                  "wrong! host conv accumulates in float or double");
+
+    if(pool.p_pool != nullptr && (pool.WindowH == 0 || pool.WindowW == 0 ||
+                                  pool.Hp > problem.Ho / pool.WindowH ||
+                                  pool.Wp > problem.Wo / pool.WindowW))
+    {
+        throw std::runtime_error("wrong! pooled lengths do not fit the conv output");
+    }
+
+    // an ISA the host does not support falls back to the best one it does
+    switch(std::min(isa, get_host_simd_isa()))
+    {
+    case HostSimdIsa_t::Avx512:
+        host_conv_fwd_nchwc_isa<AccDataType, HostSimdIsa_t::Avx512>(problem,
+                                                                    p_in,
+                                                                    p_wei,
+                                                                    p_out,
+                                                                    pool,
+                                                                    in_element_op,
+                                                                    wei_element_op,
+                                                                    out_element_op,
+                                                                    num_thread);
+        break;
+    case HostSimdIsa_t::Avx2:
+        host_conv_fwd_nchwc_isa<AccDataType, HostSimdIsa_t::Avx2>(problem,
+                                                                  p_in,
+                                                                  p_wei,
+                                                                  p_out,
+                                                                  pool,
+                                                                  in_element_op,
+                                                                  wei_element_op,
+                                                                  out_element_op,
+                                                                  num_thread);
+        break;
+    default:
+        host_conv_fwd_nchwc_isa<AccDataType, HostSimdIsa_t::Scalar>(problem,
+                                                                    p_in,
+                                                                    p_wei,
+                                                                    p_out,
+                                                                    pool,
+                                                                    in_element_op,
+                                                                    wei_element_op,
+                                                                    out_element_op,
+                                                                    num_thread);
+    }
+}
+
+template <typename AccDataType,
+          typename TIn,
+          typename TWei,
+          typename TOut,
+          typename InElementwiseOperation,
+          typename WeiElementwiseOperation,
+          typename OutElementwiseOperation>
+void host_conv_fwd_nchwc(const HostConvNchwcProblem& problem,
+                         const TIn* p_in,
+                         const TWei* p_wei,
+                         TOut* p_out,
+                         const InElementwiseOperation& in_element_op,
+                         const WeiElementwiseOperation& wei_element_op,
+                         const OutElementwiseOperation& out_element_op,
+                         std::size_t num_thread = get_host_num_threads(),
+                         HostSimdIsa_t isa      = get_host_simd_isa())
+{
+    host_conv_fwd_maxpool_nchwc<AccDataType>(problem,
+                                             p_in,
+                                             p_wei,
+                                             p_out,
+                                             HostConvNchwcMaxPool<TOut>{},
+                                             in_element_op,
+                                             wei_element_op,
+                                             out_element_op,
+                                             num_thread,
+                                             isa);
+}
+
+#endif
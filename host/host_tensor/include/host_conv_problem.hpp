@@ -0,0 +1,129 @@
+#ifndef HOST_CONV_PROBLEM_HPP
+#define HOST_CONV_PROBLEM_HPP
+
+#include <array>
+#include <stdexcept>
+#include "host_tensor.hpp"
+
+// Order in which a host Tensor is indexed:
+//   NCHW: in(n, c, hi, wi), wei(k, c, y, x), out(n, k, ho, wo)
+//   NHWC: in(n, hi, wi, c), wei(k, y, x, c), out(n, ho, wo, k)
+// The memory layout is given by the strides of the descriptor and is independent of this.
+enum class HostConvTensorLayout_t
+{
+    NCHW = 0,
+    NHWC = 1,
+};
+
+// size of the gathered GEMM panel of one work unit in the host conv engines, fits in L2
+constexpr std::size_t host_conv_im2col_panel_bytes = std::size_t{1} << 20;
+
+// 2D convolution problem as seen by the host engines. Tensor strides are stored in the logical
+// (n, c, hi, wi), (k, c, y, x) and (n, k, ho, wo) order.
+struct HostConvProblem
+{
+    std::size_t N  = 0;
+    std::size_t K  = 0;
+    std::size_t C  = 0;
+    std::size_t Y  = 0;
+    std::size_t X  = 0;
+    std::size_t Hi = 0;
+    std::size_t Wi = 0;
+    std::size_t Ho = 0;
+    std::size_t Wo = 0;
+
+    std::size_t ConvStrideH   = 1;
+    std::size_t ConvStrideW   = 1;
+    std::size_t ConvDilationH = 1;
+    std::size_t ConvDilationW = 1;
+    std::size_t InLeftPadH    = 0;
+    std::size_t InLeftPadW    = 0;
+    std::size_t InRightPadH   = 0;
+    std::size_t InRightPadW   = 0;
+
+    std::array<std::size_t, 4> InStrides{};
+    std::array<std::size_t, 4> WeiStrides{};
+    std::array<std::size_t, 4> OutStrides{};
+
+    bool IsFilter1x1Pad0() const
+    {
+        return Y == 1 && X == 1 && InLeftPadH == 0 && InLeftPadW == 0 && InRightPadH == 0 &&
+               InRightPadW == 0;
+    }
+
+    bool IsFilter1x1Stride1Pad0() const
+    {
+        return IsFilter1x1Pad0() && ConvStrideH == 1 && ConvStrideW == 1;
+    }
+
+    std::size_t CalculateFlop() const { return std::size_t(2) * N * K * C * Y * X * Ho * Wo; }
+};
+
+inline HostConvProblem make_HostConvProblem(const HostTensorDescriptor& in_desc,
+                                            const HostTensorDescriptor& wei_desc,
+                                            const HostTensorDescriptor& out_desc,
+                                            const std::array<std::size_t, 2>& conv_strides,
+                                            const std::array<std::size_t, 2>& conv_dilations,
+                                            const std::array<std::size_t, 2>& in_left_pads,
+                                            const std::array<std::size_t, 2>& in_right_pads,
+                                            HostConvTensorLayout_t layout)
+{
+    if(in_desc.GetNumOfDimension() != 4 || wei_desc.GetNumOfDimension() != 4 ||
+       out_desc.GetNumOfDimension() != 4)
+    {
+        throw std::runtime_error("wrong! host conv expects 4D tensors");
+    }
+
+    // position of logical dimensions (n/k, c/k, h, w) in the descriptor
+    const std::array<std::size_t, 4> order = layout == HostConvTensorLayout_t::NHWC
+                                                 ? std::array<std::size_t, 4>{0, 3, 1, 2}
+                                                 : std::array<std::size_t, 4>{0, 1, 2, 3};
+
+    auto f_get = [&](const HostTensorDescriptor& desc, std::array<std::size_t, 4>& lengths) {
+        std::array<std::size_t, 4> strides;
+
+        for(std::size_t i = 0; i < 4; ++i)
+        {
+            lengths[i] = desc.GetLengths()[order[i]];
+            strides[i] = desc.GetStrides()[order[i]];
+        }
+
+        return strides;
+    };
+
+    std::array<std::size_t, 4> in_lengths, wei_lengths, out_lengths;
+
+    HostConvProblem problem;
+
+    problem.InStrides  = f_get(in_desc, in_lengths);
+    problem.WeiStrides = f_get(wei_desc, wei_lengths);
+    problem.OutStrides = f_get(out_desc, out_lengths);
+
+    problem.N  = in_lengths[0];
+    problem.C  = in_lengths[1];
+    problem.Hi = in_lengths[2];
+    problem.Wi = in_lengths[3];
+    problem.K  = wei_lengths[0];
+    problem.Y  = wei_lengths[2];
+    problem.X  = wei_lengths[3];
+    problem.Ho = out_lengths[2];
+    problem.Wo = out_lengths[3];
+
+    problem.ConvStrideH   = conv_strides[0];
+    problem.ConvStrideW   = conv_strides[1];
+    problem.ConvDilationH = conv_dilations[0];
+    problem.ConvDilationW = conv_dilations[1];
+    problem.InLeftPadH    = in_left_pads[0];
+    problem.InLeftPadW    = in_left_pads[1];
+    problem.InRightPadH   = in_right_pads[0];
+    problem.InRightPadW   = in_right_pads[1];
+
+    if(wei_lengths[1] != problem.C || out_lengths[0] != problem.N || out_lengths[1] != problem.K)
+    {
+        throw std::runtime_error("wrong! inconsistent host conv tensor lengths");
+    }
+
+    return problem;
+}
+
+#endif
@@ -1,5 +1,6 @@
 #pragma once
 #include "host_tensor.hpp"
+#include "host_gemm_blocked.hpp"
 
 template <typename AType,
           typename BType,
@@ -12,23 +13,97 @@ void host_gemm_mk_kn_mn(const Tensor<AType>& a_m_k,
                         Tensor<CType>& c_m_n,
                         const AElementwiseOperation& a_element_op,
                         const BElementwiseOperation& b_element_op,
-                        const CElementwiseOperation& c_element_op)
+                        const CElementwiseOperation& c_element_op,
+                        HostGemmPrecision_t precision = HostGemmPrecision_t::Strict)
 {
-    auto f_mk_kn_mn = [&](auto m, auto n) {
-        const int K = a_m_k.mDesc.GetLengths()[1];
+    const std::size_t M = c_m_n.mDesc.GetLengths()[0];
+    const std::size_t N = c_m_n.mDesc.GetLengths()[1];
+    const std::size_t K = a_m_k.mDesc.GetLengths()[1];
 
-        double v = 0;
+    const auto& a_strides = a_m_k.mDesc.GetStrides();
+    const auto& b_strides = b_k_n.mDesc.GetStrides();
+    const auto& c_strides = c_m_n.mDesc.GetStrides();
 
-        for(int k = 0; k < K; ++k)
-        {
-            v += static_cast<const double>(a_element_op(a_m_k(m, k))) *
-                 static_cast<const double>(b_element_op(b_k_n(k, n)));
-        }
+    auto f_gemm = [&](auto acc) {
+        using AccDataType = decltype(acc);
 
-        c_m_n(m, n) = c_element_op(v);
+        host_gemm_blocked<AccDataType>(M,
+                                       N,
+                                       K,
+                                       a_m_k.mData.data(),
+                                       a_strides[0],
+                                       a_strides[1],
+                                       b_k_n.mData.data(),
+                                       b_strides[0],
+                                       b_strides[1],
+                                       c_m_n.mData.data(),
+                                       c_strides[0],
+                                       c_strides[1],
+                                       a_element_op,
+                                       b_element_op,
+                                       c_element_op);
     };
 
-    make_ParallelTensorFunctor(f_mk_kn_mn,
-                               c_m_n.mDesc.GetLengths()[0],
-                               c_m_n.mDesc.GetLengths()[1])(std::thread::hardware_concurrency());
+    if constexpr(is_host_gemm_int8<AType, BType>)
+        f_gemm(int32_t{});
+    else if(precision == HostGemmPrecision_t::Strict)
+        f_gemm(double{});
+    else
+        f_gemm(float{});
+}
+
+// c_g_m_n[g] = a_g_m_k[g] * b_g_k_n[g] for every g, C tiles of all batches run in parallel
+template <typename AType,
+          typename BType,
+          typename CType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CElementwiseOperation>
+void host_batched_gemm_g_mk_kn_mn(const Tensor<AType>& a_g_m_k,
+                                  const Tensor<BType>& b_g_k_n,
+                                  Tensor<CType>& c_g_m_n,
+                                  const AElementwiseOperation& a_element_op,
+                                  const BElementwiseOperation& b_element_op,
+                                  const CElementwiseOperation& c_element_op,
+                                  HostGemmPrecision_t precision = HostGemmPrecision_t::Strict)
+{
+    const std::size_t G = c_g_m_n.mDesc.GetLengths()[0];
+    const std::size_t M = c_g_m_n.mDesc.GetLengths()[1];
+    const std::size_t N = c_g_m_n.mDesc.GetLengths()[2];
+    const std::size_t K = a_g_m_k.mDesc.GetLengths()[2];
+
+    const auto& a_strides = a_g_m_k.mDesc.GetStrides();
+    const auto& b_strides = b_g_k_n.mDesc.GetStrides();
+    const auto& c_strides = c_g_m_n.mDesc.GetStrides();
+
+    auto f_gemm = [&](auto acc) {
+        using AccDataType = decltype(acc);
+
+        host_batched_gemm_blocked<AccDataType>(G,
+                                               M,
+                                               N,
+                                               K,
+                                               a_g_m_k.mData.data(),
+                                               a_strides[0],
+                                               a_strides[1],
+                                               a_strides[2],
+                                               b_g_k_n.mData.data(),
+                                               b_strides[0],
+                                               b_strides[1],
+                                               b_strides[2],
+                                               c_g_m_n.mData.data(),
+                                               c_strides[0],
+                                               c_strides[1],
+                                               c_strides[2],
+                                               a_element_op,
+                                               b_element_op,
+                                               c_element_op);
+    };
+
+    if constexpr(is_host_gemm_int8<AType, BType>)
+        f_gemm(int32_t{});
+    else if(precision == HostGemmPrecision_t::Strict)
+        f_gemm(double{});
+    else
+        f_gemm(float{});
 }
@@ -0,0 +1,1271 @@
+#ifndef HOST_GEMM_BLOCKED_HPP
+#define HOST_GEMM_BLOCKED_HPP
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <type_traits>
+#include "host_tensor.hpp"
+#include "host_simd.hpp"
+#include "host_tensor_convert.hpp"
+
+#if CK_HOST_X86
+#include <immintrin.h>
+#endif
+
+// Packed, cache-blocked host GEMM.
+//   C[m, n] = c_op(sum_k a_op(A[m, k]) * b_op(B[k, n]))
+// A, B and C are addressed through (row, col) strides, so any RowMajor/ColumnMajor combination
+// (and transposed outputs) goes through the same code. Operands are converted to AccDataType
+// while packing (half_t runs in bulk through F16C, see host_tensor_convert.hpp), the MR x NR
+// micro-kernel then runs on contiguous panels.
+// bf16 (ushort) A and B with fp32 accumulation stay bf16 in the panels, with pairs of k
+// interleaved. The micro-kernel either feeds them to vdpbf16ps (AVX-512 BF16) or widens them in
+// registers, a shift for the even and a mask for the odd k of every pair.
+// int8 A and B accumulate exactly in int32 on int8 panels holding groups of four k, through
+// vpdpbusd (AVX-512 VNNI / AVX-VNNI) or vpmaddwd. c_op then requantizes the int32 tile if needed.
+// c_op is applied to the accumulator tile while it is stored, epilogues that read other tensors
+// (bias, residual) derive from HostIndexedElementwiseOperation and are fused into that store.
+
+// Precision of the host_gemm.hpp / host_conv.hpp entry points, which are the host references
+// and default to Strict. Fast is what the host device instances and timed host algorithms run.
+enum class HostGemmPrecision_t
+{
+    Fast   = 0, // accumulate in fp32
+    Strict = 1, // accumulate in fp64
+};
+
+// int8 x int8 products are summed exactly in int32, whatever the precision
+template <typename ADataType, typename BDataType>
+constexpr bool is_host_gemm_int8 =
+    std::is_same<ADataType, int8_t>::value && std::is_same<BDataType, int8_t>::value;
+
+struct HostGemmBlocking
+{
+    std::size_t MC = 192;
+    std::size_t NC = 512;
+    std::size_t KC = 256;
+};
+
+// Element-wise operations deriving from this are also given the coordinates of the value they
+// produce: the blocked GEMM calls c_op(v, m, n), the host conv engines out_op(v, n, k, ho, wo).
+struct HostIndexedElementwiseOperation
+{
+};
+
+template <typename ElementwiseOperation>
+constexpr bool is_host_indexed_elementwise_operation =
+    std::is_base_of<HostIndexedElementwiseOperation, ElementwiseOperation>::value;
+
+// op(v, is...) for indexed operations, op(v) otherwise
+template <typename ElementwiseOperation, typename T, typename... Is>
+CK_HOST_ALWAYS_INLINE auto host_apply_elementwise_operation(const ElementwiseOperation& op,
+                                                            T v,
+                                                            Is... is)
+{
+    if constexpr(is_host_indexed_elementwise_operation<ElementwiseOperation>)
+        return op(v, is...);
+    else
+        return op(v);
+}
+
+template <typename AccDataType, int MR, int NR, int VL>
+CK_HOST_ALWAYS_INLINE void host_gemm_micro_kernel(std::size_t kc,
+                                                  const AccDataType* __restrict__ p_a,
+                                                  const AccDataType* __restrict__ p_b,
+                                                  AccDataType* __restrict__ p_c,
+                                                  std::size_t ldc)
+{
+    static_assert(NR % VL == 0, "wrong! NR should be multiple of VL");
+
+    using vec_t = host_vector_t<AccDataType, VL>;
+
+    constexpr int NV = NR / VL;
+
+    vec_t c[MR][NV];
+
+    for(int i = 0; i < MR; ++i)
+        for(int j = 0; j < NV; ++j)
+            c[i][j] = host_vector_load<AccDataType, VL>(p_c + i * ldc + j * VL);
+
+    for(std::size_t k = 0; k < kc; ++k)
+    {
+        vec_t b[NV];
+
+        for(int j = 0; j < NV; ++j)
+            b[j] = host_vector_load<AccDataType, VL>(p_b + k * NR + j * VL);
+
+        for(int i = 0; i < MR; ++i)
+        {
+            const vec_t a = host_vector_broadcast<AccDataType, VL>(p_a[k * MR + i]);
+
+            for(int j = 0; j < NV; ++j)
+                c[i][j] += a * b[j];
+        }
+    }
+
+    for(int i = 0; i < MR; ++i)
+        for(int j = 0; j < NV; ++j)
+            host_vector_store<AccDataType, VL>(p_c + i * ldc + j * VL, c[i][j]);
+}
+
+template <typename AccDataType, HostSimdIsa_t Isa>
+struct HostGemmMicroKernel;
+
+template <typename AccDataType>
+struct HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Scalar>
+{
+    using PackDataType = AccDataType;
+
+    static constexpr int KP = 1;
+    static constexpr int VL = 16 / sizeof(AccDataType);
+    static constexpr int MR = 4;
+    static constexpr int NR = 2 * VL;
+
+    static void Run(std::size_t kc,
+                    const AccDataType* p_a,
+                    const AccDataType* p_b,
+                    AccDataType* p_c,
+                    std::size_t ldc)
+    {
+        host_gemm_micro_kernel<AccDataType, MR, NR, VL>(kc, p_a, p_b, p_c, ldc);
+    }
+};
+
+template <typename AccDataType>
+struct HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Avx2>
+{
+    using PackDataType = AccDataType;
+
+    static constexpr int KP = 1;
+    static constexpr int VL = 32 / sizeof(AccDataType);
+    static constexpr int MR = 6;
+    static constexpr int NR = 2 * VL;
+
+    CK_HOST_TARGET_AVX2 static void Run(std::size_t kc,
+                                        const AccDataType* p_a,
+                                        const AccDataType* p_b,
+                                        AccDataType* p_c,
+                                        std::size_t ldc)
+    {
+        host_gemm_micro_kernel<AccDataType, MR, NR, VL>(kc, p_a, p_b, p_c, ldc);
+    }
+};
+
+template <typename AccDataType>
+struct HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Avx512>
+{
+    using PackDataType = AccDataType;
+
+    static constexpr int KP = 1;
+    static constexpr int VL = 64 / sizeof(AccDataType);
+    static constexpr int MR = 8;
+    static constexpr int NR = 2 * VL;
+
+    CK_HOST_TARGET_AVX512 static void Run(std::size_t kc,
+                                          const AccDataType* p_a,
+                                          const AccDataType* p_b,
+                                          AccDataType* p_c,
+                                          std::size_t ldc)
+    {
+        host_gemm_micro_kernel<AccDataType, MR, NR, VL>(kc, p_a, p_b, p_c, ldc);
+    }
+};
+
+// C[MR, NR] += A * B on bf16 panels holding pairs of k, widened to fp32 in registers: the even k
+// of a 32-bit pair becomes a float when shifted up by 16 bits, the odd k when its low half is
+// masked off
+template <int MR, int NR, int VL>
+CK_HOST_ALWAYS_INLINE void host_gemm_bf16_micro_kernel(std::size_t kc,
+                                                       const ushort* __restrict__ p_a,
+                                                       const ushort* __restrict__ p_b,
+                                                       float* __restrict__ p_c,
+                                                       std::size_t ldc)
+{
+    static_assert(NR % VL == 0, "wrong! NR should be multiple of VL");
+
+    using vec_t  = host_vector_t<float, VL>;
+    using pair_t = host_vector_t<uint32_t, VL>;
+
+    constexpr int NV = NR / VL;
+
+    const pair_t odd_mask = host_vector_broadcast<uint32_t, VL>(0xffff0000);
+
+    vec_t c[MR][NV];
+
+    for(int i = 0; i < MR; ++i)
+        for(int j = 0; j < NV; ++j)
+            c[i][j] = host_vector_load<float, VL>(p_c + i * ldc + j * VL);
+
+    for(std::size_t k = 0; k < kc; k += 2)
+    {
+        vec_t b0[NV], b1[NV];
+
+        for(int j = 0; j < NV; ++j)
+        {
+            const pair_t b = host_vector_load<uint32_t, VL>(
+                reinterpret_cast<const uint32_t*>(p_b + k * NR) + j * VL);
+
+            b0[j] = (vec_t)(b << 16);
+            b1[j] = (vec_t)(b & odd_mask);
+        }
+
+        for(int i = 0; i < MR; ++i)
+        {
+            uint32_t a;
+            std::memcpy(&a, p_a + k * MR + 2 * i, sizeof(a));
+
+            const vec_t a0 = host_vector_broadcast<float, VL>(bf16_to_f32_(a & 0xffff));
+            const vec_t a1 = host_vector_broadcast<float, VL>(bf16_to_f32_(a >> 16));
+
+            for(int j = 0; j < NV; ++j)
+                c[i][j] += a0 * b0[j] + a1 * b1[j];
+        }
+    }
+
+    for(int i = 0; i < MR; ++i)
+        for(int j = 0; j < NV; ++j)
+            host_vector_store<float, VL>(p_c + i * ldc + j * VL, c[i][j]);
+}
+
+// micro-kernels on bf16 panels, UseDpBf16 selects vdpbf16ps on the Avx512 level
+template <HostSimdIsa_t Isa, bool UseDpBf16 = false>
+struct HostGemmBf16MicroKernel;
+
+template <>
+struct HostGemmBf16MicroKernel<HostSimdIsa_t::Scalar>
+{
+    using PackDataType = ushort;
+
+    static constexpr int KP = 2;
+    static constexpr int VL = 4;
+    static constexpr int MR = 4;
+    static constexpr int NR = 2 * VL;
+
+    static void
+    Run(std::size_t kc, const ushort* p_a, const ushort* p_b, float* p_c, std::size_t ldc)
+    {
+        host_gemm_bf16_micro_kernel<MR, NR, VL>(kc, p_a, p_b, p_c, ldc);
+    }
+};
+
+// MR is lower than for fp32, widening takes two registers per B vector
+template <>
+struct HostGemmBf16MicroKernel<HostSimdIsa_t::Avx2>
+{
+    using PackDataType = ushort;
+
+    static constexpr int KP = 2;
+    static constexpr int VL = 8;
+    static constexpr int MR = 4;
+    static constexpr int NR = 2 * VL;
+
+    CK_HOST_TARGET_AVX2 static void
+    Run(std::size_t kc, const ushort* p_a, const ushort* p_b, float* p_c, std::size_t ldc)
+    {
+        host_gemm_bf16_micro_kernel<MR, NR, VL>(kc, p_a, p_b, p_c, ldc);
+    }
+};
+
+template <>
+struct HostGemmBf16MicroKernel<HostSimdIsa_t::Avx512>
+{
+    using PackDataType = ushort;
+
+    static constexpr int KP = 2;
+    static constexpr int VL = 16;
+    static constexpr int MR = 8;
+    static constexpr int NR = 2 * VL;
+
+    CK_HOST_TARGET_AVX512 static void
+    Run(std::size_t kc, const ushort* p_a, const ushort* p_b, float* p_c, std::size_t ldc)
+    {
+        host_gemm_bf16_micro_kernel<MR, NR, VL>(kc, p_a, p_b, p_c, ldc);
+    }
+};
+
+#if CK_HOST_X86
+// vdpbf16ps multiplies and accumulates a pair of k per instruction, it treats bf16 subnormals as
+// zero
+template <>
+struct HostGemmBf16MicroKernel<HostSimdIsa_t::Avx512, true>
+{
+    using PackDataType = ushort;
+
+    static constexpr int KP = 2;
+    static constexpr int VL = 16;
+    static constexpr int MR = 8;
+    static constexpr int NR = 2 * VL;
+
+    CK_HOST_TARGET_AVX512_BF16 static void
+    Run(std::size_t kc, const ushort* p_a, const ushort* p_b, float* p_c, std::size_t ldc)
+    {
+        constexpr int NV = NR / VL;
+
+        __m512 c[MR][NV];
+
+        for(int i = 0; i < MR; ++i)
+            for(int j = 0; j < NV; ++j)
+                c[i][j] = _mm512_loadu_ps(p_c + i * ldc + j * VL);
+
+        for(std::size_t k = 0; k < kc; k += 2)
+        {
+            __m512bh b[NV];
+
+            for(int j = 0; j < NV; ++j)
+                b[j] = (__m512bh)_mm512_loadu_si512(p_b + k * NR + j * 2 * VL);
+
+            for(int i = 0; i < MR; ++i)
+            {
+                int a;
+                std::memcpy(&a, p_a + k * MR + 2 * i, sizeof(a));
+
+                const __m512bh a_pair = (__m512bh)_mm512_set1_epi32(a);
+
+                for(int j = 0; j < NV; ++j)
+                    c[i][j] = _mm512_dpbf16_ps(c[i][j], a_pair, b[j]);
+            }
+        }
+
+        for(int i = 0; i < MR; ++i)
+            for(int j = 0; j < NV; ++j)
+                _mm512_storeu_ps(p_c + i * ldc + j * VL, c[i][j]);
+    }
+};
+#endif
+
+// C[MR, NR] += A * B on int8 panels holding groups of four k, summed exactly in int32. The bytes of
+// a group are sign extended in registers with shifts
+template <int MR, int NR, int VL>
+CK_HOST_ALWAYS_INLINE void host_gemm_i8_micro_kernel(std::size_t kc,
+                                                     const int8_t* __restrict__ p_a,
+                                                     const int8_t* __restrict__ p_b,
+                                                     int32_t* __restrict__ p_c,
+                                                     std::size_t ldc)
+{
+    static_assert(NR % VL == 0, "wrong! NR should be multiple of VL");
+
+    using vec_t  = host_vector_t<int32_t, VL>;
+    using uvec_t = host_vector_t<uint32_t, VL>;
+
+    constexpr int NV = NR / VL;
+
+    vec_t c[MR][NV];
+
+    for(int i = 0; i < MR; ++i)
+        for(int j = 0; j < NV; ++j)
+            c[i][j] = host_vector_load<int32_t, VL>(p_c + i * ldc + j * VL);
+
+    for(std::size_t k = 0; k < kc; k += 4)
+    {
+        vec_t b[4][NV];
+
+        for(int j = 0; j < NV; ++j)
+        {
+            const uvec_t q = host_vector_load<uint32_t, VL>(
+                reinterpret_cast<const uint32_t*>(p_b + k * NR) + j * VL);
+
+            for(int t = 0; t < 4; ++t)
+                b[t][j] = (vec_t)(q << (24 - 8 * t)) >> 24;
+        }
+
+        for(int i = 0; i < MR; ++i)
+            for(int t = 0; t < 4; ++t)
+            {
+                const vec_t a = host_vector_broadcast<int32_t, VL>(p_a[k * MR + 4 * i + t]);
+
+                for(int j = 0; j < NV; ++j)
+                    c[i][j] += a * b[t][j];
+            }
+    }
+
+    for(int i = 0; i < MR; ++i)
+        for(int j = 0; j < NV; ++j)
+            host_vector_store<int32_t, VL>(p_c + i * ldc + j * VL, c[i][j]);
+}
+
+// micro-kernels on int8 panels, UseVnni selects vpdpbusd (AVX-VNNI on the Avx2 level, AVX-512 VNNI
+// on the Avx512 level). Without it, the 16-bit halves of every group are sign extended apart and
+// multiplied with vpmaddwd; vpmaddubsw would saturate its 16-bit sums of products.
+template <HostSimdIsa_t Isa, bool UseVnni = false>
+struct HostGemmI8MicroKernel;
+
+template <>
+struct HostGemmI8MicroKernel<HostSimdIsa_t::Scalar>
+{
+    using PackDataType = int8_t;
+
+    static constexpr int KP = 4;
+    static constexpr int VL = 4;
+    static constexpr int MR = 4;
+    static constexpr int NR = 2 * VL;
+
+    static void
+    Run(std::size_t kc, const int8_t* p_a, const int8_t* p_b, int32_t* p_c, std::size_t ldc)
+    {
+        host_gemm_i8_micro_kernel<MR, NR, VL>(kc, p_a, p_b, p_c, ldc);
+    }
+};
+
+#if CK_HOST_X86
+template <>
+struct HostGemmI8MicroKernel<HostSimdIsa_t::Avx2>
+{
+    using PackDataType = int8_t;
+
+    static constexpr int KP = 4;
+    static constexpr int VL = 8;
+    static constexpr int MR = 4;
+    static constexpr int NR = 2 * VL;
+
+    CK_HOST_TARGET_AVX2 static void
+    Run(std::size_t kc, const int8_t* p_a, const int8_t* p_b, int32_t* p_c, std::size_t ldc)
+    {
+        constexpr int NV = NR / VL;
+
+        __m256i c[MR][NV];
+
+        for(int i = 0; i < MR; ++i)
+            for(int j = 0; j < NV; ++j)
+                c[i][j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_c + i * ldc) + j);
+
+        for(std::size_t k = 0; k < kc; k += 4)
+        {
+            // 16-bit lanes hold bytes (k, k + 1) and (k + 2, k + 3) of a group
+            __m256i b_even[NV], b_odd[NV];
+
+            for(int j = 0; j < NV; ++j)
+            {
+                const __m256i b =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_b + k * NR) + j);
+
+                b_even[j] = _mm256_srai_epi16(_mm256_slli_epi16(b, 8), 8);
+                b_odd[j]  = _mm256_srai_epi16(b, 8);
+            }
+
+            for(int i = 0; i < MR; ++i)
+            {
+                int a;
+                std::memcpy(&a, p_a + k * MR + 4 * i, sizeof(a));
+
+                const __m256i a_group = _mm256_set1_epi32(a);
+                const __m256i a_even  = _mm256_srai_epi16(_mm256_slli_epi16(a_group, 8), 8);
+                const __m256i a_odd   = _mm256_srai_epi16(a_group, 8);
+
+                for(int j = 0; j < NV; ++j)
+                    c[i][j] = _mm256_add_epi32(
+                        c[i][j],
+                        _mm256_add_epi32(_mm256_madd_epi16(a_even, b_even[j]),
+                                         _mm256_madd_epi16(a_odd, b_odd[j])));
+            }
+        }
+
+        for(int i = 0; i < MR; ++i)
+            for(int j = 0; j < NV; ++j)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_c + i * ldc) + j, c[i][j]);
+    }
+};
+
+// vpdpbusd multiplies unsigned by signed bytes: A is biased by 128 to make it unsigned, the bias
+// times the column sums of B is subtracted again when the tile is stored
+template <>
+struct HostGemmI8MicroKernel<HostSimdIsa_t::Avx2, true>
+{
+    using PackDataType = int8_t;
+
+    static constexpr int KP = 4;
+    static constexpr int VL = 8;
+    static constexpr int MR = 4;
+    static constexpr int NR = 2 * VL;
+
+    CK_HOST_TARGET_AVX_VNNI static void
+    Run(std::size_t kc, const int8_t* p_a, const int8_t* p_b, int32_t* p_c, std::size_t ldc)
+    {
+        constexpr int NV   = NR / VL;
+        constexpr int Bias = static_cast<int>(0x80808080u);
+
+        const __m256i bias = _mm256_set1_epi32(Bias);
+
+        __m256i c[MR][NV], comp[NV];
+
+        for(int i = 0; i < MR; ++i)
+            for(int j = 0; j < NV; ++j)
+                c[i][j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_c + i * ldc) + j);
+
+        for(int j = 0; j < NV; ++j)
+            comp[j] = _mm256_setzero_si256();
+
+        for(std::size_t k = 0; k < kc; k += 4)
+        {
+            __m256i b[NV];
+
+            for(int j = 0; j < NV; ++j)
+            {
+                b[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_b + k * NR) + j);
+
+                comp[j] = _mm256_dpbusd_avx_epi32(comp[j], bias, b[j]);
+            }
+
+            for(int i = 0; i < MR; ++i)
+            {
+                int a;
+                std::memcpy(&a, p_a + k * MR + 4 * i, sizeof(a));
+
+                const __m256i a_u8 = _mm256_set1_epi32(a ^ Bias);
+
+                for(int j = 0; j < NV; ++j)
+                    c[i][j] = _mm256_dpbusd_avx_epi32(c[i][j], a_u8, b[j]);
+            }
+        }
+
+        for(int i = 0; i < MR; ++i)
+            for(int j = 0; j < NV; ++j)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_c + i * ldc) + j,
+                                    _mm256_sub_epi32(c[i][j], comp[j]));
+    }
+};
+
+template <>
+struct HostGemmI8MicroKernel<HostSimdIsa_t::Avx512>
+{
+    using PackDataType = int8_t;
+
+    static constexpr int KP = 4;
+    static constexpr int VL = 16;
+    static constexpr int MR = 8;
+    static constexpr int NR = 2 * VL;
+
+    CK_HOST_TARGET_AVX512 static void
+    Run(std::size_t kc, const int8_t* p_a, const int8_t* p_b, int32_t* p_c, std::size_t ldc)
+    {
+        constexpr int NV = NR / VL;
+
+        __m512i c[MR][NV];
+
+        for(int i = 0; i < MR; ++i)
+            for(int j = 0; j < NV; ++j)
+                c[i][j] = _mm512_loadu_si512(p_c + i * ldc + j * VL);
+
+        for(std::size_t k = 0; k < kc; k += 4)
+        {
+            __m512i b_even[NV], b_odd[NV];
+
+            for(int j = 0; j < NV; ++j)
+            {
+                const __m512i b = _mm512_loadu_si512(p_b + k * NR + j * 4 * VL);
+
+                b_even[j] = _mm512_srai_epi16(_mm512_slli_epi16(b, 8), 8);
+                b_odd[j]  = _mm512_srai_epi16(b, 8);
+            }
+
+            for(int i = 0; i < MR; ++i)
+            {
+                int a;
+                std::memcpy(&a, p_a + k * MR + 4 * i, sizeof(a));
+
+                const __m512i a_group = _mm512_set1_epi32(a);
+                const __m512i a_even  = _mm512_srai_epi16(_mm512_slli_epi16(a_group, 8), 8);
+                const __m512i a_odd   = _mm512_srai_epi16(a_group, 8);
+
+                for(int j = 0; j < NV; ++j)
+                    c[i][j] = _mm512_add_epi32(
+                        c[i][j],
+                        _mm512_add_epi32(_mm512_madd_epi16(a_even, b_even[j]),
+                                         _mm512_madd_epi16(a_odd, b_odd[j])));
+            }
+        }
+
+        for(int i = 0; i < MR; ++i)
+            for(int j = 0; j < NV; ++j)
+                _mm512_storeu_si512(p_c + i * ldc + j * VL, c[i][j]);
+    }
+};
+
+template <>
+struct HostGemmI8MicroKernel<HostSimdIsa_t::Avx512, true>
+{
+    using PackDataType = int8_t;
+
+    static constexpr int KP = 4;
+    static constexpr int VL = 16;
+    static constexpr int MR = 8;
+    static constexpr int NR = 2 * VL;
+
+    CK_HOST_TARGET_AVX512_VNNI static void
+    Run(std::size_t kc, const int8_t* p_a, const int8_t* p_b, int32_t* p_c, std::size_t ldc)
+    {
+        constexpr int NV   = NR / VL;
+        constexpr int Bias = static_cast<int>(0x80808080u);
+
+        const __m512i bias = _mm512_set1_epi32(Bias);
+
+        __m512i c[MR][NV], comp[NV];
+
+        for(int i = 0; i < MR; ++i)
+            for(int j = 0; j < NV; ++j)
+                c[i][j] = _mm512_loadu_si512(p_c + i * ldc + j * VL);
+
+        for(int j = 0; j < NV; ++j)
+            comp[j] = _mm512_setzero_si512();
+
+        for(std::size_t k = 0; k < kc; k += 4)
+        {
+            __m512i b[NV];
+
+            for(int j = 0; j < NV; ++j)
+            {
+                b[j] = _mm512_loadu_si512(p_b + k * NR + j * 4 * VL);
+
+                comp[j] = _mm512_dpbusd_epi32(comp[j], bias, b[j]);
+            }
+
+            for(int i = 0; i < MR; ++i)
+            {
+                int a;
+                std::memcpy(&a, p_a + k * MR + 4 * i, sizeof(a));
+
+                const __m512i a_u8 = _mm512_set1_epi32(a ^ Bias);
+
+                for(int j = 0; j < NV; ++j)
+                    c[i][j] = _mm512_dpbusd_epi32(c[i][j], a_u8, b[j]);
+            }
+        }
+
+        for(int i = 0; i < MR; ++i)
+            for(int j = 0; j < NV; ++j)
+                _mm512_storeu_si512(p_c + i * ldc + j * VL, _mm512_sub_epi32(c[i][j], comp[j]));
+    }
+};
+#endif
+
+// pack a [mc, kc] block of A into MR-row panels of KP-element groups of k: panel p holds
+// A[p * MR + i, k] at (k / KP * MR + i) * KP + k % KP, k is zero padded to a multiple of KP
+template <int MR,
+          int KP,
+          typename PackDataType,
+          typename ADataType,
+          typename AElementwiseOperation>
+void host_gemm_pack_a(PackDataType* p_pack,
+                      const ADataType* p_a,
+                      std::size_t stride_m,
+                      std::size_t stride_k,
+                      std::size_t mc,
+                      std::size_t kc,
+                      const AElementwiseOperation& a_element_op)
+{
+    const std::size_t mc_pad = (mc + MR - 1) / MR * MR;
+    const std::size_t kc_pad = (kc + KP - 1) / KP * KP;
+
+    auto f_offset = [](std::size_t i, std::size_t k) { return (k / KP * MR + i) * KP + k % KP; };
+
+    for(std::size_t ir = 0; ir < mc_pad; ir += MR)
+    {
+        PackDataType* p_panel = p_pack + ir * kc_pad;
+
+        const std::size_t mr = std::min<std::size_t>(MR, mc - std::min(mc, ir));
+
+        if(stride_k <= stride_m)
+        {
+            for(std::size_t i = 0; i < mr; ++i)
+            {
+                const ADataType* p_row = p_a + (ir + i) * stride_m;
+
+                if constexpr(KP == 1)
+                {
+                    host_convert_elementwise(p_panel + i, MR, p_row, stride_k, kc, a_element_op);
+                }
+                else
+                {
+                    // convert the row in one run, then deal its groups of k out to the panel
+                    thread_local std::vector<PackDataType> row;
+
+                    row.resize(kc);
+
+                    host_convert_elementwise(row.data(), 1, p_row, stride_k, kc, a_element_op);
+
+                    for(std::size_t k = 0; k < kc; ++k)
+                        p_panel[f_offset(i, k)] = row[k];
+                }
+            }
+        }
+        else
+        {
+            for(std::size_t k = 0; k < kc; ++k)
+                host_convert_elementwise(p_panel + f_offset(0, k),
+                                         KP,
+                                         p_a + ir * stride_m + k * stride_k,
+                                         stride_m,
+                                         mr,
+                                         a_element_op);
+        }
+
+        for(std::size_t k = 0; k < kc_pad; ++k)
+            for(std::size_t i = k < kc ? mr : 0; i < MR; ++i)
+                p_panel[f_offset(i, k)] = PackDataType{0};
+    }
+}
+
+// pack a [kc, nc] block of B into NR-column panels of KP-element groups of k: panel p holds
+// B[k, p * NR + j] at (k / KP * NR + j) * KP + k % KP, k is zero padded to a multiple of KP
+template <int NR,
+          int KP,
+          typename PackDataType,
+          typename BDataType,
+          typename BElementwiseOperation>
+void host_gemm_pack_b(PackDataType* p_pack,
+                      const BDataType* p_b,
+                      std::size_t stride_k,
+                      std::size_t stride_n,
+                      std::size_t kc,
+                      std::size_t nc,
+                      const BElementwiseOperation& b_element_op)
+{
+    const std::size_t nc_pad = (nc + NR - 1) / NR * NR;
+    const std::size_t kc_pad = (kc + KP - 1) / KP * KP;
+
+    auto f_offset = [](std::size_t j, std::size_t k) { return (k / KP * NR + j) * KP + k % KP; };
+
+    for(std::size_t jr = 0; jr < nc_pad; jr += NR)
+    {
+        PackDataType* p_panel = p_pack + jr * kc_pad;
+
+        const std::size_t nr = std::min<std::size_t>(NR, nc - std::min(nc, jr));
+
+        if(stride_n <= stride_k)
+        {
+            for(std::size_t k = 0; k < kc; ++k)
+                host_convert_elementwise(p_panel + f_offset(0, k),
+                                         KP,
+                                         p_b + k * stride_k + jr * stride_n,
+                                         stride_n,
+                                         nr,
+                                         b_element_op);
+        }
+        else
+        {
+            for(std::size_t j = 0; j < nr; ++j)
+            {
+                const BDataType* p_col = p_b + (jr + j) * stride_n;
+
+                if constexpr(KP == 1)
+                {
+                    host_convert_elementwise(p_panel + j, NR, p_col, stride_k, kc, b_element_op);
+                }
+                else
+                {
+                    // convert the column in one run, then deal its groups of k out to the panel
+                    thread_local std::vector<PackDataType> col;
+
+                    col.resize(kc);
+
+                    host_convert_elementwise(col.data(), 1, p_col, stride_k, kc, b_element_op);
+
+                    for(std::size_t k = 0; k < kc; ++k)
+                        p_panel[f_offset(j, k)] = col[k];
+                }
+            }
+        }
+
+        for(std::size_t k = 0; k < kc_pad; ++k)
+            for(std::size_t j = k < kc ? nr : 0; j < NR; ++j)
+                p_panel[f_offset(j, k)] = PackDataType{0};
+    }
+}
+
+template <typename MicroKernel,
+          typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CElementwiseOperation>
+void host_gemm_blocked_impl(std::size_t G,
+                            std::size_t M,
+                            std::size_t N,
+                            std::size_t K,
+                            const ADataType* p_a,
+                            std::size_t a_stride_g,
+                            std::size_t a_stride_m,
+                            std::size_t a_stride_k,
+                            const BDataType* p_b,
+                            std::size_t b_stride_g,
+                            std::size_t b_stride_k,
+                            std::size_t b_stride_n,
+                            CDataType* p_c,
+                            std::size_t c_stride_g,
+                            std::size_t c_stride_m,
+                            std::size_t c_stride_n,
+                            const AElementwiseOperation& a_element_op,
+                            const BElementwiseOperation& b_element_op,
+                            const CElementwiseOperation& c_element_op,
+                            HostGemmBlocking blocking,
+                            std::size_t num_thread)
+{
+    using PackDataType = typename MicroKernel::PackDataType;
+
+    constexpr std::size_t MR = MicroKernel::MR;
+    constexpr std::size_t NR = MicroKernel::NR;
+    constexpr std::size_t KP = MicroKernel::KP;
+
+    num_thread = std::max<std::size_t>(num_thread, 1);
+
+    std::size_t MC = std::max(blocking.MC / MR, std::size_t{1}) * MR;
+    std::size_t NC = std::max(blocking.NC / NR, std::size_t{1}) * NR;
+    std::size_t KC = std::max(blocking.KC / KP, std::size_t{1}) * KP;
+
+    MC = std::min(MC, (M + MR - 1) / MR * MR);
+    NC = std::min(NC, (N + NR - 1) / NR * NR);
+
+    // shrink the M block until every thread has a C tile to work on
+    while(MC > MR && G * ((M + MC - 1) / MC) * ((N + NC - 1) / NC) < num_thread)
+    {
+        MC = std::max((MC / 2) / MR, std::size_t{1}) * MR;
+    }
+
+    const std::size_t num_mc = (M + MC - 1) / MC;
+    const std::size_t num_nc = (N + NC - 1) / NC;
+
+    auto f_tile = [&](std::size_t g, std::size_t im, std::size_t in) {
+        thread_local std::vector<PackDataType> a_pack, b_pack;
+        thread_local std::vector<AccDataType> c_tile;
+
+        const ADataType* p_a_g = p_a + g * a_stride_g;
+        const BDataType* p_b_g = p_b + g * b_stride_g;
+        CDataType* p_c_g       = p_c + g * c_stride_g;
+
+        const std::size_t m0 = im * MC;
+        const std::size_t n0 = in * NC;
+        const std::size_t mc = std::min(MC, M - m0);
+        const std::size_t nc = std::min(NC, N - n0);
+
+        const std::size_t mc_pad = (mc + MR - 1) / MR * MR;
+        const std::size_t nc_pad = (nc + NR - 1) / NR * NR;
+
+        c_tile.assign(mc_pad * nc_pad, AccDataType{0});
+
+        for(std::size_t k0 = 0; k0 < K; k0 += KC)
+        {
+            const std::size_t kc     = std::min(KC, K - k0);
+            const std::size_t kc_pad = (kc + KP - 1) / KP * KP;
+
+            a_pack.resize(mc_pad * kc_pad);
+            b_pack.resize(nc_pad * kc_pad);
+
+            host_gemm_pack_a<MR, KP>(a_pack.data(),
+                                     p_a_g + m0 * a_stride_m + k0 * a_stride_k,
+                                     a_stride_m,
+                                     a_stride_k,
+                                     mc,
+                                     kc,
+                                     a_element_op);
+
+            host_gemm_pack_b<NR, KP>(b_pack.data(),
+                                     p_b_g + k0 * b_stride_k + n0 * b_stride_n,
+                                     b_stride_k,
+                                     b_stride_n,
+                                     kc,
+                                     nc,
+                                     b_element_op);
+
+            for(std::size_t jr = 0; jr < nc_pad; jr += NR)
+            {
+                for(std::size_t ir = 0; ir < mc_pad; ir += MR)
+                {
+                    MicroKernel::Run(kc_pad,
+                                     a_pack.data() + ir * kc_pad,
+                                     b_pack.data() + jr * kc_pad,
+                                     c_tile.data() + ir * nc_pad + jr,
+                                     nc_pad);
+                }
+            }
+        }
+
+        for(std::size_t i = 0; i < mc; ++i)
+        {
+            CDataType* p_c_row = p_c_g + (m0 + i) * c_stride_m + n0 * c_stride_n;
+
+            for(std::size_t j = 0; j < nc; ++j)
+            {
+                const auto c = host_apply_elementwise_operation(
+                    c_element_op, c_tile[i * nc_pad + j], m0 + i, n0 + j);
+
+                p_c_row[j * c_stride_n] = host_type_convert<CDataType>(c);
+            }
+        }
+    };
+
+    if(G * num_mc * num_nc > 0)
+    {
+        // one C tile per work item. Batches of small matrices, one tile each, are handed out in
+        // chunks picked by the pool instead
+        const std::size_t grain_size = num_mc * num_nc == 1 && G > num_thread ? 0 : 1;
+
+        make_ParallelTensorFunctor(f_tile, G, num_mc, num_nc)(num_thread, grain_size);
+    }
+}
+
+// bf16 A and B, fp32 accumulation, on bf16 panels
+template <typename CDataType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CElementwiseOperation>
+void host_gemm_blocked_bf16(std::size_t G,
+                            std::size_t M,
+                            std::size_t N,
+                            std::size_t K,
+                            const ushort* p_a,
+                            std::size_t a_stride_g,
+                            std::size_t a_stride_m,
+                            std::size_t a_stride_k,
+                            const ushort* p_b,
+                            std::size_t b_stride_g,
+                            std::size_t b_stride_k,
+                            std::size_t b_stride_n,
+                            CDataType* p_c,
+                            std::size_t c_stride_g,
+                            std::size_t c_stride_m,
+                            std::size_t c_stride_n,
+                            const AElementwiseOperation& a_element_op,
+                            const BElementwiseOperation& b_element_op,
+                            const CElementwiseOperation& c_element_op,
+                            HostGemmBlocking blocking,
+                            std::size_t num_thread,
+                            HostSimdIsa_t isa)
+{
+    auto f_run = [&](auto micro_kernel) {
+        host_gemm_blocked_impl<decltype(micro_kernel), float>(G,
+                                                              M,
+                                                              N,
+                                                              K,
+                                                              p_a,
+                                                              a_stride_g,
+                                                              a_stride_m,
+                                                              a_stride_k,
+                                                              p_b,
+                                                              b_stride_g,
+                                                              b_stride_k,
+                                                              b_stride_n,
+                                                              p_c,
+                                                              c_stride_g,
+                                                              c_stride_m,
+                                                              c_stride_n,
+                                                              a_element_op,
+                                                              b_element_op,
+                                                              c_element_op,
+                                                              blocking,
+                                                              num_thread);
+    };
+
+    switch(std::min(isa, get_host_simd_isa()))
+    {
+    case HostSimdIsa_t::Avx512:
+#if CK_HOST_X86
+        if(get_host_simd_has_avx512_bf16())
+        {
+            f_run(HostGemmBf16MicroKernel<HostSimdIsa_t::Avx512, true>{});
+            break;
+        }
+#endif
+        f_run(HostGemmBf16MicroKernel<HostSimdIsa_t::Avx512>{});
+        break;
+    case HostSimdIsa_t::Avx2: f_run(HostGemmBf16MicroKernel<HostSimdIsa_t::Avx2>{}); break;
+    default: f_run(HostGemmBf16MicroKernel<HostSimdIsa_t::Scalar>{});
+    }
+}
+
+// int8 A and B, int32 accumulation, on int8 panels
+template <typename CDataType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CElementwiseOperation>
+void host_gemm_blocked_i8(std::size_t G,
+                          std::size_t M,
+                          std::size_t N,
+                          std::size_t K,
+                          const int8_t* p_a,
+                          std::size_t a_stride_g,
+                          std::size_t a_stride_m,
+                          std::size_t a_stride_k,
+                          const int8_t* p_b,
+                          std::size_t b_stride_g,
+                          std::size_t b_stride_k,
+                          std::size_t b_stride_n,
+                          CDataType* p_c,
+                          std::size_t c_stride_g,
+                          std::size_t c_stride_m,
+                          std::size_t c_stride_n,
+                          const AElementwiseOperation& a_element_op,
+                          const BElementwiseOperation& b_element_op,
+                          const CElementwiseOperation& c_element_op,
+                          HostGemmBlocking blocking,
+                          std::size_t num_thread,
+                          HostSimdIsa_t isa)
+{
+    auto f_run = [&](auto micro_kernel) {
+        host_gemm_blocked_impl<decltype(micro_kernel), int32_t>(G,
+                                                                M,
+                                                                N,
+                                                                K,
+                                                                p_a,
+                                                                a_stride_g,
+                                                                a_stride_m,
+                                                                a_stride_k,
+                                                                p_b,
+                                                                b_stride_g,
+                                                                b_stride_k,
+                                                                b_stride_n,
+                                                                p_c,
+                                                                c_stride_g,
+                                                                c_stride_m,
+                                                                c_stride_n,
+                                                                a_element_op,
+                                                                b_element_op,
+                                                                c_element_op,
+                                                                blocking,
+                                                                num_thread);
+    };
+
+    switch(std::min(isa, get_host_simd_isa()))
+    {
+#if CK_HOST_X86
+    case HostSimdIsa_t::Avx512:
+        if(get_host_simd_has_avx512_vnni())
+            f_run(HostGemmI8MicroKernel<HostSimdIsa_t::Avx512, true>{});
+        else
+            f_run(HostGemmI8MicroKernel<HostSimdIsa_t::Avx512>{});
+        break;
+    case HostSimdIsa_t::Avx2:
+        if(get_host_simd_has_avx_vnni())
+            f_run(HostGemmI8MicroKernel<HostSimdIsa_t::Avx2, true>{});
+        else
+            f_run(HostGemmI8MicroKernel<HostSimdIsa_t::Avx2>{});
+        break;
+#endif
+    default: f_run(HostGemmI8MicroKernel<HostSimdIsa_t::Scalar>{});
+    }
+}
+
+// G GEMMs on matrices g * stride_g elements apart, strides 0 share an operand across the batch.
+// Work items are C tiles of all the GEMMs, so a batch of small matrices keeps every thread busy
+// with one GEMM per tile, whose A and B are packed whole into contiguous panels.
+template <typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CElementwiseOperation>
+void host_batched_gemm_blocked(std::size_t G,
+                               std::size_t M,
+                               std::size_t N,
+                               std::size_t K,
+                               const ADataType* p_a,
+                               std::size_t a_stride_g,
+                               std::size_t a_stride_m,
+                               std::size_t a_stride_k,
+                               const BDataType* p_b,
+                               std::size_t b_stride_g,
+                               std::size_t b_stride_k,
+                               std::size_t b_stride_n,
+                               CDataType* p_c,
+                               std::size_t c_stride_g,
+                               std::size_t c_stride_m,
+                               std::size_t c_stride_n,
+                               const AElementwiseOperation& a_element_op,
+                               const BElementwiseOperation& b_element_op,
+                               const CElementwiseOperation& c_element_op,
+                               HostGemmBlocking blocking = HostGemmBlocking{},
+                               std::size_t num_thread    = get_host_num_threads(),
+                               HostSimdIsa_t isa         = get_host_simd_isa())
+{
+    static_assert(std::is_same<AccDataType, float>::value ||
+                      std::is_same<AccDataType, double>::value ||
+                      (std::is_same<AccDataType, int32_t>::value &&
+                       is_host_gemm_int8<ADataType, BDataType>),
+                  "wrong! host GEMM accumulates in float or double, int8 A and B in int32");
+
+    if constexpr(std::is_same<AccDataType, int32_t>::value)
+    {
+        host_gemm_blocked_i8(G,
+                             M,
+                             N,
+                             K,
+                             p_a,
+                             a_stride_g,
+                             a_stride_m,
+                             a_stride_k,
+                             p_b,
+                             b_stride_g,
+                             b_stride_k,
+                             b_stride_n,
+                             p_c,
+                             c_stride_g,
+                             c_stride_m,
+                             c_stride_n,
+                             a_element_op,
+                             b_element_op,
+                             c_element_op,
+                             blocking,
+                             num_thread,
+                             isa);
+    }
+    else if constexpr(std::is_same<ADataType, ushort>::value &&
+                      std::is_same<BDataType, ushort>::value &&
+                      std::is_same<AccDataType, float>::value)
+    {
+        host_gemm_blocked_bf16(G,
+                               M,
+                               N,
+                               K,
+                               p_a,
+                               a_stride_g,
+                               a_stride_m,
+                               a_stride_k,
+                               p_b,
+                               b_stride_g,
+                               b_stride_k,
+                               b_stride_n,
+                               p_c,
+                               c_stride_g,
+                               c_stride_m,
+                               c_stride_n,
+                               a_element_op,
+                               b_element_op,
+                               c_element_op,
+                               blocking,
+                               num_thread,
+                               isa);
+    }
+    else
+    {
+        // an ISA the host does not support falls back to the best one it does
+        switch(std::min(isa, get_host_simd_isa()))
+        {
+        case HostSimdIsa_t::Avx512:
+            host_gemm_blocked_impl<HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Avx512>,
+                                   AccDataType>(G,
+                                                M,
+                                                N,
+                                                K,
+                                                p_a,
+                                                a_stride_g,
+                                                a_stride_m,
+                                                a_stride_k,
+                                                p_b,
+                                                b_stride_g,
+                                                b_stride_k,
+                                                b_stride_n,
+                                                p_c,
+                                                c_stride_g,
+                                                c_stride_m,
+                                                c_stride_n,
+                                                a_element_op,
+                                                b_element_op,
+                                                c_element_op,
+                                                blocking,
+                                                num_thread);
+            break;
+        case HostSimdIsa_t::Avx2:
+            host_gemm_blocked_impl<HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Avx2>,
+                                   AccDataType>(G,
+                                                M,
+                                                N,
+                                                K,
+                                                p_a,
+                                                a_stride_g,
+                                                a_stride_m,
+                                                a_stride_k,
+                                                p_b,
+                                                b_stride_g,
+                                                b_stride_k,
+                                                b_stride_n,
+                                                p_c,
+                                                c_stride_g,
+                                                c_stride_m,
+                                                c_stride_n,
+                                                a_element_op,
+                                                b_element_op,
+                                                c_element_op,
+                                                blocking,
+                                                num_thread);
+            break;
+        default:
+            host_gemm_blocked_impl<HostGemmMicroKernel<AccDataType, HostSimdIsa_t::Scalar>,
+                                   AccDataType>(G,
+                                                M,
+                                                N,
+                                                K,
+                                                p_a,
+                                                a_stride_g,
+                                                a_stride_m,
+                                                a_stride_k,
+                                                p_b,
+                                                b_stride_g,
+                                                b_stride_k,
+                                                b_stride_n,
+                                                p_c,
+                                                c_stride_g,
+                                                c_stride_m,
+                                                c_stride_n,
+                                                a_element_op,
+                                                b_element_op,
+                                                c_element_op,
+                                                blocking,
+                                                num_thread);
+        }
+    }
+}
+
+// single GEMM
+template <typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CElementwiseOperation>
+void host_gemm_blocked(std::size_t M,
+                       std::size_t N,
+                       std::size_t K,
+                       const ADataType* p_a,
+                       std::size_t a_stride_m,
+                       std::size_t a_stride_k,
+                       const BDataType* p_b,
+                       std::size_t b_stride_k,
+                       std::size_t b_stride_n,
+                       CDataType* p_c,
+                       std::size_t c_stride_m,
+                       std::size_t c_stride_n,
+                       const AElementwiseOperation& a_element_op,
+                       const BElementwiseOperation& b_element_op,
+                       const CElementwiseOperation& c_element_op,
+                       HostGemmBlocking blocking = HostGemmBlocking{},
+                       std::size_t num_thread    = get_host_num_threads(),
+                       HostSimdIsa_t isa         = get_host_simd_isa())
+{
+    host_batched_gemm_blocked<AccDataType>(1,
+                                           M,
+                                           N,
+                                           K,
+                                           p_a,
+                                           0,
+                                           a_stride_m,
+                                           a_stride_k,
+                                           p_b,
+                                           0,
+                                           b_stride_k,
+                                           b_stride_n,
+                                           p_c,
+                                           0,
+                                           c_stride_m,
+                                           c_stride_n,
+                                           a_element_op,
+                                           b_element_op,
+                                           c_element_op,
+                                           blocking,
+                                           num_thread,
+                                           isa);
+}
+
+#endif
@@ -0,0 +1,766 @@
+#ifndef HOST_REDUCTION_HPP
+#define HOST_REDUCTION_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include "reduction_enums.hpp"
+#include "host_tensor.hpp"
+#include "host_simd.hpp"
+#include "host_tensor_convert.hpp"
+
+// Host generic tensor reduction, the counterpart of the gridwise_generic_reduction kernels:
+//   out[i] = alpha * post_op(reduce_r pre_op(in[i, r])) + beta * out[i]
+// for any split of the dimensions of in into invariant dimensions i and to-reduce dimensions r.
+// pre_op is |x| for NORM1 / AMAX and x * x for NORM2, post_op divides by the reduce length for AVG
+// and takes the square root for NORM2. MIN / MAX / AMAX can also return the flattened index, in
+// the to-reduce dimensions, of the first element holding the result. With PROPAGATE_NAN a NaN
+// replaces the accumulator and records its index, otherwise MIN / MAX / AMAX skip NaNs.
+//
+// out holds the invariant dimensions in order, either alone (a single element when all
+// dimensions are reduced) or together with the reduced dimensions at length 1. indices has the
+// lengths of out.
+//
+// When the innermost invariant dimension is contiguous and the to-reduce ones are not, blocks of
+// adjacent outputs are reduced element-wise across the inputs. Otherwise each output reduces its
+// runs of contiguous inputs in several vector lanes. Long reductions with few outputs are split
+// in two passes like first_call / second_call: the first reduces slices of the reduce range into
+// a workspace of partial values and indices, the second reduces the partials and applies post_op.
+
+template <ck::IndicesType_t IndicesType>
+struct HostReduceIndicesType;
+
+template <>
+struct HostReduceIndicesType<ck::IndicesType_t::INDICES_8BIT>
+{
+    using type = int8_t;
+};
+
+template <>
+struct HostReduceIndicesType<ck::IndicesType_t::INDICES_16BIT>
+{
+    using type = int16_t;
+};
+
+template <>
+struct HostReduceIndicesType<ck::IndicesType_t::INDICES_32BIT>
+{
+    using type = int32_t;
+};
+
+template <>
+struct HostReduceIndicesType<ck::IndicesType_t::INDICES_64BIT>
+{
+    using type = int64_t;
+};
+
+struct HostReduceProblem
+{
+    // dimensions of in, in increasing order
+    std::vector<std::size_t> InvariantDims;
+    std::vector<std::size_t> ReduceDims;
+
+    std::vector<std::size_t> InvariantLengths;
+    std::vector<std::size_t> InvariantInStrides;
+    std::vector<std::size_t> ReduceLengths;
+    std::vector<std::size_t> ReduceInStrides;
+
+    // rank of out (and indices)
+    std::size_t OutNumDimension = 0;
+
+    std::size_t GetInvariantLength() const
+    {
+        return std::accumulate(InvariantLengths.begin(),
+                               InvariantLengths.end(),
+                               std::size_t{1},
+                               std::multiplies<std::size_t>());
+    }
+
+    std::size_t GetReduceLength() const
+    {
+        return std::accumulate(ReduceLengths.begin(),
+                               ReduceLengths.end(),
+                               std::size_t{1},
+                               std::multiplies<std::size_t>());
+    }
+
+    // strides of out (or indices) along the invariant dimensions
+    std::vector<std::size_t> GetInvariantStrides(const HostTensorDescriptor& desc) const
+    {
+        const auto& lengths = desc.GetLengths();
+        const auto& strides = desc.GetStrides();
+
+        if(desc.GetNumOfDimension() != OutNumDimension)
+            throw std::runtime_error("wrong! inconsistent host reduction out dimensions");
+
+        std::vector<std::size_t> invariant_strides(InvariantDims.size());
+
+        if(OutNumDimension == InvariantDims.size() + ReduceDims.size())
+        {
+            for(auto d : ReduceDims)
+                if(lengths[d] != 1)
+                    throw std::runtime_error("wrong! reduced dimensions of out should be 1");
+
+            for(std::size_t i = 0; i < InvariantDims.size(); ++i)
+            {
+                if(lengths[InvariantDims[i]] != InvariantLengths[i])
+                    throw std::runtime_error("wrong! inconsistent host reduction out lengths");
+
+                invariant_strides[i] = strides[InvariantDims[i]];
+            }
+        }
+        else if(InvariantDims.empty())
+        {
+            if(desc.GetElementSize() != 1)
+                throw std::runtime_error("wrong! out of a full reduction has one element");
+        }
+        else
+        {
+            for(std::size_t i = 0; i < InvariantDims.size(); ++i)
+            {
+                if(lengths[i] != InvariantLengths[i])
+                    throw std::runtime_error("wrong! inconsistent host reduction out lengths");
+
+                invariant_strides[i] = strides[i];
+            }
+        }
+
+        return invariant_strides;
+    }
+};
+
+// reduce_dims may be given in any order, the flattened indices follow increasing dimensions
+inline HostReduceProblem make_HostReduceProblem(const HostTensorDescriptor& in_desc,
+                                                const HostTensorDescriptor& out_desc,
+                                                std::vector<int> reduce_dims)
+{
+    const std::size_t ndim = in_desc.GetNumOfDimension();
+
+    std::sort(reduce_dims.begin(), reduce_dims.end());
+
+    if(reduce_dims.empty() || reduce_dims.front() < 0 || reduce_dims.back() >= int(ndim) ||
+       std::adjacent_find(reduce_dims.begin(), reduce_dims.end()) != reduce_dims.end())
+    {
+        throw std::runtime_error("wrong! invalid host reduction dimensions");
+    }
+
+    HostReduceProblem problem;
+
+    for(std::size_t d = 0; d < ndim; ++d)
+    {
+        const std::size_t length = in_desc.GetLengths()[d];
+        const std::size_t stride = in_desc.GetStrides()[d];
+
+        if(std::binary_search(reduce_dims.begin(), reduce_dims.end(), int(d)))
+        {
+            problem.ReduceDims.push_back(d);
+            problem.ReduceLengths.push_back(length);
+            problem.ReduceInStrides.push_back(stride);
+        }
+        else
+        {
+            problem.InvariantDims.push_back(d);
+            problem.InvariantLengths.push_back(length);
+            problem.InvariantInStrides.push_back(stride);
+        }
+    }
+
+    const std::size_t out_ndim = out_desc.GetNumOfDimension();
+
+    problem.OutNumDimension =
+        out_ndim == ndim ? ndim : std::max<std::size_t>(ndim - reduce_dims.size(), 1);
+
+    if(out_ndim != problem.OutNumDimension)
+        throw std::runtime_error("wrong! inconsistent host reduction out dimensions");
+
+    problem.GetInvariantStrides(out_desc);
+
+    return problem;
+}
+
+template <ck::ReduceTensorOp_t Op>
+struct HostReduceOperation
+{
+    static constexpr bool indexable = Op == ck::ReduceTensorOp_t::MIN ||
+                                      Op == ck::ReduceTensorOp_t::MAX ||
+                                      Op == ck::ReduceTensorOp_t::AMAX;
+
+    template <typename T>
+    static T GetZeroValue()
+    {
+        if constexpr(Op == ck::ReduceTensorOp_t::MUL)
+            return T{1};
+        else if constexpr(Op == ck::ReduceTensorOp_t::MIN)
+            return std::numeric_limits<T>::max();
+        else if constexpr(Op == ck::ReduceTensorOp_t::MAX)
+            return std::numeric_limits<T>::lowest();
+        else
+            return T{0};
+    }
+
+    template <typename T>
+    CK_HOST_ALWAYS_INLINE static T PreOp(T x)
+    {
+        if constexpr(Op == ck::ReduceTensorOp_t::NORM1 || Op == ck::ReduceTensorOp_t::AMAX)
+            return x < T{0} ? -x : x;
+        else if constexpr(Op == ck::ReduceTensorOp_t::NORM2)
+            return x * x;
+        else
+            return x;
+    }
+
+    template <typename T>
+    CK_HOST_ALWAYS_INLINE static T Apply(T a, T b)
+    {
+        if constexpr(Op == ck::ReduceTensorOp_t::MUL)
+            return a * b;
+        else if constexpr(Op == ck::ReduceTensorOp_t::MIN)
+            return a > b ? b : a;
+        else if constexpr(indexable)
+            return a < b ? b : a;
+        else
+            return a + b;
+    }
+
+    // whether Apply(a, b) takes b, ties keep a
+    template <typename T>
+    CK_HOST_ALWAYS_INLINE static bool Replaces(T a, T b)
+    {
+        if constexpr(Op == ck::ReduceTensorOp_t::MIN)
+            return a > b;
+        else
+            return a < b;
+    }
+
+    template <typename T>
+    static T PostOp(T v, std::size_t reduce_length)
+    {
+        if constexpr(Op == ck::ReduceTensorOp_t::AVG)
+            return v / static_cast<T>(reduce_length);
+        else if constexpr(Op == ck::ReduceTensorOp_t::NORM2)
+            return static_cast<T>(std::sqrt(v));
+        else
+            return v;
+    }
+};
+
+// a = op(a, b) without indices
+template <ck::ReduceTensorOp_t Op, bool PropagateNan, typename T>
+CK_HOST_ALWAYS_INLINE T host_reduce_accumulate(T a, T b)
+{
+    if constexpr(PropagateNan)
+        return b != b ? b : HostReduceOperation<Op>::Apply(a, b);
+    else
+        return HostReduceOperation<Op>::Apply(a, b);
+}
+
+template <ck::ReduceTensorOp_t Op, bool PropagateNan, typename T>
+CK_HOST_ALWAYS_INLINE void
+host_reduce_accumulate_indexed(T& a, int64_t& a_index, T b, int64_t b_index)
+{
+    if((PropagateNan && b != b) || HostReduceOperation<Op>::Replaces(a, b))
+    {
+        a       = b;
+        a_index = b_index;
+    }
+}
+
+// reduction of pre_op(p_x[i]) for i < n into acc, in 4 x VL independent lanes. The lanes are a
+// plain array left to the vectorizer: GCC scalarizes ?: on vector extension types when it has
+// AVX-512 mask registers
+template <ck::ReduceTensorOp_t Op, bool PropagateNan, typename T, int VL>
+CK_HOST_ALWAYS_INLINE T host_reduce_row(T acc, const T* p_x, std::size_t n)
+{
+    using ReduceOp = HostReduceOperation<Op>;
+
+    constexpr std::size_t NumLane = 4 * VL;
+
+    std::size_t i = 0;
+
+    if(n >= NumLane)
+    {
+        T lanes[NumLane];
+
+        std::fill_n(lanes, NumLane, ReduceOp::template GetZeroValue<T>());
+
+        for(; i + NumLane <= n; i += NumLane)
+            for(std::size_t l = 0; l < NumLane; ++l)
+                lanes[l] =
+                    host_reduce_accumulate<Op, PropagateNan>(lanes[l], ReduceOp::PreOp(p_x[i + l]));
+
+        for(std::size_t l = 0; l < NumLane; ++l)
+            acc = host_reduce_accumulate<Op, PropagateNan>(acc, lanes[l]);
+    }
+
+    for(; i < n; ++i)
+        acc = host_reduce_accumulate<Op, PropagateNan>(acc, ReduceOp::PreOp(p_x[i]));
+
+    return acc;
+}
+
+// p_acc[i] = op(p_acc[i], pre_op(p_x[i])) for i < n, the inputs being element r of the reduction
+template <ck::ReduceTensorOp_t Op, bool PropagateNan, bool Indexed, typename T>
+CK_HOST_ALWAYS_INLINE void
+host_reduce_columns(T* p_acc, int64_t* p_index, const T* p_x, std::size_t n, int64_t r)
+{
+    using ReduceOp = HostReduceOperation<Op>;
+
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        const T b = ReduceOp::PreOp(p_x[i]);
+
+        if constexpr(Indexed)
+            host_reduce_accumulate_indexed<Op, PropagateNan>(p_acc[i], p_index[i], b, r);
+        else
+            p_acc[i] = host_reduce_accumulate<Op, PropagateNan>(p_acc[i], b);
+    }
+}
+
+// operation and NaN handling shared by the ISA specializations of HostReduceKernel
+template <ck::ReduceTensorOp_t Op, bool PropagateNan>
+struct HostReduceKernelBase
+{
+    using ReduceOp = HostReduceOperation<Op>;
+
+    template <typename T>
+    static T Accumulate(T a, T b)
+    {
+        return host_reduce_accumulate<Op, PropagateNan>(a, b);
+    }
+
+    template <typename T>
+    static void AccumulateIndexed(T& a, int64_t& a_index, T b, int64_t b_index)
+    {
+        host_reduce_accumulate_indexed<Op, PropagateNan>(a, a_index, b, b_index);
+    }
+};
+
+template <ck::ReduceTensorOp_t Op, bool PropagateNan, typename T, HostSimdIsa_t Isa>
+struct HostReduceKernel;
+
+template <ck::ReduceTensorOp_t Op, bool PropagateNan, typename T>
+struct HostReduceKernel<Op, PropagateNan, T, HostSimdIsa_t::Scalar>
+    : public HostReduceKernelBase<Op, PropagateNan>
+{
+    static constexpr int VL = std::max<int>(16 / sizeof(T), 1);
+
+    static T Row(T acc, const T* p_x, std::size_t n)
+    {
+        return host_reduce_row<Op, PropagateNan, T, VL>(acc, p_x, n);
+    }
+
+    template <bool Indexed>
+    static void Columns(T* p_acc, int64_t* p_index, const T* p_x, std::size_t n, int64_t r)
+    {
+        host_reduce_columns<Op, PropagateNan, Indexed>(p_acc, p_index, p_x, n, r);
+    }
+};
+
+template <ck::ReduceTensorOp_t Op, bool PropagateNan, typename T>
+struct HostReduceKernel<Op, PropagateNan, T, HostSimdIsa_t::Avx2>
+    : public HostReduceKernelBase<Op, PropagateNan>
+{
+    static constexpr int VL = std::max<int>(32 / sizeof(T), 1);
+
+    CK_HOST_TARGET_AVX2 static T Row(T acc, const T* p_x, std::size_t n)
+    {
+        return host_reduce_row<Op, PropagateNan, T, VL>(acc, p_x, n);
+    }
+
+    template <bool Indexed>
+    CK_HOST_TARGET_AVX2 static void
+    Columns(T* p_acc, int64_t* p_index, const T* p_x, std::size_t n, int64_t r)
+    {
+        host_reduce_columns<Op, PropagateNan, Indexed>(p_acc, p_index, p_x, n, r);
+    }
+};
+
+template <ck::ReduceTensorOp_t Op, bool PropagateNan, typename T>
+struct HostReduceKernel<Op, PropagateNan, T, HostSimdIsa_t::Avx512>
+    : public HostReduceKernelBase<Op, PropagateNan>
+{
+    static constexpr int VL = std::max<int>(64 / sizeof(T), 1);
+
+    CK_HOST_TARGET_AVX512 static T Row(T acc, const T* p_x, std::size_t n)
+    {
+        return host_reduce_row<Op, PropagateNan, T, VL>(acc, p_x, n);
+    }
+
+    template <bool Indexed>
+    CK_HOST_TARGET_AVX512 static void
+    Columns(T* p_acc, int64_t* p_index, const T* p_x, std::size_t n, int64_t r)
+    {
+        host_reduce_columns<Op, PropagateNan, Indexed>(p_acc, p_index, p_x, n, r);
+    }
+};
+
+template <typename Kernel,
+          typename AccDataType,
+          typename TIn,
+          typename TOut,
+          typename TIndex>
+void host_reduce_impl(const HostReduceProblem& problem,
+                      const TIn* p_in,
+                      TOut* p_out,
+                      const std::vector<std::size_t>& out_strides,
+                      TIndex* p_indices,
+                      const std::vector<std::size_t>& indices_strides,
+                      float alpha,
+                      float beta,
+                      std::size_t num_thread)
+{
+    using ReduceOp = typename Kernel::ReduceOp;
+
+    // inputs are converted to AccDataType in chunks, also the block of outputs reduced together
+    constexpr std::size_t ChunkSize = 256;
+
+    // shortest slice of a reduction split in two passes
+    constexpr std::size_t MinSliceLength = 16384;
+
+    const std::size_t I = problem.GetInvariantLength();
+    const std::size_t R = problem.GetReduceLength();
+
+    if(I == 0)
+        return;
+
+    const bool need_indices = ReduceOp::indexable && p_indices != nullptr;
+
+    if(need_indices && R > 0 && R - 1 > std::size_t(std::numeric_limits<TIndex>::max()))
+        throw std::runtime_error("wrong! reduce length overflows the index type");
+
+    num_thread = std::max<std::size_t>(num_thread, 1);
+
+    const std::size_t num_invariant_dim = problem.InvariantLengths.size();
+
+    // outputs are reduced in blocks of adjacent elements when the innermost invariant dimension
+    // is contiguous in in and the reduction runs are not
+    const bool reduce_inner_unit = problem.ReduceInStrides.back() == 1;
+
+    const std::size_t inner_length =
+        num_invariant_dim > 0 ? problem.InvariantLengths.back() : std::size_t{1};
+
+    const bool column_mode = num_invariant_dim > 0 && !reduce_inner_unit &&
+                             problem.InvariantInStrides.back() == 1 && inner_length > 1;
+
+    const std::size_t block_length = column_mode ? std::min(inner_length, ChunkSize) : 1;
+    const std::size_t num_block    = (inner_length + block_length - 1) / block_length;
+    const std::size_t outer_length = column_mode ? I / inner_length : I;
+    const std::size_t num_unit     = outer_length * (column_mode ? num_block : 1);
+
+    // split the reduce range when there are too few units to keep the threads busy
+    std::size_t num_slice = 1;
+
+    if(num_unit < 4 * num_thread && R >= 2 * MinSliceLength)
+        num_slice = std::min((4 * num_thread + num_unit - 1) / num_unit, R / MinSliceLength);
+
+    const std::size_t slice_length = (R + num_slice - 1) / num_slice;
+
+    const HostTensorDescriptor reduce_desc(problem.ReduceLengths, problem.ReduceInStrides);
+
+    // offsets of the element o of the flattened invariant dimensions in in, out and indices
+    auto f_invariant_offsets = [&](std::size_t o) {
+        std::array<std::size_t, 3> offsets{};
+
+        for(std::size_t d = num_invariant_dim; d-- > 0;)
+        {
+            const std::size_t i = o % problem.InvariantLengths[d];
+
+            o /= problem.InvariantLengths[d];
+
+            offsets[0] += i * problem.InvariantInStrides[d];
+            offsets[1] += i * out_strides[d];
+            offsets[2] += need_indices ? i * indices_strides[d] : 0;
+        }
+
+        return offsets;
+    };
+
+    auto f_store = [&](const std::array<std::size_t, 3>& offsets, AccDataType acc, int64_t index) {
+        AccDataType v = ReduceOp::PostOp(acc, R);
+
+        if(alpha != 1.0f)
+            v *= static_cast<AccDataType>(alpha);
+
+        if(beta != 0.0f)
+            v += host_type_convert<AccDataType>(p_out[offsets[1]]) * static_cast<AccDataType>(beta);
+
+        p_out[offsets[1]] = host_type_convert<TOut>(v);
+
+        if(need_indices)
+            p_indices[offsets[2]] = static_cast<TIndex>(index);
+    };
+
+    // partial results of the first pass, [unit output][slice]
+    std::vector<AccDataType> ws_values(num_slice > 1 ? I * num_slice : 0);
+    std::vector<int64_t> ws_indices(num_slice > 1 && need_indices ? I * num_slice : 0);
+
+    auto f_result = [&](std::size_t o, std::size_t s, AccDataType acc, int64_t index) {
+        if(num_slice == 1)
+        {
+            f_store(f_invariant_offsets(o), acc, index);
+        }
+        else
+        {
+            ws_values[o * num_slice + s] = acc;
+
+            if(need_indices)
+                ws_indices[o * num_slice + s] = index;
+        }
+    };
+
+    auto pass_through = [](auto v) { return v; };
+
+    // calls f(p_x, len, r0) on the n inputs p[i * stride] as AccDataType, in chunks starting at
+    // element r0 of the reduction, or directly on p when no conversion is needed
+    auto f_chunks = [&](const TIn* p, std::size_t stride, std::size_t n, int64_t r, auto f) {
+        if constexpr(std::is_same<TIn, AccDataType>::value)
+        {
+            if(stride == 1)
+            {
+                f(p, n, r);
+                return;
+            }
+        }
+
+        AccDataType chunk[ChunkSize];
+
+        for(std::size_t i0 = 0; i0 < n; i0 += ChunkSize)
+        {
+            const std::size_t len = std::min(ChunkSize, n - i0);
+
+            host_convert_elementwise(chunk, 1, p + i0 * stride, stride, len, pass_through);
+
+            f(chunk, len, r + int64_t(i0));
+        }
+    };
+
+    // each output reduces its runs of inputs
+    auto f_row_unit = [&](std::size_t o, std::size_t s) {
+        const std::size_t r_begin = s * slice_length;
+        const std::size_t r_end   = std::min(r_begin + slice_length, R);
+
+        const TIn* p_in_base = p_in + f_invariant_offsets(o)[0];
+
+        AccDataType acc = ReduceOp::template GetZeroValue<AccDataType>();
+        int64_t index   = 0;
+        int64_t r       = r_begin;
+
+        host_tensor_for_each_run<1>(
+            problem.ReduceLengths,
+            {&reduce_desc},
+            r_begin,
+            r_end,
+            [&](const auto& offsets, const auto& strides, std::size_t run) {
+                f_chunks(p_in_base + offsets[0],
+                         strides[0],
+                         run,
+                         r,
+                         [&](const AccDataType* p_x, std::size_t n, int64_t r0) {
+                             if(need_indices)
+                             {
+                                 for(std::size_t i = 0; i < n; ++i)
+                                     Kernel::AccumulateIndexed(
+                                         acc, index, ReduceOp::PreOp(p_x[i]), r0 + int64_t(i));
+                             }
+                             else
+                             {
+                                 acc = Kernel::Row(acc, p_x, n);
+                             }
+                         });
+
+                r += run;
+            });
+
+        f_result(o, s, acc, index);
+    };
+
+    // a block of adjacent outputs reduces the inputs element-wise
+    auto f_column_unit = [&](std::size_t outer, std::size_t b, std::size_t s) {
+        const std::size_t r_begin = s * slice_length;
+        const std::size_t r_end   = std::min(r_begin + slice_length, R);
+
+        const std::size_t o_begin = outer * inner_length + b * block_length;
+        const std::size_t nb      = std::min(block_length, inner_length - b * block_length);
+
+        const TIn* p_in_base = p_in + f_invariant_offsets(o_begin)[0];
+
+        AccDataType acc[ChunkSize];
+        int64_t index[ChunkSize];
+
+        std::fill_n(acc, nb, ReduceOp::template GetZeroValue<AccDataType>());
+        std::fill_n(index, nb, int64_t{0});
+
+        int64_t r = r_begin;
+
+        host_tensor_for_each_run<1>(
+            problem.ReduceLengths,
+            {&reduce_desc},
+            r_begin,
+            r_end,
+            [&](const auto& offsets, const auto& strides, std::size_t run) {
+                for(std::size_t j = 0; j < run; ++j, ++r)
+                    f_chunks(p_in_base + offsets[0] + j * strides[0],
+                             1,
+                             nb,
+                             r,
+                             [&](const AccDataType* p_x, std::size_t, int64_t) {
+                                 if(need_indices)
+                                     Kernel::template Columns<true>(acc, index, p_x, nb, r);
+                                 else
+                                     Kernel::template Columns<false>(acc, index, p_x, nb, r);
+                             });
+            });
+
+        for(std::size_t i = 0; i < nb; ++i)
+            f_result(o_begin + i, s, acc[i], index[i]);
+    };
+
+    if(column_mode)
+        make_ParallelTensorFunctor(f_column_unit, outer_length, num_block, num_slice)(num_thread);
+    else
+        make_ParallelTensorFunctor(f_row_unit, I, num_slice)(num_thread);
+
+    if(num_slice == 1)
+        return;
+
+    // second pass: the partials are already through pre_op, and in the order of the slices
+    auto f_second = [&](std::size_t o) {
+        AccDataType acc = ReduceOp::template GetZeroValue<AccDataType>();
+        int64_t index   = 0;
+
+        for(std::size_t s = 0; s < num_slice; ++s)
+        {
+            const AccDataType v = ws_values[o * num_slice + s];
+
+            if(need_indices)
+                Kernel::AccumulateIndexed(acc, index, v, ws_indices[o * num_slice + s]);
+            else
+                acc = Kernel::Accumulate(acc, v);
+        }
+
+        f_store(f_invariant_offsets(o), acc, index);
+    };
+
+    make_ParallelTensorFunctor(f_second, I)(num_thread);
+}
+
+// calls f(HostReduceKernel<...>{}) for the requested operation, NaN option and ISA
+template <typename AccDataType, typename F>
+void host_reduce_dispatch(ck::ReduceTensorOp_t op,
+                          ck::NanPropagation_t nan_opt,
+                          HostSimdIsa_t isa,
+                          F f)
+{
+    auto f_isa = [&](auto op_constant, auto nan_constant) {
+        constexpr ck::ReduceTensorOp_t Op = decltype(op_constant)::value;
+        constexpr bool PropagateNan       = decltype(nan_constant)::value;
+
+        switch(std::min(isa, get_host_simd_isa()))
+        {
+        case HostSimdIsa_t::Avx512:
+            f(HostReduceKernel<Op, PropagateNan, AccDataType, HostSimdIsa_t::Avx512>{});
+            break;
+        case HostSimdIsa_t::Avx2:
+            f(HostReduceKernel<Op, PropagateNan, AccDataType, HostSimdIsa_t::Avx2>{});
+            break;
+        default: f(HostReduceKernel<Op, PropagateNan, AccDataType, HostSimdIsa_t::Scalar>{});
+        }
+    };
+
+    // NaNs only need a check for MIN / MAX / AMAX, the other operations carry them through
+    auto f_nan = [&](auto op_constant) {
+        constexpr ck::ReduceTensorOp_t Op = decltype(op_constant)::value;
+
+        if(HostReduceOperation<Op>::indexable && nan_opt == ck::NanPropagation_t::PROPAGATE_NAN)
+            f_isa(op_constant, std::true_type{});
+        else
+            f_isa(op_constant, std::false_type{});
+    };
+
+    using ReduceOp_t = ck::ReduceTensorOp_t;
+
+    switch(op)
+    {
+    case ReduceOp_t::ADD: f_nan(std::integral_constant<ReduceOp_t, ReduceOp_t::ADD>{}); break;
+    case ReduceOp_t::MUL: f_nan(std::integral_constant<ReduceOp_t, ReduceOp_t::MUL>{}); break;
+    case ReduceOp_t::MIN: f_nan(std::integral_constant<ReduceOp_t, ReduceOp_t::MIN>{}); break;
+    case ReduceOp_t::MAX: f_nan(std::integral_constant<ReduceOp_t, ReduceOp_t::MAX>{}); break;
+    case ReduceOp_t::AMAX: f_nan(std::integral_constant<ReduceOp_t, ReduceOp_t::AMAX>{}); break;
+    case ReduceOp_t::AVG: f_nan(std::integral_constant<ReduceOp_t, ReduceOp_t::AVG>{}); break;
+    case ReduceOp_t::NORM1: f_nan(std::integral_constant<ReduceOp_t, ReduceOp_t::NORM1>{}); break;
+    case ReduceOp_t::NORM2: f_nan(std::integral_constant<ReduceOp_t, ReduceOp_t::NORM2>{}); break;
+    default: throw std::runtime_error("wrong! unknown host reduction operation");
+    }
+}
+
+// p_indices may be null, and is only written by MIN / MAX / AMAX
+template <typename AccDataType, typename TIn, typename TOut, typename TIndex>
+void host_reduce(const HostReduceProblem& problem,
+                 const TIn* p_in,
+                 TOut* p_out,
+                 const std::vector<std::size_t>& out_strides,
+                 TIndex* p_indices,
+                 const std::vector<std::size_t>& indices_strides,
+                 ck::ReduceTensorOp_t op,
+                 ck::NanPropagation_t nan_opt,
+                 float alpha            = 1.0f,
+                 float beta             = 0.0f,
+                 std::size_t num_thread = get_host_num_threads(),
+                 HostSimdIsa_t isa      = get_host_simd_isa())
+{
+    host_reduce_dispatch<AccDataType>(op, nan_opt, isa, [&](auto kernel) {
+        using Kernel = decltype(kernel);
+
+        host_reduce_impl<Kernel, AccDataType>(problem,
+                                              p_in,
+                                              p_out,
+                                              out_strides,
+                                              p_indices,
+                                              indices_strides,
+                                              alpha,
+                                              beta,
+                                              num_thread);
+    });
+}
+
+// tensor interface, indices may be null
+template <typename AccDataType, typename TIn, typename TOut, typename TIndex = int32_t>
+void host_reduce(const Tensor<TIn>& in,
+                 Tensor<TOut>& out,
+                 Tensor<TIndex>* p_indices,
+                 const std::vector<int>& reduce_dims,
+                 ck::ReduceTensorOp_t op,
+                 ck::NanPropagation_t nan_opt,
+                 float alpha            = 1.0f,
+                 float beta             = 0.0f,
+                 std::size_t num_thread = get_host_num_threads(),
+                 HostSimdIsa_t isa      = get_host_simd_isa())
+{
+    const auto problem = make_HostReduceProblem(in.mDesc, out.mDesc, reduce_dims);
+
+    const auto out_strides = problem.GetInvariantStrides(out.mDesc);
+
+    const auto indices_strides =
+        p_indices != nullptr ? problem.GetInvariantStrides(p_indices->mDesc) : out_strides;
+
+    host_reduce<AccDataType>(problem,
+                             in.mData.data(),
+                             out.mData.data(),
+                             out_strides,
+                             p_indices != nullptr ? p_indices->mData.data() : nullptr,
+                             indices_strides,
+                             op,
+                             nan_opt,
+                             alpha,
+                             beta,
+                             num_thread,
+                             isa);
+}
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef HOST_SIMD_HPP
+#define HOST_SIMD_HPP
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+// Host-side SIMD helpers. Kernels are compiled for several instruction sets with per-function
+// target attributes and picked at runtime, so host code does not need to be built with -march.
+// Every level from Avx2 up includes F16C (vcvtph2ps / vcvtps2ph). AVX-512 BF16 and VNNI are
+// optional extensions of a level, see get_host_simd_has_avx512_bf16() and the VNNI queries.
+#if defined(__x86_64__) || defined(__i386__)
+#define CK_HOST_X86 1
+#define CK_HOST_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#define CK_HOST_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl,avx2,fma,f16c")))
+#define CK_HOST_TARGET_AVX512_BF16 \
+    __attribute__((target("avx512f,avx512bw,avx512vl,avx512bf16,avx2,fma,f16c")))
+#define CK_HOST_TARGET_AVX_VNNI __attribute__((target("avxvnni,avx2,fma,f16c")))
+#define CK_HOST_TARGET_AVX512_VNNI \
+    __attribute__((target("avx512f,avx512bw,avx512vl,avx512vnni,avx2,fma,f16c")))
+#else
+#define CK_HOST_X86 0
+#define CK_HOST_TARGET_AVX2
+#define CK_HOST_TARGET_AVX512
+#define CK_HOST_TARGET_AVX512_BF16
+#define CK_HOST_TARGET_AVX_VNNI
+#define CK_HOST_TARGET_AVX512_VNNI
+#endif
+
+#define CK_HOST_ALWAYS_INLINE inline __attribute__((always_inline))
+
+enum class HostSimdIsa_t
+{
+    Scalar = 0,
+    Avx2   = 1,
+    Avx512 = 2,
+};
+
+inline const char* get_host_simd_isa_name(HostSimdIsa_t isa)
+{
+    switch(isa)
+    {
+    case HostSimdIsa_t::Avx512: return "avx512";
+    case HostSimdIsa_t::Avx2: return "avx2";
+    default: return "scalar";
+    }
+}
+
+// detected once per process, can be lowered (never raised) with CK_HOST_SIMD=scalar|avx2|avx512
+inline HostSimdIsa_t get_host_simd_isa()
+{
+    static const HostSimdIsa_t isa = [] {
+        HostSimdIsa_t detected = HostSimdIsa_t::Scalar;
+
+#if CK_HOST_X86
+        __builtin_cpu_init();
+
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+        const bool f16c = __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_F16C) != 0;
+
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && f16c)
+        {
+            detected = HostSimdIsa_t::Avx2;
+        }
+
+        if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+           __builtin_cpu_supports("avx512vl"))
+        {
+            detected = HostSimdIsa_t::Avx512;
+        }
+#endif
+
+        if(const char* env = std::getenv("CK_HOST_SIMD"))
+        {
+            HostSimdIsa_t requested = detected;
+
+            if(std::strcmp(env, "scalar") == 0)
+                requested = HostSimdIsa_t::Scalar;
+            else if(std::strcmp(env, "avx2") == 0)
+                requested = HostSimdIsa_t::Avx2;
+            else if(std::strcmp(env, "avx512") == 0)
+                requested = HostSimdIsa_t::Avx512;
+
+            if(requested < detected)
+                detected = requested;
+        }
+
+        return detected;
+    }();
+
+    return isa;
+}
+
+// vcvtneps2bf16 / vdpbf16ps, only reported when the Avx512 level is in use
+inline bool get_host_simd_has_avx512_bf16()
+{
+    static const bool has_bf16 = [] {
+#if CK_HOST_X86
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+        return get_host_simd_isa() == HostSimdIsa_t::Avx512 &&
+               __get_cpuid_count(7, 1, &eax, &ebx, &ecx, &edx) && (eax & bit_AVX512BF16) != 0;
+#else
+        return false;
+#endif
+    }();
+
+    return has_bf16;
+}
+
+// vpdpbusd on 512-bit vectors, only reported when the Avx512 level is in use
+inline bool get_host_simd_has_avx512_vnni()
+{
+    static const bool has_vnni = [] {
+#if CK_HOST_X86
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+        return get_host_simd_isa() == HostSimdIsa_t::Avx512 &&
+               __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ecx & bit_AVX512VNNI) != 0;
+#else
+        return false;
+#endif
+    }();
+
+    return has_vnni;
+}
+
+// VEX encoded vpdpbusd on 256-bit vectors (AVX-VNNI), reported from the Avx2 level up
+inline bool get_host_simd_has_avx_vnni()
+{
+    static const bool has_vnni = [] {
+#if CK_HOST_X86
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+        return get_host_simd_isa() >= HostSimdIsa_t::Avx2 &&
+               __get_cpuid_count(7, 1, &eax, &ebx, &ecx, &edx) && (eax & bit_AVXVNNI) != 0;
+#else
+        return false;
+#endif
+    }();
+
+    return has_vnni;
+}
+
+// generic vector extension type, lowered to xmm/ymm/zmm depending on the calling function's target
+template <typename T, int N>
+struct host_vector_type
+{
+    typedef T type __attribute__((vector_size(sizeof(T) * N)));
+};
+
+template <typename T, int N>
+using host_vector_t = typename host_vector_type<T, N>::type;
+
+template <typename T, int N>
+CK_HOST_ALWAYS_INLINE host_vector_t<T, N> host_vector_load(const T* p)
+{
+    host_vector_t<T, N> v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+template <typename T, int N>
+CK_HOST_ALWAYS_INLINE void host_vector_store(T* p, const host_vector_t<T, N>& v)
+{
+    std::memcpy(p, &v, sizeof(v));
+}
+
+template <typename T, int N>
+CK_HOST_ALWAYS_INLINE host_vector_t<T, N> host_vector_broadcast(T x)
+{
+    return host_vector_t<T, N>{} + x;
+}
+
+#endif
@@ -7,7 +7,11 @@
 #include <algorithm>
 #include <utility>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
+#include <array>
+#include "host_thread_pool.hpp"
+#include "host_tensor_allocator.hpp"
 
 template <typename Range>
 std::ostream& LogRange(std::ostream& os, Range&& range, std::string delim)
@@ -109,6 +113,9 @@ struct HostTensorDescriptor
     std::size_t GetElementSize() const;
     std::size_t GetElementSpace() const;
 
+    // strides are the row-major strides of the lengths
+    bool IsPacked() const;
+
     const std::vector<std::size_t>& GetLengths() const;
     const std::vector<std::size_t>& GetStrides() const;
 
@@ -116,8 +123,13 @@ struct HostTensorDescriptor
     std::size_t GetOffsetFromMultiIndex(Is... is) const
     {
         assert(sizeof...(Is) == this->GetNumOfDimension());
-        std::initializer_list<std::size_t> iss{static_cast<std::size_t>(is)...};
-        return std::inner_product(iss.begin(), iss.end(), mStrides.begin(), std::size_t{0});
+
+        std::size_t offset = 0;
+        std::size_t idim   = 0;
+
+        ((offset += static_cast<std::size_t>(is) * mStrides[idim++]), ...);
+
+        return offset;
     }
 
     friend std::ostream& operator<<(std::ostream& os, const HostTensorDescriptor& desc);
@@ -176,25 +188,31 @@ struct ParallelTensorFunctor
         return indices;
     }
 
-    void operator()(std::size_t num_thread = std::thread::hardware_concurrency()) const
+    // runs on the process-wide HostThreadPool, grain_size 0 lets the pool pick the chunk size
+    void operator()(std::size_t num_thread = get_host_num_threads(),
+                    std::size_t grain_size = 0) const
     {
-        std::size_t work_per_thread = (mN1d + num_thread - 1) / num_thread;
-
-        std::vector<joinable_thread> threads(num_thread);
-
-        for(std::size_t it = 0; it < num_thread; ++it)
-        {
-            std::size_t iw_begin = it * work_per_thread;
-            std::size_t iw_end   = std::min((it + 1) * work_per_thread, mN1d);
+        HostThreadPool::GetInstance().ParallelFor(
+            mN1d,
+            [&](std::size_t iw_begin, std::size_t iw_end) {
+                auto indices = GetNdIndices(iw_begin);
 
-            auto f = [=] {
                 for(std::size_t iw = iw_begin; iw < iw_end; ++iw)
                 {
-                    call_f_unpack_args(mF, GetNdIndices(iw));
+                    call_f_unpack_args(mF, indices);
+
+                    // increment the multi-index instead of dividing for every element
+                    for(std::size_t idim = NDIM; idim-- > 0;)
+                    {
+                        if(++indices[idim] < mLens[idim] || idim == 0)
+                            break;
+
+                        indices[idim] = 0;
+                    }
                 }
-            };
-            threads[it] = joinable_thread(f);
-        }
+            },
+            num_thread,
+            grain_size);
     }
 };
 
@@ -204,9 +222,108 @@ auto make_ParallelTensorFunctor(F f, Xs... xs)
     return ParallelTensorFunctor<F, Xs...>(f, xs...);
 }
 
+// Visits logical elements [begin, end), in row-major order of lengths, of NumTensor tensors that
+// share lengths but may have different strides. f(offsets, inner_strides, length) is called for
+// each run along the innermost dimension, offsets are those of the first element of the run.
+// If all tensors are packed the whole range is a single run with unit stride.
+template <std::size_t NumTensor, typename F>
+void host_tensor_for_each_run(const std::vector<std::size_t>& lengths,
+                              const std::array<const HostTensorDescriptor*, NumTensor>& descs,
+                              std::size_t begin,
+                              std::size_t end,
+                              F f)
+{
+    std::array<std::size_t, NumTensor> offsets{};
+    std::array<std::size_t, NumTensor> inner_strides{};
+
+    if(begin >= end)
+        return;
+
+    const std::size_t ndim = lengths.size();
+
+    const bool packed = std::all_of(descs.begin(), descs.end(), [](const auto* desc) {
+        return desc->IsPacked();
+    });
+
+    if(packed || ndim == 0)
+    {
+        offsets.fill(begin);
+        inner_strides.fill(1);
+
+        f(offsets, inner_strides, end - begin);
+        return;
+    }
+
+    std::vector<std::size_t> index(ndim);
+
+    for(std::size_t idim = ndim, rest = begin; idim-- > 0;)
+    {
+        index[idim] = rest % lengths[idim];
+        rest /= lengths[idim];
+    }
+
+    for(std::size_t j = 0; j < NumTensor; ++j)
+    {
+        const auto& strides = descs[j]->GetStrides();
+
+        for(std::size_t idim = 0; idim < ndim; ++idim)
+            offsets[j] += index[idim] * strides[idim];
+
+        inner_strides[j] = strides[ndim - 1];
+    }
+
+    for(std::size_t i = begin; i < end;)
+    {
+        const std::size_t run = std::min(end - i, lengths[ndim - 1] - index[ndim - 1]);
+
+        f(offsets, inner_strides, run);
+
+        i += run;
+
+        if(i == end)
+            break;
+
+        // step to the start of the next run, carrying into the outer dimensions
+        index[ndim - 1] += run;
+
+        for(std::size_t j = 0; j < NumTensor; ++j)
+            offsets[j] += run * inner_strides[j];
+
+        for(std::size_t idim = ndim - 1; idim > 0 && index[idim] == lengths[idim]; --idim)
+        {
+            index[idim] = 0;
+            ++index[idim - 1];
+
+            for(std::size_t j = 0; j < NumTensor; ++j)
+            {
+                const auto& strides = descs[j]->GetStrides();
+
+                offsets[j] += strides[idim - 1] - lengths[idim] * strides[idim];
+            }
+        }
+    }
+}
+
+// whether g(i0, ..., i{NDim - 1}) can be called with std::size_t indices
+template <typename G, typename Seq>
+struct is_generator_of_rank_impl;
+
+template <typename G, std::size_t... Is>
+struct is_generator_of_rank_impl<G, std::index_sequence<Is...>>
+    : std::is_invocable<G&, decltype(static_cast<void>(Is), std::size_t{})...>
+{
+};
+
+template <typename G, std::size_t NDim>
+using is_generator_of_rank = is_generator_of_rank_impl<G, std::make_index_sequence<NDim>>;
+
+// Elements are value-initialized on construction, the HostTensorDefaultInit constructors leave
+// them uninitialized for tensors that are fully overwritten, see host_tensor_allocator.hpp.
 template <typename T>
 struct Tensor
 {
+    using Storage = std::vector<T, HostTensorAllocator<T>>;
+
     template <typename X>
     Tensor(std::initializer_list<X> lens) : mDesc(lens), mData(mDesc.GetElementSpace())
     {
@@ -225,52 +342,64 @@ struct Tensor
 
     Tensor(const HostTensorDescriptor& desc) : mDesc(desc), mData(mDesc.GetElementSpace()) {}
 
+    Tensor(const HostTensorDescriptor& desc, HostTensorDefaultInit)
+        : mDesc(desc), mData(mDesc.GetElementSpace(), HostTensorAllocator<T>(true))
+    {
+    }
+
+    // generators are called with the multi-index, ranks 1 to MaxGeneratorRank are supported
+    static constexpr std::size_t MaxGeneratorRank = 8;
+
     template <typename G>
-    void GenerateTensorValue(G g, std::size_t num_thread = std::thread::hardware_concurrency())
+    void GenerateTensorValue(G g, std::size_t num_thread = get_host_num_threads())
     {
-        switch(mDesc.GetNumOfDimension())
-        {
-        case 1: {
-            auto f = [&](auto i) { (*this)(i) = g(i); };
-            make_ParallelTensorFunctor(f, mDesc.GetLengths()[0])(num_thread);
-            break;
-        }
-        case 2: {
-            auto f = [&](auto i0, auto i1) { (*this)(i0, i1) = g(i0, i1); };
-            make_ParallelTensorFunctor(f, mDesc.GetLengths()[0], mDesc.GetLengths()[1])(num_thread);
-            break;
-        }
-        case 3: {
-            auto f = [&](auto i0, auto i1, auto i2) { (*this)(i0, i1, i2) = g(i0, i1, i2); };
-            make_ParallelTensorFunctor(
-                f, mDesc.GetLengths()[0], mDesc.GetLengths()[1], mDesc.GetLengths()[2])(num_thread);
-            break;
-        }
-        case 4: {
-            auto f = [&](auto i0, auto i1, auto i2, auto i3) {
-                (*this)(i0, i1, i2, i3) = g(i0, i1, i2, i3);
-            };
-            make_ParallelTensorFunctor(f,
-                                       mDesc.GetLengths()[0],
-                                       mDesc.GetLengths()[1],
-                                       mDesc.GetLengths()[2],
-                                       mDesc.GetLengths()[3])(num_thread);
-            break;
-        }
-        case 5: {
-            auto f = [&](auto i0, auto i1, auto i2, auto i3, auto i4) {
-                (*this)(i0, i1, i2, i3, i4) = g(i0, i1, i2, i3, i4);
-            };
-            make_ParallelTensorFunctor(f,
-                                       mDesc.GetLengths()[0],
-                                       mDesc.GetLengths()[1],
-                                       mDesc.GetLengths()[2],
-                                       mDesc.GetLengths()[3],
-                                       mDesc.GetLengths()[4])(num_thread);
-            break;
-        }
-        default: throw std::runtime_error("unspported dimension");
-        }
+        GenerateTensorValueRank<1>(g, num_thread);
+    }
+
+    // calls f(x) with a reference to every element
+    template <typename F>
+    void ForEach(F f, std::size_t num_thread = get_host_num_threads())
+    {
+        ParallelForEachRun<1>({&mDesc}, num_thread, [&](auto offsets, auto strides, auto length) {
+            T* p = mData.data() + offsets[0];
+
+            for(std::size_t i = 0; i < length; ++i)
+                f(p[i * strides[0]]);
+        });
+    }
+
+    // x = f(a) for every element, a has the same lengths as this tensor
+    template <typename U, typename F>
+    void Transform(const Tensor<U>& a, F f, std::size_t num_thread = get_host_num_threads())
+    {
+        ParallelForEachRun<2>(
+            {&mDesc, &a.mDesc}, num_thread, [&](auto offsets, auto strides, auto length) {
+                T* p       = mData.data() + offsets[0];
+                const U* q = a.mData.data() + offsets[1];
+
+                for(std::size_t i = 0; i < length; ++i)
+                    p[i * strides[0]] = f(q[i * strides[1]]);
+            });
+    }
+
+    // x = f(a, b) for every element, a and b have the same lengths as this tensor
+    template <typename U, typename V, typename F>
+    void Zip(const Tensor<U>& a,
+             const Tensor<V>& b,
+             F f,
+             std::size_t num_thread = get_host_num_threads())
+    {
+        ParallelForEachRun<3>(
+            {&mDesc, &a.mDesc, &b.mDesc},
+            num_thread,
+            [&](auto offsets, auto strides, auto length) {
+                T* p       = mData.data() + offsets[0];
+                const U* q = a.mData.data() + offsets[1];
+                const V* r = b.mData.data() + offsets[2];
+
+                for(std::size_t i = 0; i < length; ++i)
+                    p[i * strides[0]] = f(q[i * strides[1]], r[i * strides[2]]);
+            });
     }
 
     template <typename... Is>
@@ -285,16 +414,92 @@ struct Tensor
         return mData[mDesc.GetOffsetFromMultiIndex(is...)];
     }
 
-    typename std::vector<T>::iterator begin() { return mData.begin(); }
+    typename Storage::iterator begin() { return mData.begin(); }
 
-    typename std::vector<T>::iterator end() { return mData.end(); }
+    typename Storage::iterator end() { return mData.end(); }
 
-    typename std::vector<T>::const_iterator begin() const { return mData.begin(); }
+    typename Storage::const_iterator begin() const { return mData.begin(); }
 
-    typename std::vector<T>::const_iterator end() const { return mData.end(); }
+    typename Storage::const_iterator end() const { return mData.end(); }
 
     HostTensorDescriptor mDesc;
-    std::vector<T> mData;
+    Storage mData;
+
+    private:
+    template <std::size_t NumTensor, typename F>
+    void ParallelForEachRun(const std::array<const HostTensorDescriptor*, NumTensor>& descs,
+                            std::size_t num_thread,
+                            F f) const
+    {
+        for(const auto* desc : descs)
+        {
+            if(desc->GetLengths() != mDesc.GetLengths())
+                throw std::runtime_error("wrong! tensors have different lengths");
+        }
+
+        HostThreadPool::GetInstance().ParallelFor(
+            mDesc.GetElementSize(),
+            [&](std::size_t begin, std::size_t end) {
+                host_tensor_for_each_run(mDesc.GetLengths(), descs, begin, end, f);
+            },
+            num_thread);
+    }
+
+    template <std::size_t NDim, typename G>
+    void GenerateTensorValueRank(G& g, std::size_t num_thread)
+    {
+        if constexpr(NDim > MaxGeneratorRank)
+        {
+            throw std::runtime_error("unspported dimension");
+        }
+        else if(mDesc.GetNumOfDimension() != NDim)
+        {
+            GenerateTensorValueRank<NDim + 1>(g, num_thread);
+        }
+        else if constexpr(!is_generator_of_rank<G, NDim>::value)
+        {
+            throw std::runtime_error("wrong! generator does not take this many indices");
+        }
+        else
+        {
+            const auto& lens    = mDesc.GetLengths();
+            const auto& strides = mDesc.GetStrides();
+
+            HostThreadPool::GetInstance().ParallelFor(
+                mDesc.GetElementSize(),
+                [&](std::size_t begin, std::size_t end) {
+                    std::array<std::size_t, NDim> index;
+
+                    std::size_t offset = 0;
+
+                    for(std::size_t idim = NDim, rest = begin; idim-- > 0;)
+                    {
+                        index[idim] = rest % lens[idim];
+                        rest /= lens[idim];
+                        offset += index[idim] * strides[idim];
+                    }
+
+                    for(std::size_t i = begin; i < end; ++i)
+                    {
+                        mData[offset] = call_f_unpack_args(g, index);
+
+                        // increment the multi-index and the offset together
+                        for(std::size_t idim = NDim; idim-- > 0;)
+                        {
+                            ++index[idim];
+                            offset += strides[idim];
+
+                            if(index[idim] < lens[idim] || idim == 0)
+                                break;
+
+                            offset -= lens[idim] * strides[idim];
+                            index[idim] = 0;
+                        }
+                    }
+                },
+                num_thread);
+        }
+    }
 };
 
 template <typename X>
@@ -311,46 +516,18 @@ HostTensorDescriptor::HostTensorDescriptor(std::vector<X> lens, std::vector<Y> s
 
 void ostream_HostTensorDescriptor(const HostTensorDescriptor& desc, std::ostream& os = std::cout);
 
-float bf16_to_f32_(ushort src_val);
-
-template <typename T>
-void check_error(const Tensor<T>& ref, const Tensor<T>& result)
+// bf16 is stored as ushort, inline so per-element conversions in host loops do not become calls
+inline float bf16_to_f32_(ushort src_val)
 {
-    float error     = 0;
-    float max_diff  = -1;
-    float ref_value = 0, result_value = 0;
-
-    if constexpr(std::is_same<ushort, T>::value)
-    {
-        for(int i = 0; i < ref.mData.size(); ++i)
-        {
-            error += std::abs(bf16_to_f32_(ref.mData[i]) - bf16_to_f32_(result.mData[i]));
-            float diff = std::abs(bf16_to_f32_(ref.mData[i]) - bf16_to_f32_(result.mData[i]));
-            if(max_diff < diff)
-            {
-                max_diff     = diff;
-                ref_value    = bf16_to_f32_(ref.mData[i]);
-                result_value = bf16_to_f32_(result.mData[i]);
-            }
-        }
-    }
-    else
+    union
     {
-        for(int i = 0; i < ref.mData.size(); ++i)
-        {
-            error += std::abs(double(ref.mData[i]) - double(result.mData[i]));
-            float diff = std::abs(double(ref.mData[i]) - double(result.mData[i]));
-            if(max_diff < diff)
-            {
-                max_diff     = diff;
-                ref_value    = ref.mData[i];
-                result_value = result.mData[i];
-            }
-        }
-    }
-
-    std::cout << "error: " << error << std::endl;
-    std::cout << "max_diff: " << max_diff << ", " << ref_value << ", " << result_value << std::endl;
+        uint32_t int32;
+        float fp32;
+    } u = {uint32_t(src_val) << 16};
+    return u.fp32;
 }
 
+// check_error() and the comparison engine behind it
+#include "host_tensor_compare.hpp"
+
 #endif
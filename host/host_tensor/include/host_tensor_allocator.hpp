@@ -0,0 +1,143 @@
+#ifndef HOST_TENSOR_ALLOCATOR_HPP
+#define HOST_TENSOR_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+// Storage of host tensors.
+//
+// HostMemoryArena hands out blocks aligned to 64 bytes (one cache line, one AVX-512 vector).
+// Blocks of at least CK_HOST_HUGEPAGE_BYTES are aligned to 2 MB and advised for transparent
+// hugepages, which cuts TLB misses when sweeping large tensors. Freed blocks are kept in the
+// arena and handed out again for requests of similar size, so a profiler sweep over many
+// problems does not return memory to the OS and fault it in again for every problem.
+//
+// HostTensorAllocator value-initializes elements (zero for arithmetic types) unless it was
+// constructed with default_init, which leaves trivial element types uninitialized: a block may
+// then still hold whatever its last user left in it. Tensors that are fully overwritten right
+// away (copied back from the device, read from a file, converted) opt in through
+// HostTensorDefaultInit, so constructing them does not touch their pages. Their first write
+// happens in the parallel Transform / copy, which places every page on the NUMA node of the
+// pool thread that writes (and later consumes) that part of the tensor.
+//
+// Environment:
+//   CK_HOST_ARENA_BYTES:    upper bound on the bytes cached by the arena, 0 disables caching,
+//                           default 1 GB
+//   CK_HOST_HUGEPAGE_BYTES: smallest block that is 2 MB aligned and advised for hugepages,
+//                           0 disables hugepages, default 4 MB
+struct HostMemoryArena
+{
+    static constexpr std::size_t CacheLineBytes = 64;
+    static constexpr std::size_t HugePageBytes  = std::size_t{2} << 20;
+
+    struct Statistics
+    {
+        std::size_t mNumAllocation = 0;
+        std::size_t mNumReuse      = 0;
+        std::size_t mBytesInUse    = 0;
+        std::size_t mBytesCached   = 0;
+    };
+
+    static HostMemoryArena& GetInstance();
+
+    void* Allocate(std::size_t bytes);
+
+    void Deallocate(void* p);
+
+    // return all cached blocks to the OS
+    void Trim();
+
+    Statistics GetStatistics() const;
+
+    HostMemoryArena(const HostMemoryArena&) = delete;
+    HostMemoryArena& operator=(const HostMemoryArena&) = delete;
+
+    ~HostMemoryArena();
+
+    private:
+    HostMemoryArena(std::size_t max_cached_bytes, std::size_t hugepage_bytes);
+
+    // bytes actually reserved for a request
+    std::size_t GetBlockBytes(std::size_t bytes) const;
+
+    void EvictLocked(std::size_t bytes);
+
+    std::size_t mMaxCachedBytes;
+    std::size_t mHugePageThreshold;
+
+    mutable std::mutex mMutex;
+
+    // cached blocks by size, blocks in use with their size
+    std::multimap<std::size_t, void*> mCached;
+    std::unordered_map<void*, std::size_t> mInUse;
+
+    Statistics mStatistics;
+};
+
+// tag of the Tensor constructors that leave trivial elements uninitialized
+struct HostTensorDefaultInit
+{
+};
+
+template <typename T>
+struct HostTensorAllocator
+{
+    using value_type                             = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    HostTensorAllocator() = default;
+
+    explicit HostTensorAllocator(bool default_init) : mDefaultInit(default_init) {}
+
+    template <typename U>
+    HostTensorAllocator(const HostTensorAllocator<U>& other) : mDefaultInit(other.mDefaultInit)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if(n > std::size_t(-1) / sizeof(T))
+            throw std::bad_alloc();
+
+        return static_cast<T*>(HostMemoryArena::GetInstance().Allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t) { HostMemoryArena::GetInstance().Deallocate(p); }
+
+    template <typename U>
+    void construct(U* p) noexcept(std::is_nothrow_default_constructible<U>::value)
+    {
+        if(mDefaultInit)
+            ::new(static_cast<void*>(p)) U;
+        else
+            ::new(static_cast<void*>(p)) U();
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+        ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    bool mDefaultInit = false;
+};
+
+template <typename T, typename U>
+bool operator==(const HostTensorAllocator<T>&, const HostTensorAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const HostTensorAllocator<T>&, const HostTensorAllocator<U>&)
+{
+    return false;
+}
+
+#endif
@@ -0,0 +1,672 @@
+#ifndef HOST_TENSOR_COMPARE_HPP
+#define HOST_TENSOR_COMPARE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <limits>
+#include <type_traits>
+#include "host_tensor.hpp"
+#include "host_tensor_convert.hpp"
+
+// Parallel element-wise comparison of a result tensor against a reference.
+//
+// An element passes if |result - ref| <= AbsTolerance + RelTolerance * |ref|. NaN matches NaN and
+// an infinity matches the same infinity. The ULP distance is measured in the precision of the
+// element type (bf16 for ushort), integers use the plain difference. Tensors are walked in
+// logical order through their descriptors, so any strides work; when both are packed the same way
+// the chunks become plain contiguous loops. Contiguous float, half_t and bf16 runs are widened to
+// float in bulk and screened in vector registers, a block is only checked element by element if
+// one of its elements fails or is not finite.
+//
+// Elements that are sums of products (GEMM, conv) carry rounding errors that grow with the length
+// of the sums, and near-zero elements of a long sum can be off by far more than the relative
+// tolerance allows. With mSumLength set, the absolute tolerance is raised to
+// sqrt(mSumLength) * eps * max|ref|, eps being the machine epsilon of the element type.
+
+struct HostCompareOptions
+{
+    double mAbsTolerance = 0;
+    double mRelTolerance = 0;
+
+    // number of mismatches whose coordinates are kept in the report
+    std::size_t mMaxNumMismatchReported = 8;
+
+    // stop scanning once a mismatch has been found
+    bool mStopAtFirstFailure = false;
+
+    std::size_t mNumThread = get_host_num_threads();
+
+    // length of the sums behind each element, e.g. K of a GEMM or C * Y * X of a conv, 0 if the
+    // elements are not sums
+    std::size_t mSumLength = 0;
+};
+
+template <typename T>
+HostCompareOptions get_default_host_compare_options(std::size_t sum_length = 0)
+{
+    HostCompareOptions options;
+
+    options.mSumLength = sum_length;
+
+    if constexpr(std::is_same<T, ushort>::value)
+    {
+        // bf16, 8 mantissa bits
+        options.mAbsTolerance = 1e-2;
+        options.mRelTolerance = 1.6e-2;
+    }
+    else if constexpr(std::is_integral<T>::value)
+    {
+        // requantized int8 results may be off by one
+        options.mAbsTolerance = sizeof(T) == 1 ? 1 : 0;
+        options.mRelTolerance = 0;
+    }
+    else if constexpr(sizeof(T) == 2)
+    {
+        // half_t
+        options.mAbsTolerance = 1e-3;
+        options.mRelTolerance = 1e-2;
+    }
+    else if constexpr(sizeof(T) == 4)
+    {
+        options.mAbsTolerance = 1e-5;
+        options.mRelTolerance = 1e-4;
+    }
+    else
+    {
+        options.mAbsTolerance = 1e-12;
+        options.mRelTolerance = 1e-10;
+    }
+
+    return options;
+}
+
+struct HostCompareMismatch
+{
+    std::vector<std::size_t> mIndex;
+    double mRef;
+    double mResult;
+};
+
+struct HostCompareReport
+{
+    // bucket i counts ULP distances in [2^(i-1), 2^i), bucket 0 counts exact matches
+    static constexpr std::size_t NumUlpBucket = 34;
+
+    std::size_t mNumElement  = 0;
+    std::size_t mNumChecked  = 0;
+    std::size_t mNumMismatch = 0;
+
+    std::size_t mNumRefNan    = 0;
+    std::size_t mNumResultNan = 0;
+    std::size_t mNumRefInf    = 0;
+    std::size_t mNumResultInf = 0;
+
+    double mSumAbsError = 0;
+    double mMaxAbsError = 0;
+    double mMaxRelError = 0;
+
+    std::vector<std::size_t> mMaxAbsErrorIndex;
+    double mMaxAbsErrorRef    = 0;
+    double mMaxAbsErrorResult = 0;
+
+    std::array<std::size_t, NumUlpBucket> mUlpHistogram{};
+
+    // first mismatches in logical order (any mismatches if the scan stopped early)
+    std::vector<HostCompareMismatch> mMismatches;
+
+    bool mStoppedEarly = false;
+
+    bool Pass() const { return mNumMismatch == 0; }
+};
+
+template <typename T>
+double host_compare_to_double(T x)
+{
+    if constexpr(std::is_same<T, ushort>::value)
+    {
+        return bf16_to_f32_(x);
+    }
+    else
+    {
+        return static_cast<double>(x);
+    }
+}
+
+// signed position of x on the number line of its own type, adjacent values differ by one
+template <typename T>
+std::int64_t host_compare_ulp_position(T x)
+{
+    if constexpr(std::is_integral<T>::value && !std::is_same<T, ushort>::value)
+    {
+        return static_cast<std::int64_t>(x);
+    }
+    else
+    {
+        using Bits = std::conditional_t<
+            sizeof(T) == 2,
+            std::uint16_t,
+            std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>;
+
+        static_assert(sizeof(T) == sizeof(Bits), "wrong! unsupported element type");
+
+        Bits bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+
+        constexpr Bits sign = Bits{1} << (8 * sizeof(Bits) - 1);
+
+        // doubles far apart saturate instead of overflowing
+        const std::uint64_t magnitude =
+            std::min<std::uint64_t>(bits & ~sign, std::uint64_t{1} << 62);
+
+        return (bits & sign) ? -static_cast<std::int64_t>(magnitude)
+                             : static_cast<std::int64_t>(magnitude);
+    }
+}
+
+// bit width of ulp
+inline std::size_t get_host_compare_ulp_bucket(std::uint64_t ulp)
+{
+    const std::size_t bucket = ulp == 0 ? 0 : 64 - __builtin_clzll(ulp);
+
+    return std::min(bucket, HostCompareReport::NumUlpBucket - 1);
+}
+
+struct HostCompareBlockStats
+{
+    double mSumAbsError = 0;
+    double mMaxAbsError = 0;
+    double mMaxRelError = 0;
+};
+
+// Screens n (ref, result) pairs with the test of compare_tensor, vectorized like the host GEMM
+// micro-kernels. True if every pair is finite and passes, stats then hold the errors of the
+// block. False otherwise; the caller checks the block element by element to report it.
+bool host_compare_float_block(const float* p_ref,
+                              const float* p_result,
+                              std::size_t n,
+                              double abs_tolerance,
+                              double rel_tolerance,
+                              HostCompareBlockStats& stats);
+
+inline std::vector<std::size_t> get_host_compare_multi_index(const HostTensorDescriptor& desc,
+                                                             std::size_t i)
+{
+    const auto& lengths = desc.GetLengths();
+
+    std::vector<std::size_t> index(lengths.size());
+
+    for(std::size_t d = lengths.size(); d-- > 0;)
+    {
+        index[d] = i % lengths[d];
+        i /= lengths[d];
+    }
+
+    return index;
+}
+
+// machine epsilon of the element type, 0 for integers
+template <typename T>
+double get_host_compare_epsilon()
+{
+    if constexpr(std::is_same<T, ushort>::value)
+        return std::ldexp(1.0, -7); // bf16
+    else if constexpr(std::is_integral<T>::value)
+        return 0;
+    else if constexpr(sizeof(T) == 2)
+        return std::ldexp(1.0, -10); // half_t
+    else if constexpr(sizeof(T) == 4)
+        return std::ldexp(1.0, -23);
+    else
+        return std::ldexp(1.0, -52);
+}
+
+// largest finite |x| of the tensor
+template <typename T>
+double get_host_compare_max_abs(const Tensor<T>& tensor, std::size_t num_thread)
+{
+    const auto& desc = tensor.mDesc;
+
+    // a packed tensor has no storage outside its elements
+    const bool packed = desc.GetElementSpace() == desc.GetElementSize();
+
+    std::mutex max_mutex;
+    double max_abs = 0;
+
+    auto f_chunk = [&](std::size_t begin, std::size_t end) {
+        double local = 0;
+
+        // half_t and bf16 are widened in bulk, a per-element half_t cast is a library call
+        if constexpr(std::is_same<T, ck::half_t>::value || std::is_same<T, ushort>::value)
+        {
+            if(packed)
+            {
+                constexpr std::size_t BlockSize = 256;
+
+                float block[BlockSize];
+
+                for(std::size_t i0 = begin; i0 < end; i0 += BlockSize)
+                {
+                    const std::size_t len = std::min(BlockSize, end - i0);
+
+                    if constexpr(std::is_same<T, ushort>::value)
+                        host_convert_bf16_to_float(tensor.mData.data() + i0, block, len);
+                    else
+                        host_convert_half_to_float(tensor.mData.data() + i0, block, len);
+
+                    for(std::size_t j = 0; j < len; ++j)
+                    {
+                        const double x = std::abs(block[j]);
+
+                        if(std::isfinite(x))
+                            local = std::max(local, x);
+                    }
+                }
+
+                begin = end;
+            }
+        }
+
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            std::size_t offset = i;
+
+            if(!packed)
+            {
+                const auto index   = get_host_compare_multi_index(desc, i);
+                const auto& stride = desc.GetStrides();
+
+                offset = 0;
+
+                for(std::size_t d = 0; d < index.size(); ++d)
+                    offset += index[d] * stride[d];
+            }
+
+            const double x = std::abs(host_compare_to_double(tensor.mData[offset]));
+
+            if(std::isfinite(x))
+                local = std::max(local, x);
+        }
+
+        std::lock_guard<std::mutex> lock(max_mutex);
+
+        max_abs = std::max(max_abs, local);
+    };
+
+    HostThreadPool::GetInstance().ParallelFor(desc.GetElementSize(), f_chunk, num_thread);
+
+    return max_abs;
+}
+
+template <typename T>
+HostCompareReport compare_tensor(const Tensor<T>& ref,
+                                 const Tensor<T>& result,
+                                 const HostCompareOptions& options =
+                                     get_default_host_compare_options<T>())
+{
+    const auto& lengths = ref.mDesc.GetLengths();
+
+    if(lengths != result.mDesc.GetLengths())
+    {
+        throw std::runtime_error("wrong! compared tensors have different lengths");
+    }
+
+    const auto& ref_strides    = ref.mDesc.GetStrides();
+    const auto& result_strides = result.mDesc.GetStrides();
+
+    const std::size_t num_dim     = lengths.size();
+    const std::size_t num_element = ref.mDesc.GetElementSize();
+
+    // with equal strides and a contiguous innermost dimension runs are plain contiguous loops
+    const bool same_strides = ref_strides == result_strides;
+
+    double abs_tolerance = options.mAbsTolerance;
+
+    if(options.mSumLength > 0)
+    {
+        abs_tolerance = std::max(abs_tolerance,
+                                 std::sqrt(static_cast<double>(options.mSumLength)) *
+                                     get_host_compare_epsilon<T>() *
+                                     get_host_compare_max_abs(ref, options.mNumThread));
+    }
+
+    HostCompareReport report;
+    report.mNumElement = num_element;
+
+    std::mutex report_mutex;
+    std::atomic<bool> stop{false};
+
+    auto f_chunk = [&](std::size_t begin, std::size_t end) {
+        if(options.mStopAtFirstFailure && stop.load())
+            return;
+
+        HostCompareReport local;
+
+        std::vector<std::size_t> index = get_host_compare_multi_index(ref.mDesc, begin);
+
+        std::size_t ref_offset = 0, result_offset = 0;
+
+        for(std::size_t d = 0; d < num_dim; ++d)
+        {
+            ref_offset += index[d] * ref_strides[d];
+            result_offset += index[d] * result_strides[d];
+        }
+
+        std::size_t max_abs_i = begin;
+
+        auto f_element = [&](std::size_t i, T ref_x, T result_x) {
+            const double r = host_compare_to_double(ref_x);
+            const double x = host_compare_to_double(result_x);
+
+            const bool r_nan = std::isnan(r);
+            const bool x_nan = std::isnan(x);
+            const bool r_inf = std::isinf(r);
+            const bool x_inf = std::isinf(x);
+
+            local.mNumRefNan += r_nan;
+            local.mNumResultNan += x_nan;
+            local.mNumRefInf += r_inf;
+            local.mNumResultInf += x_inf;
+
+            bool pass;
+            double abs_error = 0;
+
+            if(r_nan || x_nan || r_inf || x_inf)
+            {
+                pass = (r_nan && x_nan) || (!r_nan && !x_nan && r == x);
+
+                local.mUlpHistogram[pass ? 0 : HostCompareReport::NumUlpBucket - 1]++;
+            }
+            else
+            {
+                abs_error = std::abs(x - r);
+
+                const double rel_error = r != 0 ? abs_error / std::abs(r) : abs_error;
+
+                pass = abs_error <= abs_tolerance + options.mRelTolerance * std::abs(r);
+
+                const std::int64_t ulp =
+                    host_compare_ulp_position(result_x) - host_compare_ulp_position(ref_x);
+
+                local.mUlpHistogram[get_host_compare_ulp_bucket(
+                    static_cast<std::uint64_t>(ulp < 0 ? -ulp : ulp))]++;
+
+                local.mSumAbsError += abs_error;
+                local.mMaxRelError = std::max(local.mMaxRelError, rel_error);
+
+                if(abs_error > local.mMaxAbsError)
+                {
+                    local.mMaxAbsError       = abs_error;
+                    local.mMaxAbsErrorRef    = r;
+                    local.mMaxAbsErrorResult = x;
+                    max_abs_i                = i;
+                }
+            }
+
+            if(!pass)
+            {
+                if(local.mMismatches.size() < options.mMaxNumMismatchReported)
+                {
+                    local.mMismatches.push_back(
+                        {get_host_compare_multi_index(ref.mDesc, i), r, x});
+                }
+
+                local.mNumMismatch++;
+            }
+        };
+
+        // screens a contiguous float, half_t or bf16 run block by block
+        auto f_float_run = [&](std::size_t i, const T* p_ref, const T* p_result, std::size_t n) {
+            constexpr std::size_t BlockSize = 256;
+
+            float ref_block[BlockSize];
+            float result_block[BlockSize];
+
+            for(std::size_t j0 = 0; j0 < n; j0 += BlockSize)
+            {
+                const std::size_t len = std::min(BlockSize, n - j0);
+
+                const float* p_r = ref_block;
+                const float* p_x = result_block;
+
+                if constexpr(std::is_same<T, float>::value)
+                {
+                    p_r = p_ref + j0;
+                    p_x = p_result + j0;
+                }
+                else if constexpr(std::is_same<T, ushort>::value)
+                {
+                    host_convert_bf16_to_float(p_ref + j0, ref_block, len);
+                    host_convert_bf16_to_float(p_result + j0, result_block, len);
+                }
+                else if constexpr(std::is_same<T, ck::half_t>::value)
+                {
+                    host_convert_half_to_float(p_ref + j0, ref_block, len);
+                    host_convert_half_to_float(p_result + j0, result_block, len);
+                }
+
+                HostCompareBlockStats stats;
+
+                if(!host_compare_float_block(
+                       p_r, p_x, len, abs_tolerance, options.mRelTolerance, stats))
+                {
+                    for(std::size_t j = 0; j < len; ++j)
+                        f_element(i + j0 + j, p_ref[j0 + j], p_result[j0 + j]);
+
+                    continue;
+                }
+
+                local.mSumAbsError += stats.mSumAbsError;
+                local.mMaxRelError = std::max(local.mMaxRelError, stats.mMaxRelError);
+
+                // the first element with the largest error, as f_element picks it
+                for(std::size_t j = 0; j < len && stats.mMaxAbsError > local.mMaxAbsError; ++j)
+                {
+                    const double r = p_r[j];
+                    const double x = p_x[j];
+
+                    if(std::abs(x - r) == stats.mMaxAbsError)
+                    {
+                        local.mMaxAbsError       = stats.mMaxAbsError;
+                        local.mMaxAbsErrorRef    = r;
+                        local.mMaxAbsErrorResult = x;
+                        max_abs_i                = i + j0 + j;
+                    }
+                }
+
+                for(std::size_t j = 0; j < len; ++j)
+                {
+                    const std::int64_t ulp = host_compare_ulp_position(p_result[j0 + j]) -
+                                             host_compare_ulp_position(p_ref[j0 + j]);
+
+                    local.mUlpHistogram[get_host_compare_ulp_bucket(
+                        static_cast<std::uint64_t>(ulp < 0 ? -ulp : ulp))]++;
+                }
+            }
+        };
+
+        const std::size_t inner_length = num_dim == 0 ? 1 : lengths[num_dim - 1];
+
+        const std::size_t ref_inner_stride    = num_dim == 0 ? 1 : ref_strides[num_dim - 1];
+        const std::size_t result_inner_stride = num_dim == 0 ? 1 : result_strides[num_dim - 1];
+
+        std::size_t i = begin;
+
+        while(i < end)
+        {
+            // run along the innermost dimension, short enough to react to an early stop
+            const std::size_t inner = num_dim == 0 ? 0 : index[num_dim - 1];
+            const std::size_t run   = std::min({end - i, inner_length - inner, std::size_t{4096}});
+
+            const T* p_ref    = ref.mData.data() + ref_offset;
+            const T* p_result = result.mData.data() + result_offset;
+
+            if(same_strides && ref_inner_stride == 1)
+            {
+                if constexpr(std::is_same<T, float>::value || std::is_same<T, ck::half_t>::value ||
+                             std::is_same<T, ushort>::value)
+                {
+                    f_float_run(i, p_ref, p_result, run);
+                }
+                else
+                {
+                    for(std::size_t j = 0; j < run; ++j)
+                        f_element(i + j, p_ref[j], p_result[j]);
+                }
+            }
+            else
+            {
+                for(std::size_t j = 0; j < run; ++j)
+                    f_element(
+                        i + j, p_ref[j * ref_inner_stride], p_result[j * result_inner_stride]);
+            }
+
+            i += run;
+            local.mNumChecked += run;
+
+            if(options.mStopAtFirstFailure && (local.mNumMismatch != 0 || stop.load()))
+            {
+                stop.store(true);
+                local.mStoppedEarly = i < end;
+                break;
+            }
+
+            if(i == end || num_dim == 0)
+                break;
+
+            // carry into the outer dimensions
+            ref_offset += run * ref_inner_stride;
+            result_offset += run * result_inner_stride;
+            index[num_dim - 1] += run;
+
+            for(std::size_t d = num_dim - 1; d > 0 && index[d] == lengths[d]; --d)
+            {
+                ref_offset -= lengths[d] * ref_strides[d];
+                result_offset -= lengths[d] * result_strides[d];
+                index[d] = 0;
+
+                ref_offset += ref_strides[d - 1];
+                result_offset += result_strides[d - 1];
+                ++index[d - 1];
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(report_mutex);
+
+        report.mNumChecked += local.mNumChecked;
+        report.mNumMismatch += local.mNumMismatch;
+        report.mNumRefNan += local.mNumRefNan;
+        report.mNumResultNan += local.mNumResultNan;
+        report.mNumRefInf += local.mNumRefInf;
+        report.mNumResultInf += local.mNumResultInf;
+        report.mSumAbsError += local.mSumAbsError;
+        report.mMaxRelError = std::max(report.mMaxRelError, local.mMaxRelError);
+        report.mStoppedEarly |= local.mStoppedEarly;
+
+        if(local.mMaxAbsError > report.mMaxAbsError ||
+           (report.mMaxAbsErrorIndex.empty() && local.mNumChecked != 0))
+        {
+            report.mMaxAbsError       = local.mMaxAbsError;
+            report.mMaxAbsErrorRef    = local.mMaxAbsErrorRef;
+            report.mMaxAbsErrorResult = local.mMaxAbsErrorResult;
+            report.mMaxAbsErrorIndex  = get_host_compare_multi_index(ref.mDesc, max_abs_i);
+        }
+
+        for(std::size_t b = 0; b < HostCompareReport::NumUlpBucket; ++b)
+            report.mUlpHistogram[b] += local.mUlpHistogram[b];
+
+        report.mMismatches.insert(
+            report.mMismatches.end(), local.mMismatches.begin(), local.mMismatches.end());
+    };
+
+    HostThreadPool::GetInstance().ParallelFor(num_element, f_chunk, options.mNumThread);
+
+    // chunks finish in any order
+    std::sort(report.mMismatches.begin(),
+              report.mMismatches.end(),
+              [](const HostCompareMismatch& a, const HostCompareMismatch& b) {
+                  return a.mIndex < b.mIndex;
+              });
+
+    if(report.mMismatches.size() > options.mMaxNumMismatchReported)
+        report.mMismatches.resize(options.mMaxNumMismatchReported);
+
+    report.mStoppedEarly = report.mStoppedEarly || report.mNumChecked < num_element;
+
+    return report;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const HostCompareReport& report)
+{
+    auto f_index = [&](const std::vector<std::size_t>& index) {
+        os << "(";
+        LogRange(os, index, ", ");
+        os << ")";
+    };
+
+    os << "error: " << report.mSumAbsError << std::endl;
+    os << "max_diff: " << report.mMaxAbsError << ", " << report.mMaxAbsErrorRef << ", "
+       << report.mMaxAbsErrorResult << " at ";
+    f_index(report.mMaxAbsErrorIndex);
+    os << std::endl;
+
+    os << "max_rel_diff: " << report.mMaxRelError << std::endl;
+    os << "mismatch: " << report.mNumMismatch << " / " << report.mNumChecked;
+
+    if(report.mStoppedEarly)
+        os << " (stopped early, " << report.mNumElement << " elements)";
+
+    os << std::endl;
+
+    if(report.mNumRefNan + report.mNumResultNan + report.mNumRefInf + report.mNumResultInf != 0)
+    {
+        os << "nan: " << report.mNumRefNan << ", " << report.mNumResultNan
+           << ", inf: " << report.mNumRefInf << ", " << report.mNumResultInf << std::endl;
+    }
+
+    os << "ulp:";
+
+    for(std::size_t b = 0; b < HostCompareReport::NumUlpBucket; ++b)
+    {
+        if(report.mUlpHistogram[b] == 0)
+            continue;
+
+        if(b == 0)
+            os << " [0]";
+        else if(b + 1 == HostCompareReport::NumUlpBucket)
+            os << " [>=" << (std::uint64_t{1} << (b - 1)) << "]";
+        else
+            os << " [" << (std::uint64_t{1} << (b - 1)) << ", " << (std::uint64_t{1} << b) << ")";
+
+        os << " " << report.mUlpHistogram[b];
+    }
+
+    os << std::endl;
+
+    for(const auto& mismatch : report.mMismatches)
+    {
+        os << "mismatch at ";
+        f_index(mismatch.mIndex);
+        os << ": " << mismatch.mRef << ", " << mismatch.mResult << std::endl;
+    }
+
+    return os;
+}
+
+template <typename T>
+bool check_error(const Tensor<T>& ref,
+                 const Tensor<T>& result,
+                 const HostCompareOptions& options = get_default_host_compare_options<T>())
+{
+    const auto report = compare_tensor(ref, result, options);
+
+    std::cout << report;
+
+    return report.Pass();
+}
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef HOST_TENSOR_CONVERT_HPP
+#define HOST_TENSOR_CONVERT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "data_type.hpp"
+#include "host_tensor.hpp"
+
+// Bulk conversion between ck::half_t / bf16 and float on the host. bf16 is stored as ushort.
+//
+// A per-element static_cast of half_t is a library call unless the caller is compiled for F16C.
+// These routines convert whole vectors with vcvtph2ps / vcvtps2ph (AVX-512 or AVX2 + F16C,
+// picked at runtime like the GEMM micro-kernels), float -> half_t rounds to nearest even, NaN
+// stays NaN. Both directions are exact inverses for every finite half_t value.
+//
+// float -> bf16 rounds to nearest even (as ck::type_convert<ushort>) or truncates. NaN stays NaN
+// in both modes: a NaN whose payload only sits in the dropped bits keeps a payload bit. Nearest
+// even uses vcvtneps2bf16 on AVX-512 BF16 hosts, integer rounding on whole vectors otherwise,
+// both give the same bits.
+
+enum class HostBf16Rounding_t
+{
+    NearestEven = 0,
+    Truncate    = 1,
+};
+
+inline ushort host_float_to_bf16(float x,
+                                 HostBf16Rounding_t rounding = HostBf16Rounding_t::NearestEven)
+{
+    union
+    {
+        float fp32;
+        uint32_t int32;
+    } u = {x};
+
+    if(~u.int32 & 0x7f800000)
+    {
+        // zero, normal or subnormal
+        if(rounding == HostBf16Rounding_t::NearestEven)
+            u.int32 += 0x7fff + ((u.int32 >> 16) & 1);
+    }
+    else if(u.int32 & 0xffff)
+    {
+        // NaN with payload in the low half only, keep it a NaN
+        u.int32 |= 0x10000;
+    }
+
+    return uint16_t(u.int32 >> 16);
+}
+
+// static_cast that treats ushort as bf16
+template <typename Y, typename X>
+Y host_type_convert(X x)
+{
+    if constexpr(std::is_same<X, Y>::value)
+        return x;
+    else if constexpr(std::is_same<X, ushort>::value)
+        return static_cast<Y>(bf16_to_f32_(x));
+    else if constexpr(std::is_same<Y, ushort>::value)
+        return host_float_to_bf16(static_cast<float>(x));
+    else
+        return static_cast<Y>(x);
+}
+
+void host_convert_half_to_float(const ck::half_t* p_src, float* p_dst, std::size_t n);
+
+void host_convert_float_to_half(const float* p_src, ck::half_t* p_dst, std::size_t n);
+
+void host_convert_bf16_to_float(const ushort* p_src, float* p_dst, std::size_t n);
+
+void host_convert_float_to_bf16(const float* p_src,
+                                ushort* p_dst,
+                                std::size_t n,
+                                HostBf16Rounding_t rounding = HostBf16Rounding_t::NearestEven);
+
+// p_dst[i * dst_stride] = TDst(op(p_src[i * src_stride])) for i < n, with host_type_convert.
+// half_t and bf16 sources are widened to float first, op then sees float values. Contiguous
+// sources are widened, and bf16 results narrowed, in bulk.
+template <typename TDst, typename TSrc, typename ElementwiseOperation>
+void host_convert_elementwise(TDst* p_dst,
+                              std::size_t dst_stride,
+                              const TSrc* p_src,
+                              std::size_t src_stride,
+                              std::size_t n,
+                              const ElementwiseOperation& op)
+{
+    constexpr bool from_half = std::is_same<TSrc, ck::half_t>::value;
+    constexpr bool from_bf16 = std::is_same<TSrc, ushort>::value;
+    constexpr bool to_bf16   = std::is_same<TDst, ushort>::value;
+
+    if constexpr(from_half || from_bf16 || to_bf16)
+    {
+        if(src_stride == 1)
+        {
+            constexpr std::size_t ChunkSize = 256;
+
+            float chunk[ChunkSize];
+
+            for(std::size_t i0 = 0; i0 < n; i0 += ChunkSize)
+            {
+                const std::size_t len = std::min(ChunkSize, n - i0);
+
+                if constexpr(from_half)
+                    host_convert_half_to_float(p_src + i0, chunk, len);
+                else if constexpr(from_bf16)
+                    host_convert_bf16_to_float(p_src + i0, chunk, len);
+
+                auto f_src = [&](std::size_t i) {
+                    if constexpr(from_half || from_bf16)
+                        return chunk[i];
+                    else
+                        return p_src[i0 + i];
+                };
+
+                if constexpr(to_bf16)
+                {
+                    ushort narrow[ChunkSize];
+
+                    for(std::size_t i = 0; i < len; ++i)
+                        chunk[i] = host_type_convert<float>(op(f_src(i)));
+
+                    host_convert_float_to_bf16(chunk, narrow, len);
+
+                    for(std::size_t i = 0; i < len; ++i)
+                        p_dst[(i0 + i) * dst_stride] = narrow[i];
+                }
+                else
+                {
+                    for(std::size_t i = 0; i < len; ++i)
+                        p_dst[(i0 + i) * dst_stride] = host_type_convert<TDst>(op(f_src(i)));
+                }
+            }
+
+            return;
+        }
+    }
+
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        if constexpr(from_half || from_bf16)
+            p_dst[i * dst_stride] =
+                host_type_convert<TDst>(op(host_type_convert<float>(p_src[i * src_stride])));
+        else
+            p_dst[i * dst_stride] = host_type_convert<TDst>(op(p_src[i * src_stride]));
+    }
+}
+
+// y = TDst(x) element-wise with host_type_convert, x and y have the same lengths. Tensors with the
+// same strides are converted as flat ranges, half_t / bf16 <-> float through the bulk routines.
+template <typename TDst, typename TSrc>
+void host_tensor_convert(Tensor<TDst>& y,
+                         const Tensor<TSrc>& x,
+                         std::size_t num_thread = get_host_num_threads())
+{
+    constexpr bool to_float   = std::is_same<TDst, float>::value;
+    constexpr bool from_float = std::is_same<TSrc, float>::value;
+
+    constexpr bool src_16bit =
+        std::is_same<TSrc, ck::half_t>::value || std::is_same<TSrc, ushort>::value;
+    constexpr bool dst_16bit =
+        std::is_same<TDst, ck::half_t>::value || std::is_same<TDst, ushort>::value;
+
+    constexpr bool has_bulk = (to_float && src_16bit) || (from_float && dst_16bit);
+
+    if constexpr(has_bulk)
+    {
+        if(y.mDesc.GetLengths() == x.mDesc.GetLengths() &&
+           y.mDesc.GetStrides() == x.mDesc.GetStrides())
+        {
+            HostThreadPool::GetInstance().ParallelFor(
+                x.mData.size(),
+                [&](std::size_t begin, std::size_t end) {
+                    const TSrc* p_src = x.mData.data() + begin;
+                    TDst* p_dst       = y.mData.data() + begin;
+
+                    if constexpr(std::is_same<TSrc, ck::half_t>::value)
+                        host_convert_half_to_float(p_src, p_dst, end - begin);
+                    else if constexpr(std::is_same<TSrc, ushort>::value)
+                        host_convert_bf16_to_float(p_src, p_dst, end - begin);
+                    else if constexpr(std::is_same<TDst, ck::half_t>::value)
+                        host_convert_float_to_half(p_src, p_dst, end - begin);
+                    else
+                        host_convert_float_to_bf16(p_src, p_dst, end - begin);
+                },
+                num_thread);
+
+            return;
+        }
+    }
+
+    y.Transform(x, [](TSrc v) { return host_type_convert<TDst>(v); }, num_thread);
+}
+
+// converted copy of x with the same descriptor
+template <typename TDst, typename TSrc>
+Tensor<TDst> host_tensor_convert(const Tensor<TSrc>& x,
+                                 std::size_t num_thread = get_host_num_threads())
+{
+    Tensor<TDst> y(x.mDesc, HostTensorDefaultInit{});
+
+    host_tensor_convert(y, x, num_thread);
+
+    return y;
+}
+
+#endif
@@ -0,0 +1,361 @@
+#ifndef HOST_TENSOR_FILE_HPP
+#define HOST_TENSOR_FILE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "config.hpp"
+#include "data_type.hpp"
+#include "data_type_enum.hpp"
+#include "host_tensor.hpp"
+
+// Binary tensor files and a content-addressed cache built on them.
+//
+// File layout (version 1, native byte order):
+//   char[8]       magic "CKTENSOR"
+//   uint32        version
+//   uint32        data type, ck::DataTypeEnum_t
+//   uint64        element bytes
+//   uint64        rank
+//   uint64        generator seed, 0 if the values were not generated
+//   uint64        key bytes
+//   uint64        data offset, a multiple of the page size
+//   uint64        data bytes, element space * element bytes
+//   uint64[rank]  lengths
+//   uint64[rank]  strides
+//   char[]        key
+//   zero padding up to the data offset, then the element space of the tensor
+//
+// Files are read through a read-only mapping, so HostTensorFile::GetData() can be handed to
+// DeviceMem::ToDevice() without staging the data in host memory first. Files are written to a
+// temporary name and renamed, concurrent readers never see a partial file.
+
+struct HostTensorFileHeader
+{
+    static constexpr char Magic[8]             = {'C', 'K', 'T', 'E', 'N', 'S', 'O', 'R'};
+    static constexpr std::uint32_t Version     = 1;
+    static constexpr std::size_t DataAlignment = 4096;
+
+    ck::DataTypeEnum_t mDataType = ck::DataTypeEnum_t::Unknown;
+    std::size_t mElementBytes    = 0;
+    std::uint64_t mSeed          = 0;
+    std::vector<std::size_t> mLengths;
+    std::vector<std::size_t> mStrides;
+    std::string mKey;
+    std::size_t mDataOffset = 0;
+    std::size_t mDataBytes  = 0;
+
+    HostTensorDescriptor GetDescriptor() const { return HostTensorDescriptor(mLengths, mStrides); }
+};
+
+template <typename T>
+constexpr ck::DataTypeEnum_t get_host_tensor_data_type()
+{
+    if constexpr(std::is_same<T, ck::half_t>::value)
+        return ck::DataTypeEnum_t::Half;
+    else if constexpr(std::is_same<T, float>::value)
+        return ck::DataTypeEnum_t::Float;
+    else if constexpr(std::is_same<T, int32_t>::value)
+        return ck::DataTypeEnum_t::Int32;
+    else if constexpr(std::is_same<T, int8_t>::value)
+        return ck::DataTypeEnum_t::Int8;
+    else if constexpr(std::is_same<T, ck::int8x4_t>::value)
+        return ck::DataTypeEnum_t::Int8x4;
+    else if constexpr(std::is_same<T, ushort>::value)
+        return ck::DataTypeEnum_t::BFloat16;
+    else if constexpr(std::is_same<T, double>::value)
+        return ck::DataTypeEnum_t::Double;
+    else
+        return ck::DataTypeEnum_t::Unknown;
+}
+
+// read-only mapping of a tensor file, throws if the file is missing or malformed
+struct HostTensorFile
+{
+    explicit HostTensorFile(const std::string& path);
+
+    HostTensorFile(const HostTensorFile&) = delete;
+    HostTensorFile& operator=(const HostTensorFile&) = delete;
+
+    ~HostTensorFile();
+
+    const HostTensorFileHeader& GetHeader() const { return mHeader; }
+
+    template <typename T>
+    const T* GetData() const
+    {
+        if(mHeader.mDataType != get_host_tensor_data_type<T>() ||
+           mHeader.mElementBytes != sizeof(T))
+            throw std::runtime_error("wrong! tensor file has a different data type");
+
+        return reinterpret_cast<const T*>(mBase + mHeader.mDataOffset);
+    }
+
+    private:
+    const char* mBase = nullptr;
+    std::size_t mSize = 0;
+    HostTensorFileHeader mHeader;
+};
+
+// writes header and data, streaming the data out in large chunks
+void write_host_tensor_file(const std::string& path,
+                            const HostTensorFileHeader& header,
+                            const void* p_data);
+
+template <typename T>
+void write_host_tensor_file(const std::string& path,
+                            const Tensor<T>& tensor,
+                            std::uint64_t seed     = 0,
+                            const std::string& key = "")
+{
+    static_assert(get_host_tensor_data_type<T>() != ck::DataTypeEnum_t::Unknown,
+                  "wrong! data type has no tensor file encoding");
+
+    HostTensorFileHeader header;
+
+    header.mDataType     = get_host_tensor_data_type<T>();
+    header.mElementBytes = sizeof(T);
+    header.mSeed         = seed;
+    header.mLengths      = tensor.mDesc.GetLengths();
+    header.mStrides      = tensor.mDesc.GetStrides();
+    header.mKey          = key;
+    header.mDataBytes    = tensor.mData.size() * sizeof(T);
+
+    write_host_tensor_file(path, header, tensor.mData.data());
+}
+
+// copies the mapped data into the tensor with the host thread pool, so the pages of the tensor
+// are first touched by the threads that later work on them
+template <typename T>
+void copy_host_tensor_file(const HostTensorFile& file, Tensor<T>& tensor)
+{
+    const auto& header = file.GetHeader();
+
+    if(header.mLengths != tensor.mDesc.GetLengths() ||
+       header.mStrides != tensor.mDesc.GetStrides())
+        throw std::runtime_error("wrong! tensor file has a different descriptor");
+
+    const T* p_src = file.GetData<T>();
+    T* p_dst       = tensor.mData.data();
+
+    const std::size_t chunk     = (std::size_t{1} << 20) / sizeof(T);
+    const std::size_t size      = tensor.mData.size();
+    const std::size_t num_chunk = (size + chunk - 1) / chunk;
+
+    HostThreadPool::GetInstance().ParallelFor(
+        num_chunk,
+        [&](std::size_t begin, std::size_t end) {
+            const std::size_t first = begin * chunk;
+            const std::size_t last  = std::min(end * chunk, size);
+
+            std::memcpy(p_dst + first, p_src + first, (last - first) * sizeof(T));
+        },
+        0,
+        1);
+}
+
+template <typename T>
+Tensor<T> read_host_tensor_file(const std::string& path)
+{
+    HostTensorFile file(path);
+
+    Tensor<T> tensor(file.GetHeader().GetDescriptor(), HostTensorDefaultInit{});
+
+    copy_host_tensor_file(file, tensor);
+
+    return tensor;
+}
+
+// 64-bit hash of the logical elements of a tensor, independent of strides and thread count
+template <typename T>
+std::uint64_t get_host_tensor_content_hash(const Tensor<T>& tensor)
+{
+    const std::size_t size      = tensor.mDesc.GetElementSize();
+    const std::size_t chunk     = std::size_t{1} << 16;
+    const std::size_t num_chunk = (size + chunk - 1) / chunk;
+
+    std::vector<std::uint64_t> chunk_hashes(num_chunk);
+
+    HostThreadPool::GetInstance().ParallelFor(num_chunk, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t ichunk = begin; ichunk < end; ++ichunk)
+        {
+            std::uint64_t h = ichunk;
+
+            host_tensor_for_each_run<1>(
+                tensor.mDesc.GetLengths(),
+                {&tensor.mDesc},
+                ichunk * chunk,
+                std::min(ichunk * chunk + chunk, size),
+                [&](auto offsets, auto strides, auto length) {
+                    const T* p = tensor.mData.data() + offsets[0];
+
+                    for(std::size_t i = 0; i < length; ++i)
+                    {
+                        std::uint64_t bits = 0;
+                        std::memcpy(&bits, p + i * strides[0], std::min(sizeof(T), sizeof(bits)));
+
+                        h = (h ^ bits) * 0x9E3779B97F4A7C15ull;
+                        h ^= h >> 29;
+                    }
+                });
+
+            chunk_hashes[ichunk] = h;
+        }
+    });
+
+    std::uint64_t h = 0xCBF29CE484222325ull;
+
+    for(std::uint64_t x : chunk_hashes)
+        h = (h ^ x) * 0x100000001B3ull;
+
+    return h;
+}
+
+inline std::string to_host_tensor_cache_key_string(const std::string& x) { return x; }
+
+inline std::string to_host_tensor_cache_key_string(const char* x) { return x; }
+
+template <typename X>
+std::string to_host_tensor_cache_key_string(const X& x)
+{
+    if constexpr(std::is_enum<X>::value)
+        return std::to_string(static_cast<long long>(x));
+    else
+        return std::to_string(x);
+}
+
+template <typename X>
+std::string to_host_tensor_cache_key_string(const std::vector<X>& xs)
+{
+    std::string s;
+
+    for(const auto& x : xs)
+        s += (s.empty() ? "" : ",") + to_host_tensor_cache_key_string(x);
+
+    return s;
+}
+
+inline std::string to_host_tensor_cache_key_string(const HostTensorDescriptor& desc)
+{
+    return to_host_tensor_cache_key_string(desc.GetLengths()) + ":" +
+           to_host_tensor_cache_key_string(desc.GetStrides());
+}
+
+// a tensor is keyed by data type, lengths and content
+template <typename T>
+std::string to_host_tensor_cache_key_string(const Tensor<T>& tensor)
+{
+    char hash[24];
+
+    std::snprintf(hash,
+                  sizeof(hash),
+                  "%016llx",
+                  static_cast<unsigned long long>(get_host_tensor_content_hash(tensor)));
+
+    return to_host_tensor_cache_key_string(get_host_tensor_data_type<T>()) + ":" +
+           to_host_tensor_cache_key_string(tensor.mDesc.GetLengths()) + ":" + hash;
+}
+
+// joins the arguments with '|', for building cache keys
+template <typename... Xs>
+std::string make_host_tensor_cache_key(const Xs&... xs)
+{
+    std::string key;
+
+    ((key += (key.empty() ? "" : "|") + to_host_tensor_cache_key_string(xs)), ...);
+
+    return key;
+}
+
+// Content-addressed store of tensors, for inputs and host references that are expensive to
+// recompute. A tensor is stored under a key describing how it was computed (problem, init
+// method, content hashes of the inputs, ...) and the descriptor of the tensor itself; the file
+// name is a hash of the key, the key itself is kept in the file and compared on lookup.
+// The cache is best effort: an entry that cannot be written only costs the recomputation next
+// time, and a directory that cannot be created disables caching, both with a warning.
+//
+// Environment:
+//   CK_HOST_TENSOR_CACHE: cache directory, caching is disabled if unset or empty
+struct HostTensorCache
+{
+    static HostTensorCache& GetInstance();
+
+    bool IsEnabled() const { return !mDirectory.empty(); }
+
+    std::string GetPath(const std::string& key) const;
+
+    // Fills the tensor from the cache entry for the key returned by f_key() and the descriptor of
+    // the tensor, or calls f_create(tensor) and stores the result. f_key() is only called if
+    // caching is enabled, so it may hash the inputs. Returns whether the tensor came from the
+    // cache.
+    template <typename T, typename KeyFunction, typename CreateFunction>
+    bool GetOrCreate(Tensor<T>& tensor, KeyFunction f_key, CreateFunction f_create)
+    {
+        if(!IsEnabled())
+        {
+            f_create(tensor);
+            return false;
+        }
+
+        // outputs that only differ in their strides hold different elements
+        const std::string key  = make_host_tensor_cache_key(f_key(), tensor.mDesc);
+        const std::string path = GetPath(key);
+
+        if(TryOpen(path, key, [&](const HostTensorFile& file) {
+               const auto& header = file.GetHeader();
+
+               if(header.mDataType != get_host_tensor_data_type<T>() ||
+                  header.mLengths != tensor.mDesc.GetLengths() ||
+                  header.mStrides != tensor.mDesc.GetStrides())
+                   return false;
+
+               copy_host_tensor_file(file, tensor);
+               return true;
+           }))
+        {
+            return true;
+        }
+
+        f_create(tensor);
+
+        try
+        {
+            write_host_tensor_file(path, tensor, 0, key);
+        }
+        catch(const std::exception& e)
+        {
+            std::cerr << "Host tensor cache: cannot store entry, " << e.what() << std::endl;
+        }
+
+        return false;
+    }
+
+    private:
+    explicit HostTensorCache(std::string directory);
+
+    // opens the entry and calls f_use(file) if it exists and was stored under this key
+    template <typename F>
+    bool TryOpen(const std::string& path, const std::string& key, F f_use) const
+    {
+        try
+        {
+            HostTensorFile file(path);
+
+            return file.GetHeader().mKey == key && f_use(file);
+        }
+        catch(const std::exception&)
+        {
+            // missing or unreadable entries are recomputed and overwritten
+            return false;
+        }
+    }
+
+    std::string mDirectory;
+};
+
+#endif
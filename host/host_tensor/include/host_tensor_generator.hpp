@@ -1,10 +1,93 @@
 #ifndef HOST_TENSOR_GENERATOR_HPP
 #define HOST_TENSOR_GENERATOR_HPP
 
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
 #include "config.hpp"
 #include "data_type.hpp"
 
+// Random generators are counter based: every value is a pure function of (seed, multi-index),
+// computed with Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+// Generation needs no shared state, so it is lock-free and the tensor contents do not depend on
+// the number of threads or the order in which elements are visited.
+//
+// A generator constructed without an explicit seed uses get_host_generator_seed(), i.e. stream 0
+// of CK_HOST_SEED (default 0), so constructing one writes no shared state and a run is
+// reproducible. Tensors that need independent values pass their own stream, e.g.
+// GeneratorTensor_2<T>{-5, 5, get_host_generator_seed(1)}.
+
+// seed of the given stream, distinct streams give independent values
+inline std::uint64_t get_host_generator_seed(std::uint64_t stream = 0)
+{
+    static const std::uint64_t base_seed = [] {
+        const char* env = std::getenv("CK_HOST_SEED");
+
+        return env == nullptr || *env == '\0' ? std::uint64_t{0}
+                                              : static_cast<std::uint64_t>(std::stoull(env));
+    }();
+
+    return base_seed + stream * 0x9E3779B97F4A7C15ull;
+}
+
+struct HostPhilox4x32
+{
+    using Counter = std::array<std::uint32_t, 4>;
+
+    static Counter Generate(std::uint64_t seed, Counter ctr)
+    {
+        std::uint32_t key0 = static_cast<std::uint32_t>(seed);
+        std::uint32_t key1 = static_cast<std::uint32_t>(seed >> 32);
+
+        for(int round = 0; round < 10; ++round)
+        {
+            const std::uint64_t prod0 = std::uint64_t{0xD2511F53} * ctr[0];
+            const std::uint64_t prod1 = std::uint64_t{0xCD9E8D57} * ctr[2];
+
+            ctr = {static_cast<std::uint32_t>(prod1 >> 32) ^ ctr[1] ^ key0,
+                   static_cast<std::uint32_t>(prod1),
+                   static_cast<std::uint32_t>(prod0 >> 32) ^ ctr[3] ^ key1,
+                   static_cast<std::uint32_t>(prod0)};
+
+            key0 += 0x9E3779B9;
+            key1 += 0xBB67AE85;
+        }
+
+        return ctr;
+    }
+
+    // the first four indices fill one counter lane each, higher ranks are folded into the last
+    template <typename... Is>
+    static Counter MakeCounter(Is... is)
+    {
+        Counter ctr{0, 0, 0, 0};
+
+        std::size_t d = 0;
+
+        for(std::uint64_t i : {static_cast<std::uint64_t>(is)...})
+        {
+            if(d < 4)
+                ctr[d++] = static_cast<std::uint32_t>(i);
+            else
+                ctr[3] = ctr[3] * 0x9E3779B1u + static_cast<std::uint32_t>(i) + 1;
+        }
+
+        return ctr;
+    }
+
+    // uniform in [0, 1) with 24 random bits
+    static float ToUniform(std::uint32_t x) { return (x >> 8) * (1.0f / 16777216.0f); }
+};
+
+// convert a generated value to the element type, bf16 is stored as ushort
+template <typename T>
+T host_generator_cast(float x)
+{
+    return ck::type_convert<T>(x);
+}
+
 template <typename T>
 struct GeneratorTensor_0
 {
@@ -51,91 +134,182 @@ struct GeneratorTensor_1<int8_t>
     }
 };
 
+// integers uniformly distributed in [min_value, max_value)
 template <typename T>
 struct GeneratorTensor_2
 {
-    int min_value = 0;
-    int max_value = 1;
+    int min_value      = 0;
+    int max_value      = 1;
+    std::uint64_t seed = get_host_generator_seed();
 
     template <typename... Is>
-    T operator()(Is...)
+    T operator()(Is... is) const
     {
-        return (std::rand() % (max_value - min_value)) + min_value;
+        const auto r = HostPhilox4x32::Generate(seed, HostPhilox4x32::MakeCounter(is...));
+
+        const std::uint64_t range = static_cast<std::uint64_t>(max_value - min_value);
+
+        // multiply-shift maps 32 random bits onto [0, range)
+        const int v = min_value + static_cast<int>((std::uint64_t{r[0]} * range) >> 32);
+
+        return host_generator_cast<T>(static_cast<float>(v));
     }
 };
 
 template <>
-struct GeneratorTensor_2<ushort>
+struct GeneratorTensor_2<int8_t>
 {
-    int min_value = 0;
-    int max_value = 1;
+    int min_value      = 0;
+    int max_value      = 1;
+    std::uint64_t seed = get_host_generator_seed();
 
     template <typename... Is>
-    ushort operator()(Is...)
+    int8_t operator()(Is... is) const
     {
-        float tmp = (std::rand() % (max_value - min_value)) + min_value;
-        return ck::type_convert<ushort>(tmp);
+        const auto r = HostPhilox4x32::Generate(seed, HostPhilox4x32::MakeCounter(is...));
+
+        const std::uint64_t range = static_cast<std::uint64_t>(max_value - min_value);
+
+        return static_cast<int8_t>(min_value +
+                                   static_cast<int>((std::uint64_t{r[0]} * range) >> 32));
     }
 };
 
 template <>
-struct GeneratorTensor_2<int8_t>
+struct GeneratorTensor_2<int32_t>
 {
-    int min_value = 0;
-    int max_value = 1;
+    int min_value      = 0;
+    int max_value      = 1;
+    std::uint64_t seed = get_host_generator_seed();
 
     template <typename... Is>
-    int8_t operator()(Is...)
+    int32_t operator()(Is... is) const
     {
-        return (std::rand() % (max_value - min_value)) + min_value;
+        const auto r = HostPhilox4x32::Generate(seed, HostPhilox4x32::MakeCounter(is...));
+
+        const std::uint64_t range = static_cast<std::uint64_t>(max_value - min_value);
+
+        return min_value + static_cast<int32_t>((std::uint64_t{r[0]} * range) >> 32);
     }
 };
 
-template <typename T>
-struct GeneratorTensor_3
+template <>
+struct GeneratorTensor_2<ck::int8x4_t>
 {
-    T min_value = 0;
-    T max_value = 1;
+    int min_value      = 0;
+    int max_value      = 1;
+    std::uint64_t seed = get_host_generator_seed();
 
     template <typename... Is>
-    T operator()(Is...)
+    ck::int8x4_t operator()(Is... is) const
     {
-        float tmp = float(std::rand()) / float(RAND_MAX);
+        const auto r = HostPhilox4x32::Generate(seed, HostPhilox4x32::MakeCounter(is...));
 
-        return min_value + tmp * (max_value - min_value);
+        const std::uint64_t range = static_cast<std::uint64_t>(max_value - min_value);
+
+        auto f_lane = [&](std::uint32_t x) {
+            return static_cast<int8_t>(min_value +
+                                       static_cast<int>((std::uint64_t{x} * range) >> 32));
+        };
+
+        return ck::int8x4_t{f_lane(r[0]), f_lane(r[1]), f_lane(r[2]), f_lane(r[3])};
     }
 };
 
-template <>
-struct GeneratorTensor_3<ushort>
+// reals uniformly distributed in [min_value, max_value)
+template <typename T>
+struct GeneratorTensor_3
 {
-    float min_value = 0;
-    float max_value = 1;
+    float min_value    = 0;
+    float max_value    = 1;
+    std::uint64_t seed = get_host_generator_seed();
 
     template <typename... Is>
-    ushort operator()(Is...)
+    T operator()(Is... is) const
     {
-        float tmp = float(std::rand()) / float(RAND_MAX);
+        const auto r = HostPhilox4x32::Generate(seed, HostPhilox4x32::MakeCounter(is...));
 
-        float fp32_tmp = min_value + tmp * (max_value - min_value);
+        const float tmp = HostPhilox4x32::ToUniform(r[0]);
 
-        return ck::type_convert<ushort>(fp32_tmp);
+        return host_generator_cast<T>(min_value + tmp * (max_value - min_value));
     }
 };
 
 template <>
 struct GeneratorTensor_3<int8_t>
 {
-    float min_value = 0;
-    float max_value = 1;
+    float min_value    = 0;
+    float max_value    = 1;
+    std::uint64_t seed = get_host_generator_seed();
 
     template <typename... Is>
-    int8_t operator()(Is...)
+    int8_t operator()(Is... is) const
+    {
+        // integers in [min_value, max_value), as before
+        return GeneratorTensor_2<int8_t>{
+            static_cast<int8_t>(min_value), static_cast<int8_t>(max_value), seed}(is...);
+    }
+};
+
+// normal distribution, values beyond truncation * stddev from the mean are redrawn
+// (truncation <= 0 disables truncation)
+template <typename T>
+struct GeneratorTensor_Normal
+{
+    float mean         = 0;
+    float stddev       = 1;
+    float truncation   = 0;
+    std::uint64_t seed = get_host_generator_seed();
+
+    template <typename... Is>
+    T operator()(Is... is) const
     {
-        int8_t min_tmp = static_cast<int8_t>(min_value);
-        int8_t max_tmp = static_cast<int8_t>(max_value);
+        const auto ctr = HostPhilox4x32::MakeCounter(is...);
+
+        float z = 0;
+
+        // each attempt draws four uniforms, i.e. two Box-Muller pairs
+        for(std::uint64_t attempt = 0; attempt < 16; ++attempt)
+        {
+            const auto r = HostPhilox4x32::Generate(seed + attempt * 0x9E3779B97F4A7C15ull, ctr);
+
+            bool found = false;
+
+            for(int j = 0; j < 4 && !found; j += 2)
+            {
+                // 1 - u is in (0, 1], keeps log away from zero
+                const float u0 = 1.0f - HostPhilox4x32::ToUniform(r[j]);
+                const float u1 = HostPhilox4x32::ToUniform(r[j + 1]);
+
+                z = std::sqrt(-2.0f * std::log(u0)) * std::cos(6.283185307179586f * u1);
+
+                found = truncation <= 0 || std::abs(z) <= truncation;
+            }
+
+            if(found)
+                break;
 
-        return (std::rand() % (max_tmp - min_tmp)) + min_tmp;
+            // give up redrawing, clamp instead
+            if(attempt == 15)
+                z = std::min(std::max(z, -truncation), truncation);
+        }
+
+        return host_generator_cast<T>(mean + stddev * z);
+    }
+};
+
+// truncated normal with the usual two standard deviation cut-off
+template <typename T>
+struct GeneratorTensor_TruncatedNormal
+{
+    float mean         = 0;
+    float stddev       = 1;
+    std::uint64_t seed = get_host_generator_seed();
+
+    template <typename... Is>
+    T operator()(Is... is) const
+    {
+        return GeneratorTensor_Normal<T>{mean, stddev, 2.0f, seed}(is...);
     }
 };
 
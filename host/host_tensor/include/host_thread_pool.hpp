@@ -0,0 +1,80 @@
+#ifndef HOST_THREAD_POOL_HPP
+#define HOST_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Process-wide pool of persistent host worker threads.
+//
+// ParallelFor() splits [0, n) into one contiguous range per participating thread. Each thread
+// takes grain-sized chunks from its own range first and then steals chunks from the ranges of
+// the other threads, so imbalanced work items do not leave threads idle. The calling thread
+// always participates. Calls made from inside a running job execute serially on the caller.
+//
+// Environment:
+//   CK_HOST_NUM_THREADS: number of threads (including the caller), default hardware_concurrency
+//   CK_HOST_PIN_THREADS: if non-zero, pin thread i to the i-th CPU of the process affinity mask
+struct HostThreadPool
+{
+    using RangeFunction = std::function<void(std::size_t, std::size_t)>;
+
+    static HostThreadPool& GetInstance();
+
+    std::size_t GetNumThreads() const { return mNumThread; }
+
+    // grain_size 0 picks a grain that gives every thread several chunks to steal
+    void ParallelFor(std::size_t n,
+                     const RangeFunction& f,
+                     std::size_t num_thread = 0,
+                     std::size_t grain_size = 0);
+
+    HostThreadPool(const HostThreadPool&) = delete;
+    HostThreadPool& operator=(const HostThreadPool&) = delete;
+
+    ~HostThreadPool();
+
+    private:
+    HostThreadPool(std::size_t num_thread, bool pin_thread);
+
+    void WorkerLoop(std::size_t id);
+
+    void RunSlot(std::size_t id);
+
+    struct alignas(64) WorkRange
+    {
+        std::atomic<std::size_t> mNext{0};
+        std::size_t mEnd = 0;
+    };
+
+    std::size_t mNumThread;
+    bool mPinThread;
+
+    std::vector<std::thread> mWorkers;
+    std::unique_ptr<WorkRange[]> mRanges;
+
+    // serializes jobs submitted from different application threads
+    std::mutex mSubmitMutex;
+
+    std::mutex mMutex;
+    std::condition_variable mWakeCondition;
+    std::condition_variable mDoneCondition;
+    std::size_t mGeneration = 0;
+    std::size_t mNumPending = 0;
+    bool mStop              = false;
+
+    // current job
+    const RangeFunction* mJob = nullptr;
+    std::size_t mJobNumThread = 0;
+    std::size_t mJobGrainSize = 1;
+    std::exception_ptr mJobException;
+};
+
+inline std::size_t get_host_num_threads() { return HostThreadPool::GetInstance().GetNumThreads(); }
+
+#endif
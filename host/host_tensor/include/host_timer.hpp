@@ -0,0 +1,49 @@
+#ifndef HOST_TIMER_HPP
+#define HOST_TIMER_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "timing_stats.hpp"
+
+// wall-clock counterpart of KernelTimer for operations that run on the host
+struct HostTimer
+{
+    void Start() { mStart = std::chrono::steady_clock::now(); }
+
+    void End() { mEnd = std::chrono::steady_clock::now(); }
+
+    // milliseconds
+    float GetElapsedTime() const
+    {
+        return std::chrono::duration<float, std::milli>(mEnd - mStart).count();
+    }
+
+    std::chrono::steady_clock::time_point mStart, mEnd;
+};
+
+// host counterpart of launch_and_time_kernel, each run of f() is timed on its own
+template <typename F>
+float launch_and_time_host_kernel(F f, int nrepeat)
+{
+    HostTimer timer;
+
+    return time_runs(f,
+                     [&](int num_run) {
+                         std::vector<float> samples(num_run);
+
+                         for(int i = 0; i < num_run; ++i)
+                         {
+                             timer.Start();
+                             f();
+                             timer.End();
+
+                             samples[i] = timer.GetElapsedTime();
+                         }
+
+                         return samples;
+                     },
+                     nrepeat);
+}
+
+#endif
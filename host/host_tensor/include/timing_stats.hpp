@@ -0,0 +1,120 @@
+#ifndef TIMING_STATS_HPP
+#define TIMING_STATS_HPP
+
+#include <algorithm>
+#include <cstdio>
+#include <ostream>
+#include <vector>
+
+// How launch_and_time_kernel and launch_and_time_host_kernel time an operation: mNumWarmup
+// untimed runs, then at least nrepeat timed runs, more if they took less than mMinDuration in
+// total.
+//
+// Environment:
+//   CK_TIMING_WARMUP: number of warm-up runs, default 1
+//   CK_TIMING_MIN_MS: minimum total time of the timed runs in milliseconds, default 0
+struct TimingOptions
+{
+    static TimingOptions& GetInstance();
+
+    int mNumWarmup     = 1;
+    float mMinDuration = 0; // ms
+    int mMaxRepeat     = 100000;
+};
+
+// Statistics of the per-run times of an operation, in milliseconds. Runs farther than
+// 3.5 * 1.4826 * MAD from the median are outliers, all fields except mNumSample, mNumOutlier and
+// mAllMean only describe the runs that are kept.
+struct TimingStats
+{
+    int mNumSample  = 0;
+    int mNumOutlier = 0;
+
+    float mAllMean = 0; // of all runs, outliers included
+
+    float mMean   = 0;
+    float mMin    = 0;
+    float mMedian = 0;
+    float mP90    = 0;
+    float mP99    = 0;
+    float mStdDev = 0;
+
+    // distribution-free 95% confidence interval of the median
+    float mMedianLow  = 0;
+    float mMedianHigh = 0;
+};
+
+TimingStats make_timing_stats(std::vector<float> samples);
+
+std::ostream& operator<<(std::ostream& os, const TimingStats& stats);
+
+// Collects the per-run times of every launch timed on this thread while it is alive, the launches
+// of one operation run add up run by run. Recorders nest, only the innermost one collects.
+struct TimingStatsRecorder
+{
+    TimingStatsRecorder();
+    ~TimingStatsRecorder();
+
+    // adds to the innermost recorder of this thread, if any
+    static void Add(const std::vector<float>& samples);
+
+    // stats of a single ave_time run if nothing was timed
+    TimingStats GetStats(float ave_time) const;
+
+    TimingStatsRecorder(const TimingStatsRecorder&) = delete;
+    TimingStatsRecorder& operator=(const TimingStatsRecorder&) = delete;
+
+    private:
+    TimingStatsRecorder* mOuter;
+    std::vector<float> mSamples;
+    bool mAdded = false;
+};
+
+// Runs f_run() for the warm-ups, then f_time_runs(n), which does n timed runs and returns their
+// times, until TimingOptions are met. Returns the mean time of all timed runs.
+template <typename FRun, typename FTimeRuns>
+float time_runs(FRun f_run, FTimeRuns f_time_runs, int nrepeat)
+{
+    const auto& options = TimingOptions::GetInstance();
+
+    printf("Warm up\n");
+
+    for(int i = 0; i < options.mNumWarmup; ++i)
+    {
+        f_run();
+    }
+
+    printf("Start running %d times...\n", nrepeat);
+
+    std::vector<float> samples = f_time_runs(nrepeat > 0 ? nrepeat : 1);
+
+    float total = 0;
+
+    for(float sample : samples)
+        total += sample;
+
+    // extend by the number of runs the time so far says are missing
+    while(total < options.mMinDuration && static_cast<int>(samples.size()) < options.mMaxRepeat)
+    {
+        const float per_run = total > 0 ? total / samples.size() : 0;
+
+        const int num_missing =
+            per_run > 0 ? static_cast<int>((options.mMinDuration - total) / per_run) + 1
+                        : static_cast<int>(samples.size());
+
+        const int num_run =
+            std::min(num_missing, options.mMaxRepeat - static_cast<int>(samples.size()));
+
+        for(float sample : f_time_runs(num_run))
+        {
+            samples.push_back(sample);
+            total += sample;
+        }
+    }
+
+    TimingStatsRecorder::Add(samples);
+
+    return total / samples.size();
+}
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef TUNING_DB_HPP
+#define TUNING_DB_HPP
+
+#include <map>
+#include <mutex>
+#include <string>
+
+// best instance of a tuned problem
+struct TuningDbRecord
+{
+    std::string mInstance; // GetTypeString() of the instance
+    float mAveTime  = 0;   // ms
+    float mTflops   = 0;
+    float mGbPerSec = 0;
+};
+
+// On-disk map from a problem key (op, data types, layouts, problem sizes, element-wise ops and
+// backend, see make_tuning_db_key()) to the best instance found for it, so applications can pick
+// an instance without timing all of them again.
+//
+// File layout: text, one record per line,
+//   key \t instance \t ave_time_ms \t tflops \t gb_per_sec
+// Writers hold an exclusive flock() on "<path>.lock" while they merge their records into the
+// current file content and replace the file with rename(), so concurrent writers do not lose each
+// other's records and readers never see a partially written file.
+//
+// Environment:
+//   CK_TUNING_DB: path of the database returned by GetInstance(), default "ck_tuning.db"
+struct TuningDb
+{
+    static TuningDb& GetInstance();
+
+    explicit TuningDb(std::string path);
+
+    const std::string& GetPath() const { return mPath; }
+
+    // looks the key up, the file is read on the first lookup
+    bool Find(const std::string& key, TuningDbRecord& record);
+
+    // Stores the record unless the file already holds a faster record of another instance for
+    // the key, returns whether it was stored. A record of the same instance is always replaced.
+    bool Update(const std::string& key, const TuningDbRecord& record);
+
+    // drops the records read so far, the next lookup reads the file again
+    void Reload();
+
+    TuningDb(const TuningDb&) = delete;
+    TuningDb& operator=(const TuningDb&) = delete;
+
+    private:
+    void Load();
+
+    std::string mPath;
+
+    bool mLoaded = false;
+    std::map<std::string, TuningDbRecord> mRecords;
+
+    std::mutex mMutex;
+};
+
+#endif
@@ -1,3 +1,4 @@
+#include <stdexcept>
 #include "device.hpp"
 
 DeviceMem::DeviceMem(std::size_t mem_size) : mMemSize(mem_size)
@@ -18,8 +19,62 @@ void DeviceMem::FromDevice(void* p)
     hipGetErrorString(hipMemcpy(p, mpDeviceBuf, mMemSize, hipMemcpyDeviceToHost));
 }
 
+void DeviceMem::ToDevice(const void* p, std::size_t num_bytes)
+{
+    if(num_bytes > mMemSize)
+        throw std::runtime_error("wrong! copy is larger than the device buffer");
+
+    hipGetErrorString(
+        hipMemcpy(mpDeviceBuf, const_cast<void*>(p), num_bytes, hipMemcpyHostToDevice));
+}
+
+void DeviceMem::FromDevice(void* p, std::size_t num_bytes)
+{
+    if(num_bytes > mMemSize)
+        throw std::runtime_error("wrong! copy is larger than the device buffer");
+
+    hipGetErrorString(hipMemcpy(p, mpDeviceBuf, num_bytes, hipMemcpyDeviceToHost));
+}
+
 DeviceMem::~DeviceMem() { hipGetErrorString(hipFree(mpDeviceBuf)); }
 
+DeviceMemPool& DeviceMemPool::GetInstance()
+{
+    static DeviceMemPool pool;
+
+    return pool;
+}
+
+DeviceMem& DeviceMemPool::Get(std::size_t slot, std::size_t num_bytes)
+{
+    if(slot >= mBuffers.size())
+        mBuffers.resize(slot + 1);
+
+    auto& buffer = mBuffers[slot];
+
+    if(!buffer || buffer->mMemSize < num_bytes)
+    {
+        // free the old buffer first, the new one may need its memory
+        buffer.reset();
+        buffer = std::make_unique<DeviceMem>(num_bytes);
+    }
+
+    return *buffer;
+}
+
+void DeviceMemPool::Release() { mBuffers.clear(); }
+
+std::string get_device_name()
+{
+    int device = 0;
+    hipGetErrorString(hipGetDevice(&device));
+
+    hipDeviceProp_t props;
+    hipGetErrorString(hipGetDeviceProperties(&props, device));
+
+    return std::string(props.gcnArchName) + ":" + std::to_string(props.multiProcessorCount);
+}
+
 struct KernelTimerImpl
 {
     KernelTimerImpl()
@@ -65,3 +120,60 @@ void KernelTimer::Start() { impl->Start(); }
 void KernelTimer::End() { impl->End(); }
 
 float KernelTimer::GetElapsedTime() const { return impl->GetElapsedTime(); }
+
+struct KernelSampleTimerImpl
+{
+    ~KernelSampleTimerImpl()
+    {
+        for(auto event : mEvents)
+            hipGetErrorString(hipEventDestroy(event));
+    }
+
+    void Record()
+    {
+        if(mNumRecorded == 0)
+            hipGetErrorString(hipDeviceSynchronize());
+
+        // events are reused by later batches of runs
+        if(mNumRecorded == mEvents.size())
+        {
+            hipEvent_t event;
+            hipGetErrorString(hipEventCreate(&event));
+            mEvents.push_back(event);
+        }
+
+        hipGetErrorString(hipEventRecord(mEvents[mNumRecorded++], nullptr));
+    }
+
+    std::vector<float> GetSamples()
+    {
+        std::vector<float> samples;
+
+        if(mNumRecorded == 0)
+            return samples;
+
+        hipGetErrorString(hipEventSynchronize(mEvents[mNumRecorded - 1]));
+
+        for(std::size_t i = 1; i < mNumRecorded; ++i)
+        {
+            float time;
+            hipGetErrorString(hipEventElapsedTime(&time, mEvents[i - 1], mEvents[i]));
+            samples.push_back(time);
+        }
+
+        mNumRecorded = 0;
+
+        return samples;
+    }
+
+    std::vector<hipEvent_t> mEvents;
+    std::size_t mNumRecorded = 0;
+};
+
+KernelSampleTimer::KernelSampleTimer() : impl(new KernelSampleTimerImpl()) {}
+
+KernelSampleTimer::~KernelSampleTimer() {}
+
+void KernelSampleTimer::Record() { impl->Record(); }
+
+std::vector<float> KernelSampleTimer::GetSamples() { return impl->GetSamples(); }
@@ -33,6 +33,21 @@ std::size_t HostTensorDescriptor::GetElementSpace() const
     return space;
 }
 
+bool HostTensorDescriptor::IsPacked() const
+{
+    std::size_t stride = 1;
+
+    for(std::size_t i = mLens.size(); i-- > 0;)
+    {
+        if(mLens[i] != 1 && mStrides[i] != stride)
+            return false;
+
+        stride *= mLens[i];
+    }
+
+    return true;
+}
+
 const std::vector<std::size_t>& HostTensorDescriptor::GetLengths() const { return mLens; }
 
 const std::vector<std::size_t>& HostTensorDescriptor::GetStrides() const { return mStrides; }
@@ -64,13 +79,3 @@ void ostream_HostTensorDescriptor(const HostTensorDescriptor& desc, std::ostream
     LogRange(os, desc.GetStrides(), ", ");
     os << "}" << std::endl;
 }
-
-float bf16_to_f32_(ushort src_val)
-{
-    union
-    {
-        uint32_t int32;
-        float fp32;
-    } u = {uint32_t(src_val) << 16};
-    return u.fp32;
-}
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "host_tensor_allocator.hpp"
+
+namespace {
+
+std::size_t get_env_size(const char* name, std::size_t default_value)
+{
+    const char* env = std::getenv(name);
+
+    if(env == nullptr || *env == '\0')
+        return default_value;
+
+    return static_cast<std::size_t>(std::stoull(env));
+}
+
+std::size_t round_up(std::size_t x, std::size_t align) { return (x + align - 1) / align * align; }
+
+} // namespace
+
+HostMemoryArena& HostMemoryArena::GetInstance()
+{
+    static HostMemoryArena arena(get_env_size("CK_HOST_ARENA_BYTES", std::size_t{1} << 30),
+                                 get_env_size("CK_HOST_HUGEPAGE_BYTES", std::size_t{4} << 20));
+
+    return arena;
+}
+
+HostMemoryArena::HostMemoryArena(std::size_t max_cached_bytes, std::size_t hugepage_bytes)
+    : mMaxCachedBytes(max_cached_bytes), mHugePageThreshold(hugepage_bytes)
+{
+}
+
+HostMemoryArena::~HostMemoryArena()
+{
+    Trim();
+
+    // blocks still owned by static tensors are released by the OS at exit
+}
+
+std::size_t HostMemoryArena::GetBlockBytes(std::size_t bytes) const
+{
+    bytes = std::max<std::size_t>(bytes, 1);
+
+    if(mHugePageThreshold != 0 && bytes >= mHugePageThreshold)
+        return round_up(bytes, HugePageBytes);
+
+    return round_up(bytes, CacheLineBytes);
+}
+
+void* HostMemoryArena::Allocate(std::size_t bytes)
+{
+    const std::size_t block_bytes = GetBlockBytes(bytes);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        ++mStatistics.mNumAllocation;
+
+        // smallest cached block that fits, unless it would waste more than half the request
+        auto it = mCached.lower_bound(block_bytes);
+
+        if(it != mCached.end() && it->first <= block_bytes + block_bytes / 2)
+        {
+            void* p = it->second;
+
+            mInUse.emplace(p, it->first);
+
+            mStatistics.mBytesCached -= it->first;
+            mStatistics.mBytesInUse += it->first;
+            ++mStatistics.mNumReuse;
+
+            mCached.erase(it);
+
+            return p;
+        }
+    }
+
+    const bool huge = mHugePageThreshold != 0 && block_bytes >= mHugePageThreshold;
+
+    void* p = std::aligned_alloc(huge ? HugePageBytes : CacheLineBytes, block_bytes);
+
+    if(p == nullptr)
+    {
+        // drop the cache and try once more
+        Trim();
+
+        p = std::aligned_alloc(huge ? HugePageBytes : CacheLineBytes, block_bytes);
+
+        if(p == nullptr)
+            throw std::bad_alloc();
+    }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if(huge)
+        madvise(p, block_bytes, MADV_HUGEPAGE);
+#endif
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mInUse.emplace(p, block_bytes);
+
+    mStatistics.mBytesInUse += block_bytes;
+
+    return p;
+}
+
+void HostMemoryArena::Deallocate(void* p)
+{
+    if(p == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto it = mInUse.find(p);
+
+    if(it == mInUse.end())
+        throw std::runtime_error("wrong! block was not allocated by HostMemoryArena");
+
+    const std::size_t block_bytes = it->second;
+
+    mInUse.erase(it);
+
+    mStatistics.mBytesInUse -= block_bytes;
+
+    if(block_bytes > mMaxCachedBytes)
+    {
+        std::free(p);
+        return;
+    }
+
+    EvictLocked(block_bytes);
+
+    mCached.emplace(block_bytes, p);
+
+    mStatistics.mBytesCached += block_bytes;
+}
+
+void HostMemoryArena::EvictLocked(std::size_t bytes)
+{
+    // make room for `bytes` more, largest blocks first
+    while(!mCached.empty() && mStatistics.mBytesCached + bytes > mMaxCachedBytes)
+    {
+        auto it = std::prev(mCached.end());
+
+        std::free(it->second);
+
+        mStatistics.mBytesCached -= it->first;
+
+        mCached.erase(it);
+    }
+}
+
+void HostMemoryArena::Trim()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    for(auto& block : mCached)
+        std::free(block.second);
+
+    mCached.clear();
+
+    mStatistics.mBytesCached = 0;
+}
+
+HostMemoryArena::Statistics HostMemoryArena::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    return mStatistics;
+}
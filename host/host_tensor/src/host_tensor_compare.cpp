@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "host_simd.hpp"
+#include "host_tensor_compare.hpp"
+
+#if CK_HOST_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// the test and errors of compare_tensor for one finite pair, false for NaN and Inf
+CK_HOST_ALWAYS_INLINE bool compare_float_pair(float ref,
+                                              float result,
+                                              double abs_tolerance,
+                                              double rel_tolerance,
+                                              double& abs_error,
+                                              double& rel_error)
+{
+    const double r = ref;
+    const double x = result;
+
+    abs_error = std::abs(x - r);
+    rel_error = r != 0 ? abs_error / std::abs(r) : abs_error;
+
+    return std::isfinite(r) && std::isfinite(x) &&
+           abs_error <= abs_tolerance + rel_tolerance * std::abs(r);
+}
+
+bool compare_float_block_scalar(const float* p_ref,
+                                const float* p_result,
+                                std::size_t n,
+                                double abs_tolerance,
+                                double rel_tolerance,
+                                HostCompareBlockStats& stats)
+{
+    HostCompareBlockStats block;
+
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        double abs_error, rel_error;
+
+        if(!compare_float_pair(
+               p_ref[i], p_result[i], abs_tolerance, rel_tolerance, abs_error, rel_error))
+            return false;
+
+        block.mSumAbsError += abs_error;
+        block.mMaxAbsError = std::max(block.mMaxAbsError, abs_error);
+        block.mMaxRelError = std::max(block.mMaxRelError, rel_error);
+    }
+
+    stats = block;
+
+    return true;
+}
+
+template <int VL>
+CK_HOST_ALWAYS_INLINE host_vector_t<double, VL> select_max_vector(host_vector_t<double, VL> a,
+                                                                  host_vector_t<double, VL> b)
+{
+    using i64_t = host_vector_t<std::int64_t, VL>;
+
+    const i64_t a_greater = a > b;
+
+    return (host_vector_t<double, VL>)(((i64_t)a & a_greater) | ((i64_t)b & ~a_greater));
+}
+
+// VL pairs per step, widened to double so the test matches compare_float_pair. Lanes keep their
+// own sums, so the sum of errors may differ from the element-wise one in the last bits.
+template <int VL>
+CK_HOST_ALWAYS_INLINE bool compare_float_block_vector(const float* p_ref,
+                                                      const float* p_result,
+                                                      std::size_t n,
+                                                      double abs_tolerance,
+                                                      double rel_tolerance,
+                                                      HostCompareBlockStats& stats)
+{
+    using f64_t = host_vector_t<double, VL>;
+    using i64_t = host_vector_t<std::int64_t, VL>;
+
+    const i64_t abs_mask = host_vector_broadcast<std::int64_t, VL>(0x7fffffffffffffff);
+    const f64_t max_finite =
+        host_vector_broadcast<double, VL>(std::numeric_limits<float>::max());
+    const f64_t abs_tol = host_vector_broadcast<double, VL>(abs_tolerance);
+    const f64_t rel_tol = host_vector_broadcast<double, VL>(rel_tolerance);
+    const f64_t zero    = host_vector_broadcast<double, VL>(0);
+
+    f64_t sum     = zero;
+    f64_t max_abs = zero;
+    f64_t max_rel = zero;
+    i64_t pass    = host_vector_broadcast<std::int64_t, VL>(-1);
+
+    std::size_t i = 0;
+
+    for(; i + VL <= n; i += VL)
+    {
+        const f64_t r = __builtin_convertvector(host_vector_load<float, VL>(p_ref + i), f64_t);
+        const f64_t x = __builtin_convertvector(host_vector_load<float, VL>(p_result + i), f64_t);
+
+        const f64_t abs_r     = (f64_t)((i64_t)r & abs_mask);
+        const f64_t abs_x     = (f64_t)((i64_t)x & abs_mask);
+        const f64_t abs_error = (f64_t)((i64_t)(x - r) & abs_mask);
+
+        // NaN compares false, Inf is above max_finite
+        pass &= (i64_t)(abs_r <= max_finite) & (i64_t)(abs_x <= max_finite) &
+                (i64_t)(abs_error <= abs_tol + rel_tol * abs_r);
+
+        const i64_t nonzero   = r != zero;
+        const f64_t rel_error = (f64_t)(((i64_t)(abs_error / abs_r) & nonzero) |
+                                        ((i64_t)abs_error & ~nonzero));
+
+        sum += abs_error;
+        max_abs = select_max_vector<VL>(abs_error, max_abs);
+        max_rel = select_max_vector<VL>(rel_error, max_rel);
+    }
+
+    HostCompareBlockStats block;
+
+    for(int l = 0; l < VL; ++l)
+    {
+        if(pass[l] == 0)
+            return false;
+
+        block.mSumAbsError += sum[l];
+        block.mMaxAbsError = std::max(block.mMaxAbsError, max_abs[l]);
+        block.mMaxRelError = std::max(block.mMaxRelError, max_rel[l]);
+    }
+
+    HostCompareBlockStats tail;
+
+    if(!compare_float_block_scalar(
+           p_ref + i, p_result + i, n - i, abs_tolerance, rel_tolerance, tail))
+        return false;
+
+    stats.mSumAbsError = block.mSumAbsError + tail.mSumAbsError;
+    stats.mMaxAbsError = std::max(block.mMaxAbsError, tail.mMaxAbsError);
+    stats.mMaxRelError = std::max(block.mMaxRelError, tail.mMaxRelError);
+
+    return true;
+}
+
+#if CK_HOST_X86
+CK_HOST_TARGET_AVX2 bool compare_float_block_avx2(const float* p_ref,
+                                                  const float* p_result,
+                                                  std::size_t n,
+                                                  double abs_tolerance,
+                                                  double rel_tolerance,
+                                                  HostCompareBlockStats& stats)
+{
+    return compare_float_block_vector<4>(
+        p_ref, p_result, n, abs_tolerance, rel_tolerance, stats);
+}
+
+// compare masks stay in k registers, turning them into vector lanes as
+// compare_float_block_vector does takes AVX-512 DQ
+CK_HOST_TARGET_AVX512 bool compare_float_block_avx512(const float* p_ref,
+                                                      const float* p_result,
+                                                      std::size_t n,
+                                                      double abs_tolerance,
+                                                      double rel_tolerance,
+                                                      HostCompareBlockStats& stats)
+{
+    const __m512d max_finite = _mm512_set1_pd(std::numeric_limits<float>::max());
+    const __m512d abs_tol    = _mm512_set1_pd(abs_tolerance);
+    const __m512d rel_tol    = _mm512_set1_pd(rel_tolerance);
+    const __m512d zero       = _mm512_setzero_pd();
+
+    __m512d sum     = zero;
+    __m512d max_abs = zero;
+    __m512d max_rel = zero;
+    __mmask8 pass   = 0xff;
+
+    std::size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+    {
+        const __m512d r = _mm512_cvtps_pd(_mm256_loadu_ps(p_ref + i));
+        const __m512d x = _mm512_cvtps_pd(_mm256_loadu_ps(p_result + i));
+
+        const __m512d abs_r     = _mm512_abs_pd(r);
+        const __m512d abs_x     = _mm512_abs_pd(x);
+        const __m512d abs_error = _mm512_abs_pd(_mm512_sub_pd(x, r));
+
+        // NaN compares false, Inf is above max_finite
+        pass &= _mm512_cmp_pd_mask(abs_r, max_finite, _CMP_LE_OQ) &
+                _mm512_cmp_pd_mask(abs_x, max_finite, _CMP_LE_OQ) &
+                _mm512_cmp_pd_mask(
+                    abs_error, _mm512_add_pd(abs_tol, _mm512_mul_pd(rel_tol, abs_r)), _CMP_LE_OQ);
+
+        const __mmask8 nonzero  = _mm512_cmp_pd_mask(r, zero, _CMP_NEQ_UQ);
+        const __m512d rel_error = _mm512_mask_div_pd(abs_error, nonzero, abs_error, abs_r);
+
+        sum     = _mm512_add_pd(sum, abs_error);
+        max_abs = _mm512_max_pd(max_abs, abs_error);
+        max_rel = _mm512_max_pd(max_rel, rel_error);
+    }
+
+    HostCompareBlockStats tail;
+
+    if(pass != 0xff || !compare_float_block_scalar(
+                           p_ref + i, p_result + i, n - i, abs_tolerance, rel_tolerance, tail))
+        return false;
+
+    stats.mSumAbsError = _mm512_reduce_add_pd(sum) + tail.mSumAbsError;
+    stats.mMaxAbsError = std::max(_mm512_reduce_max_pd(max_abs), tail.mMaxAbsError);
+    stats.mMaxRelError = std::max(_mm512_reduce_max_pd(max_rel), tail.mMaxRelError);
+
+    return true;
+}
+#endif
+
+} // namespace
+
+bool host_compare_float_block(const float* p_ref,
+                              const float* p_result,
+                              std::size_t n,
+                              double abs_tolerance,
+                              double rel_tolerance,
+                              HostCompareBlockStats& stats)
+{
+#if CK_HOST_X86
+    switch(get_host_simd_isa())
+    {
+    case HostSimdIsa_t::Avx512:
+        return compare_float_block_avx512(
+            p_ref, p_result, n, abs_tolerance, rel_tolerance, stats);
+    case HostSimdIsa_t::Avx2:
+        return compare_float_block_avx2(p_ref, p_result, n, abs_tolerance, rel_tolerance, stats);
+    default: break;
+    }
+#endif
+
+    return compare_float_block_scalar(p_ref, p_result, n, abs_tolerance, rel_tolerance, stats);
+}
@@ -0,0 +1,329 @@
+#include <cstring>
+
+#include "host_simd.hpp"
+#include "host_tensor_convert.hpp"
+
+#if CK_HOST_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+void convert_half_to_float_scalar(const ck::half_t* p_src, float* p_dst, std::size_t n)
+{
+    for(std::size_t i = 0; i < n; ++i)
+        p_dst[i] = static_cast<float>(p_src[i]);
+}
+
+void convert_float_to_half_scalar(const float* p_src, ck::half_t* p_dst, std::size_t n)
+{
+    for(std::size_t i = 0; i < n; ++i)
+        p_dst[i] = static_cast<ck::half_t>(p_src[i]);
+}
+
+// bf16 -> float is a 16 bit shift of every element
+template <int VL>
+CK_HOST_ALWAYS_INLINE void
+convert_bf16_to_float_vector(const ushort* p_src, float* p_dst, std::size_t n)
+{
+    using u32_t = host_vector_t<uint32_t, VL>;
+
+    std::size_t i = 0;
+
+    for(; i + VL <= n; i += VL)
+    {
+        const u32_t u = __builtin_convertvector(host_vector_load<ushort, VL>(p_src + i), u32_t);
+
+        const u32_t f = u << 16;
+
+        std::memcpy(p_dst + i, &f, sizeof(f));
+    }
+
+    for(; i < n; ++i)
+        p_dst[i] = bf16_to_f32_(p_src[i]);
+}
+
+// host_float_to_bf16 on VL lanes at once, Inf/NaN lanes are blended in with a mask
+template <int VL>
+CK_HOST_ALWAYS_INLINE host_vector_t<ushort, VL> float_to_bf16_vector(host_vector_t<uint32_t, VL> u,
+                                                                     HostBf16Rounding_t rounding)
+{
+    using u32_t = host_vector_t<uint32_t, VL>;
+
+    const u32_t exponent = host_vector_broadcast<uint32_t, VL>(0x7f800000);
+    const u32_t low_half = host_vector_broadcast<uint32_t, VL>(0xffff);
+    const u32_t zero     = host_vector_broadcast<uint32_t, VL>(0);
+
+    const u32_t inf_nan = (u32_t)((u & exponent) == exponent);
+    const u32_t low_set = (u32_t)((u & low_half) != zero);
+
+    const u32_t round = rounding == HostBf16Rounding_t::NearestEven
+                            ? host_vector_broadcast<uint32_t, VL>(0x7fff) +
+                                  ((u >> 16) & host_vector_broadcast<uint32_t, VL>(1))
+                            : zero;
+
+    const u32_t nan_bit = low_set & host_vector_broadcast<uint32_t, VL>(0x10000);
+
+    const u32_t r = ((u + round) & ~inf_nan) | ((u | nan_bit) & inf_nan);
+
+    return __builtin_convertvector(r >> 16, host_vector_t<ushort, VL>);
+}
+
+template <int VL>
+CK_HOST_ALWAYS_INLINE void convert_float_to_bf16_vector(const float* p_src,
+                                                        ushort* p_dst,
+                                                        std::size_t n,
+                                                        HostBf16Rounding_t rounding)
+{
+    std::size_t i = 0;
+
+    for(; i + VL <= n; i += VL)
+    {
+        host_vector_t<uint32_t, VL> u;
+
+        std::memcpy(&u, p_src + i, sizeof(u));
+
+        host_vector_store<ushort, VL>(p_dst + i, float_to_bf16_vector<VL>(u, rounding));
+    }
+
+    for(; i < n; ++i)
+        p_dst[i] = host_float_to_bf16(p_src[i], rounding);
+}
+
+#if CK_HOST_X86
+// tails go through a zero-padded vector, so they take the same rounding path as full vectors
+CK_HOST_TARGET_AVX2 void
+convert_half_to_float_avx2(const ck::half_t* p_src, float* p_dst, std::size_t n)
+{
+    std::size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+    {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_src + i));
+
+        _mm256_storeu_ps(p_dst + i, _mm256_cvtph_ps(h));
+    }
+
+    if(i < n)
+    {
+        ck::half_t h_tail[8] = {};
+        float f_tail[8];
+
+        std::memcpy(h_tail, p_src + i, (n - i) * sizeof(ck::half_t));
+
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h_tail));
+
+        _mm256_storeu_ps(f_tail, _mm256_cvtph_ps(h));
+
+        std::memcpy(p_dst + i, f_tail, (n - i) * sizeof(float));
+    }
+}
+
+CK_HOST_TARGET_AVX2 void
+convert_float_to_half_avx2(const float* p_src, ck::half_t* p_dst, std::size_t n)
+{
+    constexpr int Rounding = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+
+    std::size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+    {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(p_src + i), Rounding);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p_dst + i), h);
+    }
+
+    if(i < n)
+    {
+        float f_tail[8] = {};
+        ck::half_t h_tail[8];
+
+        std::memcpy(f_tail, p_src + i, (n - i) * sizeof(float));
+
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(f_tail), Rounding);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(h_tail), h);
+
+        std::memcpy(p_dst + i, h_tail, (n - i) * sizeof(ck::half_t));
+    }
+}
+
+CK_HOST_TARGET_AVX512 void
+convert_half_to_float_avx512(const ck::half_t* p_src, float* p_dst, std::size_t n)
+{
+    std::size_t i = 0;
+
+    for(; i + 16 <= n; i += 16)
+    {
+        const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_src + i));
+
+        _mm512_storeu_ps(p_dst + i, _mm512_cvtph_ps(h));
+    }
+
+    if(i < n)
+    {
+        const __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+
+        const __m256i h = _mm256_maskz_loadu_epi16(mask, p_src + i);
+
+        _mm512_mask_storeu_ps(p_dst + i, mask, _mm512_cvtph_ps(h));
+    }
+}
+
+CK_HOST_TARGET_AVX512 void
+convert_float_to_half_avx512(const float* p_src, ck::half_t* p_dst, std::size_t n)
+{
+    constexpr int Rounding = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+
+    std::size_t i = 0;
+
+    for(; i + 16 <= n; i += 16)
+    {
+        const __m256i h = _mm512_cvtps_ph(_mm512_loadu_ps(p_src + i), Rounding);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_dst + i), h);
+    }
+
+    if(i < n)
+    {
+        const __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+
+        const __m256i h = _mm512_cvtps_ph(_mm512_maskz_loadu_ps(mask, p_src + i), Rounding);
+
+        _mm256_mask_storeu_epi16(p_dst + i, mask, h);
+    }
+}
+
+CK_HOST_TARGET_AVX2 void
+convert_bf16_to_float_avx2(const ushort* p_src, float* p_dst, std::size_t n)
+{
+    convert_bf16_to_float_vector<8>(p_src, p_dst, n);
+}
+
+CK_HOST_TARGET_AVX2 void convert_float_to_bf16_avx2(const float* p_src,
+                                                    ushort* p_dst,
+                                                    std::size_t n,
+                                                    HostBf16Rounding_t rounding)
+{
+    convert_float_to_bf16_vector<8>(p_src, p_dst, n, rounding);
+}
+
+CK_HOST_TARGET_AVX512 void
+convert_bf16_to_float_avx512(const ushort* p_src, float* p_dst, std::size_t n)
+{
+    convert_bf16_to_float_vector<16>(p_src, p_dst, n);
+}
+
+CK_HOST_TARGET_AVX512 void convert_float_to_bf16_avx512(const float* p_src,
+                                                        ushort* p_dst,
+                                                        std::size_t n,
+                                                        HostBf16Rounding_t rounding)
+{
+    convert_float_to_bf16_vector<16>(p_src, p_dst, n, rounding);
+}
+
+// round to nearest even with vcvtneps2bf16. It flushes subnormal inputs to zero and quiets NaNs,
+// vectors holding either take the integer path, so the result matches host_float_to_bf16
+CK_HOST_TARGET_AVX512_BF16 void
+convert_float_to_bf16_avx512_bf16(const float* p_src, ushort* p_dst, std::size_t n)
+{
+    const __m512i abs_mask    = _mm512_set1_epi32(0x7fffffff);
+    const __m512i max_subnorm = _mm512_set1_epi32(0x007fffff);
+    const __m512i inf_bits    = _mm512_set1_epi32(0x7f800000);
+    const __m512i all_ones    = _mm512_set1_epi32(-1);
+
+    std::size_t i = 0;
+
+    for(; i + 16 <= n; i += 16)
+    {
+        const __m512 f  = _mm512_loadu_ps(p_src + i);
+        const __m512i a = _mm512_and_si512(_mm512_castps_si512(f), abs_mask);
+
+        // |x| - 1 < 0x7fffff: nonzero subnormal, |x| > Inf bits: NaN
+        const __mmask16 special =
+            _mm512_cmplt_epu32_mask(_mm512_add_epi32(a, all_ones), max_subnorm) |
+            _mm512_cmpgt_epu32_mask(a, inf_bits);
+
+        if(special == 0)
+        {
+            const __m256bh h = _mm512_cvtneps_pbh(f);
+
+            std::memcpy(p_dst + i, &h, sizeof(h));
+        }
+        else
+        {
+            convert_float_to_bf16_vector<16>(
+                p_src + i, p_dst + i, 16, HostBf16Rounding_t::NearestEven);
+        }
+    }
+
+    convert_float_to_bf16_vector<16>(p_src + i, p_dst + i, n - i, HostBf16Rounding_t::NearestEven);
+}
+#endif
+
+} // namespace
+
+void host_convert_half_to_float(const ck::half_t* p_src, float* p_dst, std::size_t n)
+{
+#if CK_HOST_X86
+    switch(get_host_simd_isa())
+    {
+    case HostSimdIsa_t::Avx512: convert_half_to_float_avx512(p_src, p_dst, n); return;
+    case HostSimdIsa_t::Avx2: convert_half_to_float_avx2(p_src, p_dst, n); return;
+    default: break;
+    }
+#endif
+
+    convert_half_to_float_scalar(p_src, p_dst, n);
+}
+
+void host_convert_float_to_half(const float* p_src, ck::half_t* p_dst, std::size_t n)
+{
+#if CK_HOST_X86
+    switch(get_host_simd_isa())
+    {
+    case HostSimdIsa_t::Avx512: convert_float_to_half_avx512(p_src, p_dst, n); return;
+    case HostSimdIsa_t::Avx2: convert_float_to_half_avx2(p_src, p_dst, n); return;
+    default: break;
+    }
+#endif
+
+    convert_float_to_half_scalar(p_src, p_dst, n);
+}
+
+void host_convert_bf16_to_float(const ushort* p_src, float* p_dst, std::size_t n)
+{
+#if CK_HOST_X86
+    switch(get_host_simd_isa())
+    {
+    case HostSimdIsa_t::Avx512: convert_bf16_to_float_avx512(p_src, p_dst, n); return;
+    case HostSimdIsa_t::Avx2: convert_bf16_to_float_avx2(p_src, p_dst, n); return;
+    default: break;
+    }
+#endif
+
+    convert_bf16_to_float_vector<4>(p_src, p_dst, n);
+}
+
+void host_convert_float_to_bf16(const float* p_src,
+                                ushort* p_dst,
+                                std::size_t n,
+                                HostBf16Rounding_t rounding)
+{
+#if CK_HOST_X86
+    if(rounding == HostBf16Rounding_t::NearestEven && get_host_simd_has_avx512_bf16())
+    {
+        convert_float_to_bf16_avx512_bf16(p_src, p_dst, n);
+        return;
+    }
+
+    switch(get_host_simd_isa())
+    {
+    case HostSimdIsa_t::Avx512: convert_float_to_bf16_avx512(p_src, p_dst, n, rounding); return;
+    case HostSimdIsa_t::Avx2: convert_float_to_bf16_avx2(p_src, p_dst, n, rounding); return;
+    default: break;
+    }
+#endif
+
+    convert_float_to_bf16_vector<4>(p_src, p_dst, n, rounding);
+}
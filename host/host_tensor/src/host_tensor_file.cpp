@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "host_tensor_file.hpp"
+
+namespace {
+
+// fixed part of the header, followed by lengths, strides and key
+struct HostTensorFileFixedHeader
+{
+    char mMagic[8];
+    std::uint32_t mVersion;
+    std::uint32_t mDataType;
+    std::uint64_t mElementBytes;
+    std::uint64_t mRank;
+    std::uint64_t mSeed;
+    std::uint64_t mKeyBytes;
+    std::uint64_t mDataOffset;
+    std::uint64_t mDataBytes;
+};
+
+std::uint64_t get_fnv1a_hash(const std::string& s)
+{
+    std::uint64_t h = 0xCBF29CE484222325ull;
+
+    for(unsigned char c : s)
+        h = (h ^ c) * 0x100000001B3ull;
+
+    return h;
+}
+
+} // namespace
+
+HostTensorFile::HostTensorFile(const std::string& path)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+
+    if(fd < 0)
+        throw std::runtime_error("wrong! cannot open tensor file " + path);
+
+    struct stat st;
+
+    if(fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(HostTensorFileFixedHeader)))
+    {
+        close(fd);
+        throw std::runtime_error("wrong! tensor file " + path + " is too short");
+    }
+
+    mSize = static_cast<std::size_t>(st.st_size);
+
+    void* p = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // the mapping stays valid after the descriptor is closed
+    close(fd);
+
+    if(p == MAP_FAILED)
+        throw std::runtime_error("wrong! cannot map tensor file " + path);
+
+    mBase = static_cast<const char*>(p);
+
+    HostTensorFileFixedHeader fixed;
+    std::memcpy(&fixed, mBase, sizeof(fixed));
+
+    const std::size_t rank = fixed.mRank;
+
+    const std::size_t var_bytes = 2 * rank * sizeof(std::uint64_t) + fixed.mKeyBytes;
+
+    if(std::memcmp(fixed.mMagic, HostTensorFileHeader::Magic, sizeof(fixed.mMagic)) != 0 ||
+       fixed.mVersion != HostTensorFileHeader::Version || rank > mSize ||
+       fixed.mKeyBytes > mSize || sizeof(fixed) + var_bytes > fixed.mDataOffset ||
+       fixed.mDataOffset > mSize || fixed.mDataBytes > mSize - fixed.mDataOffset)
+    {
+        munmap(const_cast<char*>(mBase), mSize);
+        throw std::runtime_error("wrong! " + path + " is not a valid tensor file");
+    }
+
+    mHeader.mDataType     = static_cast<ck::DataTypeEnum_t>(fixed.mDataType);
+    mHeader.mElementBytes = fixed.mElementBytes;
+    mHeader.mSeed         = fixed.mSeed;
+    mHeader.mDataOffset   = fixed.mDataOffset;
+    mHeader.mDataBytes    = fixed.mDataBytes;
+
+    const char* p_var = mBase + sizeof(fixed);
+
+    mHeader.mLengths.resize(rank);
+    mHeader.mStrides.resize(rank);
+
+    for(std::size_t i = 0; i < rank; ++i)
+    {
+        std::uint64_t length, stride;
+
+        std::memcpy(&length, p_var + i * sizeof(std::uint64_t), sizeof(length));
+        std::memcpy(&stride, p_var + (rank + i) * sizeof(std::uint64_t), sizeof(stride));
+
+        mHeader.mLengths[i] = length;
+        mHeader.mStrides[i] = stride;
+    }
+
+    mHeader.mKey.assign(p_var + 2 * rank * sizeof(std::uint64_t), fixed.mKeyBytes);
+
+    if(mHeader.GetDescriptor().GetElementSpace() * mHeader.mElementBytes != mHeader.mDataBytes)
+    {
+        munmap(const_cast<char*>(mBase), mSize);
+        throw std::runtime_error("wrong! tensor file " + path + " has inconsistent data size");
+    }
+}
+
+HostTensorFile::~HostTensorFile()
+{
+    if(mBase != nullptr)
+        munmap(const_cast<char*>(mBase), mSize);
+}
+
+void write_host_tensor_file(const std::string& path,
+                            const HostTensorFileHeader& header,
+                            const void* p_data)
+{
+    const std::size_t rank = header.mLengths.size();
+
+    HostTensorFileFixedHeader fixed;
+
+    std::memcpy(fixed.mMagic, HostTensorFileHeader::Magic, sizeof(fixed.mMagic));
+
+    fixed.mVersion      = HostTensorFileHeader::Version;
+    fixed.mDataType     = static_cast<std::uint32_t>(header.mDataType);
+    fixed.mElementBytes = header.mElementBytes;
+    fixed.mRank         = rank;
+    fixed.mSeed         = header.mSeed;
+    fixed.mKeyBytes     = header.mKey.size();
+    fixed.mDataBytes    = header.mDataBytes;
+
+    std::vector<char> head(sizeof(fixed) + 2 * rank * sizeof(std::uint64_t) + header.mKey.size());
+
+    fixed.mDataOffset = (head.size() + HostTensorFileHeader::DataAlignment - 1) /
+                        HostTensorFileHeader::DataAlignment * HostTensorFileHeader::DataAlignment;
+
+    head.resize(fixed.mDataOffset, 0);
+
+    std::memcpy(head.data(), &fixed, sizeof(fixed));
+
+    char* p_var = head.data() + sizeof(fixed);
+
+    for(std::size_t i = 0; i < rank; ++i)
+    {
+        const std::uint64_t length = header.mLengths[i];
+        const std::uint64_t stride = header.mStrides[i];
+
+        std::memcpy(p_var + i * sizeof(std::uint64_t), &length, sizeof(length));
+        std::memcpy(p_var + (rank + i) * sizeof(std::uint64_t), &stride, sizeof(stride));
+    }
+
+    std::memcpy(p_var + 2 * rank * sizeof(std::uint64_t), header.mKey.data(), header.mKey.size());
+
+    // write under a temporary name, then rename over the destination
+    const std::string tmp_path = path + ".tmp" + std::to_string(getpid());
+
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+
+        file.write(head.data(), head.size());
+
+        const char* p           = static_cast<const char*>(p_data);
+        const std::size_t chunk = std::size_t{64} << 20;
+
+        for(std::size_t offset = 0; offset < header.mDataBytes && file; offset += chunk)
+            file.write(p + offset, std::min(chunk, header.mDataBytes - offset));
+
+        file.close();
+
+        if(!file)
+        {
+            std::remove(tmp_path.c_str());
+            throw std::runtime_error("wrong! cannot write tensor file " + tmp_path);
+        }
+    }
+
+    if(std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmp_path.c_str());
+        throw std::runtime_error("wrong! cannot rename tensor file to " + path);
+    }
+}
+
+HostTensorCache& HostTensorCache::GetInstance()
+{
+    const char* env = std::getenv("CK_HOST_TENSOR_CACHE");
+
+    static HostTensorCache cache(env == nullptr ? "" : env);
+
+    return cache;
+}
+
+HostTensorCache::HostTensorCache(std::string directory) : mDirectory(std::move(directory))
+{
+    if(mDirectory.empty())
+        return;
+
+    struct stat st;
+
+    if(mkdir(mDirectory.c_str(), 0755) != 0 &&
+       (errno != EEXIST || stat(mDirectory.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)))
+    {
+        std::cerr << "Host tensor cache: cannot create directory " << mDirectory << ", "
+                  << std::strerror(errno) << ", caching disabled" << std::endl;
+
+        mDirectory.clear();
+    }
+}
+
+std::string HostTensorCache::GetPath(const std::string& key) const
+{
+    char name[32];
+
+    std::snprintf(name,
+                  sizeof(name),
+                  "%016llx.cktensor",
+                  static_cast<unsigned long long>(get_fnv1a_hash(key)));
+
+    return mDirectory + "/" + name;
+}
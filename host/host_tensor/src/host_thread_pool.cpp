@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "host_thread_pool.hpp"
+
+namespace {
+
+thread_local bool tls_in_host_thread_pool_job = false;
+
+std::size_t get_env_size(const char* name, std::size_t default_value)
+{
+    const char* env = std::getenv(name);
+
+    if(env == nullptr || *env == '\0')
+        return default_value;
+
+    return static_cast<std::size_t>(std::stoul(env));
+}
+
+void pin_current_thread(std::size_t id)
+{
+#ifdef __linux__
+    cpu_set_t process_set;
+    CPU_ZERO(&process_set);
+
+    if(sched_getaffinity(0, sizeof(process_set), &process_set) != 0)
+        return;
+
+    const int num_cpu = CPU_COUNT(&process_set);
+
+    if(num_cpu <= 0)
+        return;
+
+    // i-th allowed CPU, wrapping around if there are more threads than CPUs
+    int target = static_cast<int>(id % static_cast<std::size_t>(num_cpu));
+
+    for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+        if(CPU_ISSET(cpu, &process_set) && target-- == 0)
+        {
+            cpu_set_t thread_set;
+            CPU_ZERO(&thread_set);
+            CPU_SET(cpu, &thread_set);
+            pthread_setaffinity_np(pthread_self(), sizeof(thread_set), &thread_set);
+            return;
+        }
+    }
+#else
+    (void)id;
+#endif
+}
+
+} // namespace
+
+HostThreadPool& HostThreadPool::GetInstance()
+{
+    static HostThreadPool pool(
+        get_env_size("CK_HOST_NUM_THREADS", std::max(std::thread::hardware_concurrency(), 1u)),
+        get_env_size("CK_HOST_PIN_THREADS", 0) != 0);
+
+    return pool;
+}
+
+HostThreadPool::HostThreadPool(std::size_t num_thread, bool pin_thread)
+    : mNumThread(std::max<std::size_t>(num_thread, 1)),
+      mPinThread(pin_thread),
+      mRanges(new WorkRange[mNumThread])
+{
+    if(mPinThread)
+        pin_current_thread(0);
+
+    mWorkers.reserve(mNumThread - 1);
+
+    for(std::size_t id = 1; id < mNumThread; ++id)
+    {
+        mWorkers.emplace_back([this, id] { WorkerLoop(id); });
+    }
+}
+
+HostThreadPool::~HostThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+
+    mWakeCondition.notify_all();
+
+    for(auto& worker : mWorkers)
+        worker.join();
+}
+
+void HostThreadPool::WorkerLoop(std::size_t id)
+{
+    if(mPinThread)
+        pin_current_thread(id);
+
+    std::size_t generation = 0;
+
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeCondition.wait(lock, [&] { return mStop || mGeneration != generation; });
+
+            if(mStop)
+                return;
+
+            generation = mGeneration;
+        }
+
+        if(id < mJobNumThread)
+            RunSlot(id);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if(--mNumPending == 0)
+            mDoneCondition.notify_one();
+    }
+}
+
+void HostThreadPool::RunSlot(std::size_t id)
+{
+    tls_in_host_thread_pool_job = true;
+
+    try
+    {
+        // own range first, then steal from the others in round-robin order
+        for(std::size_t i = 0; i < mJobNumThread; ++i)
+        {
+            WorkRange& range = mRanges[(id + i) % mJobNumThread];
+
+            while(true)
+            {
+                const std::size_t begin = range.mNext.fetch_add(mJobGrainSize);
+
+                if(begin >= range.mEnd)
+                    break;
+
+                (*mJob)(begin, std::min(begin + mJobGrainSize, range.mEnd));
+            }
+        }
+    }
+    catch(...)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if(!mJobException)
+            mJobException = std::current_exception();
+
+        // let everybody run out of work
+        for(std::size_t i = 0; i < mJobNumThread; ++i)
+            mRanges[i].mNext.store(mRanges[i].mEnd);
+    }
+
+    tls_in_host_thread_pool_job = false;
+}
+
+void HostThreadPool::ParallelFor(std::size_t n,
+                                 const RangeFunction& f,
+                                 std::size_t num_thread,
+                                 std::size_t grain_size)
+{
+    if(n == 0)
+        return;
+
+    num_thread = num_thread == 0 ? mNumThread : std::min(num_thread, mNumThread);
+    num_thread = std::min(num_thread, n);
+
+    if(grain_size == 0)
+        grain_size = std::max<std::size_t>(n / (num_thread * 16), 1);
+
+    if(num_thread <= 1 || n <= grain_size || tls_in_host_thread_pool_job)
+    {
+        f(0, n);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit_lock(mSubmitMutex);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        for(std::size_t i = 0; i < num_thread; ++i)
+        {
+            mRanges[i].mNext.store(n * i / num_thread);
+            mRanges[i].mEnd = n * (i + 1) / num_thread;
+        }
+
+        mJob          = &f;
+        mJobNumThread = num_thread;
+        mJobGrainSize = grain_size;
+        mJobException = nullptr;
+        mNumPending   = mWorkers.size();
+
+        ++mGeneration;
+    }
+
+    mWakeCondition.notify_all();
+
+    RunSlot(0);
+
+    std::exception_ptr exception;
+
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDoneCondition.wait(lock, [&] { return mNumPending == 0; });
+
+        mJob      = nullptr;
+        exception = mJobException;
+    }
+
+    if(exception)
+        std::rethrow_exception(exception);
+}
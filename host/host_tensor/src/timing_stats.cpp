@@ -0,0 +1,165 @@
+#include <cmath>
+#include <cstdlib>
+
+#include "timing_stats.hpp"
+
+namespace {
+
+// linear interpolation between the closest ranks of sorted samples
+float get_percentile(const std::vector<float>& sorted, double percent)
+{
+    const double rank   = percent / 100 * (sorted.size() - 1);
+    const std::size_t i = static_cast<std::size_t>(rank);
+
+    if(i + 1 >= sorted.size())
+        return sorted.back();
+
+    return sorted[i] + static_cast<float>(rank - i) * (sorted[i + 1] - sorted[i]);
+}
+
+thread_local TimingStatsRecorder* current_timing_stats_recorder = nullptr;
+
+} // namespace
+
+TimingOptions& TimingOptions::GetInstance()
+{
+    static TimingOptions options = [] {
+        TimingOptions env_options;
+
+        if(const char* env = std::getenv("CK_TIMING_WARMUP"))
+            env_options.mNumWarmup = std::max(0, std::atoi(env));
+
+        if(const char* env = std::getenv("CK_TIMING_MIN_MS"))
+            env_options.mMinDuration = std::max(0.f, std::strtof(env, nullptr));
+
+        return env_options;
+    }();
+
+    return options;
+}
+
+TimingStats make_timing_stats(std::vector<float> samples)
+{
+    TimingStats stats;
+
+    if(samples.empty())
+        return stats;
+
+    stats.mNumSample = static_cast<int>(samples.size());
+
+    double all_sum = 0;
+
+    for(float sample : samples)
+        all_sum += sample;
+
+    stats.mAllMean = static_cast<float>(all_sum / samples.size());
+
+    std::sort(samples.begin(), samples.end());
+
+    // median absolute deviation, scaled to estimate the standard deviation of normal noise
+    const float median = get_percentile(samples, 50);
+
+    std::vector<float> deviations(samples.size());
+
+    for(std::size_t i = 0; i < samples.size(); ++i)
+        deviations[i] = std::abs(samples[i] - median);
+
+    std::sort(deviations.begin(), deviations.end());
+
+    const float max_deviation = 3.5f * 1.4826f * get_percentile(deviations, 50);
+
+    // with a MAD of 0 (e.g. a coarse clock) nothing is rejected
+    if(max_deviation > 0)
+    {
+        samples.erase(std::remove_if(samples.begin(),
+                                     samples.end(),
+                                     [&](float sample) {
+                                         return std::abs(sample - median) > max_deviation;
+                                     }),
+                      samples.end());
+    }
+
+    const std::size_t n = samples.size();
+
+    stats.mNumOutlier = stats.mNumSample - static_cast<int>(n);
+
+    double sum = 0;
+
+    for(float sample : samples)
+        sum += sample;
+
+    const double mean = sum / n;
+
+    double sum_square = 0;
+
+    for(float sample : samples)
+        sum_square += (sample - mean) * (sample - mean);
+
+    stats.mMean   = static_cast<float>(mean);
+    stats.mMin    = samples.front();
+    stats.mMedian = get_percentile(samples, 50);
+    stats.mP90    = get_percentile(samples, 90);
+    stats.mP99    = get_percentile(samples, 99);
+    stats.mStdDev = n > 1 ? static_cast<float>(std::sqrt(sum_square / (n - 1))) : 0;
+
+    // ranks n / 2 -+ 1.96 * sqrt(n) / 2 of the sorted runs
+    const double half_width = 0.98 * std::sqrt(static_cast<double>(n));
+
+    const double low  = std::floor(n / 2.0 - half_width);
+    const double high = std::ceil(n / 2.0 + half_width);
+
+    stats.mMedianLow  = samples[static_cast<std::size_t>(std::max(low, 0.0))];
+    stats.mMedianHigh = samples[static_cast<std::size_t>(std::min(high, n - 1.0))];
+
+    return stats;
+}
+
+std::ostream& operator<<(std::ostream& os, const TimingStats& stats)
+{
+    os << "median " << stats.mMedian << " ms [" << stats.mMedianLow << ", " << stats.mMedianHigh
+       << "], min " << stats.mMin << ", mean " << stats.mMean << ", p90 " << stats.mP90
+       << ", p99 " << stats.mP99 << ", stddev " << stats.mStdDev << ", " << stats.mNumSample
+       << " runs, " << stats.mNumOutlier << " outliers";
+
+    return os;
+}
+
+TimingStatsRecorder::TimingStatsRecorder() : mOuter(current_timing_stats_recorder)
+{
+    current_timing_stats_recorder = this;
+}
+
+TimingStatsRecorder::~TimingStatsRecorder() { current_timing_stats_recorder = mOuter; }
+
+void TimingStatsRecorder::Add(const std::vector<float>& samples)
+{
+    TimingStatsRecorder* recorder = current_timing_stats_recorder;
+
+    if(recorder == nullptr)
+        return;
+
+    if(!recorder->mAdded)
+    {
+        recorder->mSamples = samples;
+        recorder->mAdded   = true;
+
+        return;
+    }
+
+    // e.g. the kernels of a multi-kernel operation, run i of each adds up to run i of the
+    // operation
+    const std::size_t n = std::min(recorder->mSamples.size(), samples.size());
+
+    recorder->mSamples.resize(n);
+
+    for(std::size_t i = 0; i < n; ++i)
+        recorder->mSamples[i] += samples[i];
+}
+
+TimingStats TimingStatsRecorder::GetStats(float ave_time) const
+{
+    if(!mAdded)
+        return make_timing_stats({ave_time});
+
+    return make_timing_stats(mSamples);
+}
@@ -0,0 +1,183 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include "tuning_db.hpp"
+
+namespace {
+
+std::map<std::string, TuningDbRecord> read_tuning_db_file(const std::string& path)
+{
+    std::map<std::string, TuningDbRecord> records;
+
+    // a missing file is an empty database
+    std::ifstream file(path);
+
+    std::string line;
+
+    while(std::getline(file, line))
+    {
+        std::istringstream is(line);
+
+        std::string key, instance, ave_time, tflops, gb_per_sec;
+
+        // skip malformed lines instead of failing the lookup of every other key
+        if(!std::getline(is, key, '\t') || !std::getline(is, instance, '\t') ||
+           !std::getline(is, ave_time, '\t') || !std::getline(is, tflops, '\t') ||
+           !std::getline(is, gb_per_sec))
+            continue;
+
+        TuningDbRecord record;
+
+        record.mInstance = instance;
+        record.mAveTime  = std::strtof(ave_time.c_str(), nullptr);
+        record.mTflops   = std::strtof(tflops.c_str(), nullptr);
+        record.mGbPerSec = std::strtof(gb_per_sec.c_str(), nullptr);
+
+        records[key] = record;
+    }
+
+    return records;
+}
+
+void write_tuning_db_file(const std::string& path,
+                          const std::map<std::string, TuningDbRecord>& records)
+{
+    // write under a temporary name, then rename over the destination
+    const std::string tmp_path = path + ".tmp." + std::to_string(getpid());
+
+    {
+        std::ofstream file(tmp_path, std::ios::trunc);
+
+        if(!file)
+            throw std::runtime_error("wrong! cannot write tuning db " + tmp_path);
+
+        file.precision(7);
+
+        for(const auto& entry : records)
+        {
+            const auto& record = entry.second;
+
+            file << entry.first << '\t' << record.mInstance << '\t' << record.mAveTime << '\t'
+                 << record.mTflops << '\t' << record.mGbPerSec << '\n';
+        }
+
+        if(!file.flush())
+        {
+            std::remove(tmp_path.c_str());
+            throw std::runtime_error("wrong! cannot write tuning db " + tmp_path);
+        }
+    }
+
+    if(std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmp_path.c_str());
+        throw std::runtime_error("wrong! cannot rename tuning db to " + path);
+    }
+}
+
+// exclusive flock() on a lock file next to the database, released when it goes out of scope
+struct TuningDbFileLock
+{
+    explicit TuningDbFileLock(const std::string& path)
+    {
+        const std::string lock_path = path + ".lock";
+
+        mFd = open(lock_path.c_str(), O_RDWR | O_CREAT, 0644);
+
+        if(mFd < 0)
+            throw std::runtime_error("wrong! cannot open tuning db lock " + lock_path);
+
+        if(flock(mFd, LOCK_EX) != 0)
+        {
+            close(mFd);
+            throw std::runtime_error("wrong! cannot lock tuning db " + lock_path);
+        }
+    }
+
+    ~TuningDbFileLock()
+    {
+        flock(mFd, LOCK_UN);
+        close(mFd);
+    }
+
+    TuningDbFileLock(const TuningDbFileLock&) = delete;
+    TuningDbFileLock& operator=(const TuningDbFileLock&) = delete;
+
+    int mFd;
+};
+
+} // namespace
+
+TuningDb& TuningDb::GetInstance()
+{
+    const char* env = std::getenv("CK_TUNING_DB");
+
+    static TuningDb db(env == nullptr || *env == '\0' ? "ck_tuning.db" : env);
+
+    return db;
+}
+
+TuningDb::TuningDb(std::string path) : mPath(std::move(path)) {}
+
+void TuningDb::Load()
+{
+    if(mLoaded)
+        return;
+
+    mRecords = read_tuning_db_file(mPath);
+    mLoaded  = true;
+}
+
+bool TuningDb::Find(const std::string& key, TuningDbRecord& record)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    Load();
+
+    const auto it = mRecords.find(key);
+
+    if(it == mRecords.end())
+        return false;
+
+    record = it->second;
+
+    return true;
+}
+
+bool TuningDb::Update(const std::string& key, const TuningDbRecord& record)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    TuningDbFileLock file_lock(mPath);
+
+    // merge into what other processes may have written since the file was read
+    mRecords = read_tuning_db_file(mPath);
+    mLoaded  = true;
+
+    const auto it = mRecords.find(key);
+
+    if(it != mRecords.end() && it->second.mInstance != record.mInstance &&
+       it->second.mAveTime <= record.mAveTime)
+        return false;
+
+    mRecords[key] = record;
+
+    write_tuning_db_file(mPath, mRecords);
+
+    return true;
+}
+
+void TuningDb::Reload()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mRecords.clear();
+    mLoaded = false;
+}
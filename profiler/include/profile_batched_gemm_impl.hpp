@@ -0,0 +1,312 @@
+#pragma once
+#include "device_batched_gemm_instance.hpp"
+#include "profile_result.hpp"
+#include "profile_tuning_db.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace device_batched_gemm_instance {
+
+using DeviceBatchedGemmNoOpPtr =
+    DeviceBatchedGemmPtr<ck::tensor_operation::element_wise::PassThrough,
+                         ck::tensor_operation::element_wise::PassThrough,
+                         ck::tensor_operation::element_wise::PassThrough>;
+
+template <>
+void add_device_batched_gemm_cpu_instance<float,
+                                          float,
+                                          float,
+                                          ck::tensor_layout::gemm::RowMajor,
+                                          ck::tensor_layout::gemm::RowMajor,
+                                          ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceBatchedGemmNoOpPtr>&);
+
+template <>
+void add_device_batched_gemm_cpu_instance<float,
+                                          float,
+                                          float,
+                                          ck::tensor_layout::gemm::RowMajor,
+                                          ck::tensor_layout::gemm::ColumnMajor,
+                                          ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceBatchedGemmNoOpPtr>&);
+
+template <>
+void add_device_batched_gemm_cpu_instance<float,
+                                          float,
+                                          float,
+                                          ck::tensor_layout::gemm::ColumnMajor,
+                                          ck::tensor_layout::gemm::RowMajor,
+                                          ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceBatchedGemmNoOpPtr>&);
+
+template <>
+void add_device_batched_gemm_cpu_instance<float,
+                                          float,
+                                          float,
+                                          ck::tensor_layout::gemm::ColumnMajor,
+                                          ck::tensor_layout::gemm::ColumnMajor,
+                                          ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceBatchedGemmNoOpPtr>&);
+
+template <>
+void add_device_batched_gemm_cpu_instance<ck::half_t,
+                                          ck::half_t,
+                                          ck::half_t,
+                                          ck::tensor_layout::gemm::RowMajor,
+                                          ck::tensor_layout::gemm::RowMajor,
+                                          ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceBatchedGemmNoOpPtr>&);
+
+template <>
+void add_device_batched_gemm_cpu_instance<ck::half_t,
+                                          ck::half_t,
+                                          ck::half_t,
+                                          ck::tensor_layout::gemm::RowMajor,
+                                          ck::tensor_layout::gemm::ColumnMajor,
+                                          ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceBatchedGemmNoOpPtr>&);
+
+template <>
+void add_device_batched_gemm_cpu_instance<ck::half_t,
+                                          ck::half_t,
+                                          ck::half_t,
+                                          ck::tensor_layout::gemm::ColumnMajor,
+                                          ck::tensor_layout::gemm::RowMajor,
+                                          ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceBatchedGemmNoOpPtr>&);
+
+template <>
+void add_device_batched_gemm_cpu_instance<ck::half_t,
+                                          ck::half_t,
+                                          ck::half_t,
+                                          ck::tensor_layout::gemm::ColumnMajor,
+                                          ck::tensor_layout::gemm::ColumnMajor,
+                                          ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceBatchedGemmNoOpPtr>&);
+
+} // namespace device_batched_gemm_instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
+
+namespace ck {
+namespace profiler {
+
+// batched GEMM instances run on the host, operands of consecutive batches are packed one after
+// the other
+template <typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename ALayout,
+          typename BLayout,
+          typename CLayout>
+void profile_batched_gemm_impl(int do_verification,
+                               int init_method,
+                               bool do_log,
+                               int nrepeat,
+                               int M,
+                               int N,
+                               int K,
+                               int StrideA,
+                               int StrideB,
+                               int StrideC,
+                               int BatchCount)
+{
+    auto f_host_tensor_descriptor = [](std::size_t batch_count,
+                                       std::size_t row,
+                                       std::size_t col,
+                                       std::size_t stride,
+                                       auto layout) {
+        if(is_same<decltype(layout), tensor_layout::gemm::RowMajor>::value)
+        {
+            return HostTensorDescriptor(std::vector<std::size_t>({batch_count, row, col}),
+                                        std::vector<std::size_t>({row * stride, stride, 1}));
+        }
+        else
+        {
+            return HostTensorDescriptor(std::vector<std::size_t>({batch_count, row, col}),
+                                        std::vector<std::size_t>({col * stride, 1, stride}));
+        }
+    };
+
+    Tensor<ADataType> a_g_m_k(f_host_tensor_descriptor(BatchCount, M, K, StrideA, ALayout{}));
+    Tensor<BDataType> b_g_k_n(f_host_tensor_descriptor(BatchCount, K, N, StrideB, BLayout{}));
+    Tensor<CDataType> c_g_m_n_host_result(
+        f_host_tensor_descriptor(BatchCount, M, N, StrideC, CLayout{}));
+    Tensor<CDataType> c_g_m_n_device_result(
+        f_host_tensor_descriptor(BatchCount, M, N, StrideC, CLayout{}));
+
+    std::cout << "a_g_m_k: " << a_g_m_k.mDesc << std::endl;
+    std::cout << "b_g_k_n: " << b_g_k_n.mDesc << std::endl;
+    std::cout << "c_g_m_n: " << c_g_m_n_host_result.mDesc << std::endl;
+
+    switch(init_method)
+    {
+    case 0: break;
+    case 1:
+        a_g_m_k.GenerateTensorValue(GeneratorTensor_2<ADataType>{-5, 5});
+        b_g_k_n.GenerateTensorValue(
+            GeneratorTensor_2<BDataType>{-5, 5, get_host_generator_seed(1)});
+        break;
+    default:
+        a_g_m_k.GenerateTensorValue(GeneratorTensor_3<ADataType>{0.0, 1.0});
+        b_g_k_n.GenerateTensorValue(
+            GeneratorTensor_3<BDataType>{-0.5, 0.5, get_host_generator_seed(1)});
+    }
+
+    if(do_verification)
+    {
+        // reused from CK_HOST_TENSOR_CACHE if the same problem was verified before. The fp64
+        // accumulation keeps the reference independent of the fp32 engine of host instances.
+        HostTensorCache::GetInstance().GetOrCreate(
+            c_g_m_n_host_result,
+            [&] {
+                return make_host_tensor_cache_key(
+                    "batched_gemm", a_g_m_k, b_g_k_n, HostGemmPrecision_t::Strict);
+            },
+            [&](auto& c_g_m_n) {
+                host_batched_gemm_g_mk_kn_mn(a_g_m_k,
+                                             b_g_k_n,
+                                             c_g_m_n,
+                                             ck::tensor_operation::element_wise::PassThrough{},
+                                             ck::tensor_operation::element_wise::PassThrough{},
+                                             ck::tensor_operation::element_wise::PassThrough{},
+                                             HostGemmPrecision_t::Strict);
+            });
+    }
+
+    const auto& a_strides = a_g_m_k.mDesc.GetStrides();
+    const auto& b_strides = b_g_k_n.mDesc.GetStrides();
+    const auto& c_strides = c_g_m_n_device_result.mDesc.GetStrides();
+
+    const ck::index_t BatchStrideA = a_strides[0];
+    const ck::index_t BatchStrideB = b_strides[0];
+    const ck::index_t BatchStrideC = c_strides[0];
+
+    // add batched GEMM instances, they work on the host tensors directly. They are built once per
+    // process and reused by every problem of a batch run.
+    static std::vector<
+        ck::tensor_operation::device::device_batched_gemm_instance::DeviceBatchedGemmNoOpPtr>
+        gemm_ptrs;
+
+    if(gemm_ptrs.empty())
+    {
+        ck::tensor_operation::device::device_batched_gemm_instance::
+            add_device_batched_gemm_cpu_instance<ADataType,
+                                                 BDataType,
+                                                 CDataType,
+                                                 ALayout,
+                                                 BLayout,
+                                                 CLayout>(gemm_ptrs);
+    }
+
+    if(gemm_ptrs.size() <= 0)
+    {
+        throw std::runtime_error("wrong! no device batched GEMM instance found");
+    }
+
+    ProfileResult result_base;
+
+    result_base.op        = "batched_gemm";
+    result_base.backend   = "host";
+    result_base.data_type = get_data_type_string<ADataType, BDataType, CDataType>();
+    result_base.layout    = get_gemm_layout_string<ALayout, BLayout, CLayout>();
+    result_base.problem   =
+        make_batched_gemm_problem(M, N, K, StrideA, StrideB, StrideC, BatchCount);
+    result_base.nrepeat   = nrepeat;
+
+    using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+    const std::string tuning_key =
+        make_tuning_db_key(result_base.op,
+                           result_base.data_type,
+                           result_base.layout,
+                           result_base.problem,
+                           get_element_wise_op_string<PassThrough, PassThrough, PassThrough>(),
+                           get_tuning_db_backend(true));
+
+    // with --use-db only the tuned instance is profiled
+    const auto tuned_ptr = ProfileTuningDb::GetInstance().FindInstance(gemm_ptrs, tuning_key);
+
+    ProfileBestInstance best;
+
+    // profile device batched GEMM instances
+    for(auto& gemm_ptr : gemm_ptrs)
+    {
+        if(tuned_ptr != nullptr && gemm_ptr.get() != tuned_ptr)
+            continue;
+
+        auto argument_ptr =
+            gemm_ptr->MakeArgumentPointer(a_g_m_k.mData.data(),
+                                          b_g_k_n.mData.data(),
+                                          c_g_m_n_device_result.mData.data(),
+                                          M,
+                                          N,
+                                          K,
+                                          StrideA,
+                                          StrideB,
+                                          StrideC,
+                                          BatchStrideA,
+                                          BatchStrideB,
+                                          BatchStrideC,
+                                          BatchCount,
+                                          ck::tensor_operation::element_wise::PassThrough{},
+                                          ck::tensor_operation::element_wise::PassThrough{},
+                                          ck::tensor_operation::element_wise::PassThrough{});
+
+        auto invoker_ptr = gemm_ptr->MakeInvokerPointer();
+
+        ProfileResult result = result_base;
+
+        result.instance  = gemm_ptr->GetTypeString();
+        result.supported = gemm_ptr->IsSupportedArgument(argument_ptr.get());
+
+        if(result.supported)
+        {
+            const TimingStats timing = invoker_ptr->RunWithStats(argument_ptr.get(), nrepeat);
+
+            std::size_t flop = std::size_t(2) * BatchCount * M * N * K;
+
+            std::size_t num_btype = (sizeof(ADataType) * M * K + sizeof(BDataType) * K * N +
+                                     sizeof(CDataType) * M * N) *
+                                    BatchCount;
+
+            best.Add(result, timing, flop, num_btype);
+
+            if(do_verification)
+            {
+                result.verification =
+                    check_error(c_g_m_n_host_result,
+                                c_g_m_n_device_result,
+                                get_default_host_compare_options<CDataType>(K))
+                        ? "pass"
+                        : "fail";
+
+                if(do_log)
+                {
+                    LogRangeAsType<float>(std::cout << "a : ", a_g_m_k.mData, ",") << std::endl;
+                    LogRangeAsType<float>(std::cout << "b: ", b_g_k_n.mData, ",") << std::endl;
+                    LogRangeAsType<float>(
+                        std::cout << "c_host  : ", c_g_m_n_host_result.mData, ",")
+                        << std::endl;
+                    LogRangeAsType<float>(
+                        std::cout << "c_device: ", c_g_m_n_device_result.mData, ",")
+                        << std::endl;
+                }
+            }
+        }
+        else
+        {
+            std::cout << "this device batched GEMM instance does not support this problem"
+                      << std::endl;
+        }
+
+        ProfileResultSink::GetInstance().Record(result);
+    }
+
+    best.Finish(tuning_key);
+}
+
+} // namespace profiler
+} // namespace ck
@@ -4,10 +4,14 @@
 #include "host_tensor.hpp"
 #include "host_tensor_generator.hpp"
 #include "host_conv.hpp"
+#include "host_conv_fwd_bias_activation.hpp"
+#include "host_timer.hpp"
 #include "tensor_layout.hpp"
 #include "device_tensor.hpp"
 #include "device_conv_fwd_bias_activation_add.hpp"
 #include "element_wise_operation.hpp"
+#include "profile_result.hpp"
+#include "profile_tuning_db.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -22,6 +26,12 @@ using DeviceConvFwdBiasReluAddPtr =
 void add_device_conv2d_fwd_xdl_c_shuffle_bias_relu_add_nhwc_kyxc_nhwk_f16_instances(
     std::vector<DeviceConvFwdBiasReluAddPtr>&);
 
+void add_device_conv2d_fwd_cpu_bias_relu_add_nhwc_kyxc_nhwk_f32_instances(
+    std::vector<DeviceConvFwdBiasReluAddPtr>&);
+
+void add_device_conv2d_fwd_cpu_bias_relu_add_nhwc_kyxc_nhwk_f16_instances(
+    std::vector<DeviceConvFwdBiasReluAddPtr>&);
+
 } // namespace device_conv2d_fwd_bias_activation_add_instance
 } // namespace device
 } // namespace tensor_operation
@@ -100,7 +110,8 @@ void profile_conv_fwd_bias_relu_add_impl(int do_verification,
                                          std::vector<ck::index_t> conv_filter_strides,
                                          std::vector<ck::index_t> conv_filter_dilations,
                                          std::vector<ck::index_t> input_left_pads,
-                                         std::vector<ck::index_t> input_right_pads)
+                                         std::vector<ck::index_t> input_right_pads,
+                                         bool run_on_host = false)
 {
     const ck::index_t Y = filter_spatial_lengths[0];
     const ck::index_t X = filter_spatial_lengths[1];
@@ -154,15 +165,21 @@ void profile_conv_fwd_bias_relu_add_impl(int do_verification,
     case 0: break;
     case 1:
         in_n_c_hi_wi.GenerateTensorValue(GeneratorTensor_2<InDataType>{-5, 5});
-        wei_k_c_y_x.GenerateTensorValue(GeneratorTensor_2<WeiDataType>{-5, 5});
-        bias_k.GenerateTensorValue(GeneratorTensor_2<OutDataType>{-5, 5});
-        resi_n_k_ho_wo.GenerateTensorValue(GeneratorTensor_2<OutDataType>{-5, 5});
+        wei_k_c_y_x.GenerateTensorValue(
+            GeneratorTensor_2<WeiDataType>{-5, 5, get_host_generator_seed(1)});
+        bias_k.GenerateTensorValue(
+            GeneratorTensor_2<OutDataType>{-5, 5, get_host_generator_seed(2)});
+        resi_n_k_ho_wo.GenerateTensorValue(
+            GeneratorTensor_2<OutDataType>{-5, 5, get_host_generator_seed(3)});
         break;
     default:
         in_n_c_hi_wi.GenerateTensorValue(GeneratorTensor_3<InDataType>{0.0, 1.0});
-        wei_k_c_y_x.GenerateTensorValue(GeneratorTensor_3<WeiDataType>{-0.5, 0.5});
-        bias_k.GenerateTensorValue(GeneratorTensor_3<OutDataType>{0.0, 1.0});
-        resi_n_k_ho_wo.GenerateTensorValue(GeneratorTensor_3<OutDataType>{0.0, 1.0});
+        wei_k_c_y_x.GenerateTensorValue(
+            GeneratorTensor_3<WeiDataType>{-0.5, 0.5, get_host_generator_seed(1)});
+        bias_k.GenerateTensorValue(
+            GeneratorTensor_3<OutDataType>{0.0, 1.0, get_host_generator_seed(2)});
+        resi_n_k_ho_wo.GenerateTensorValue(
+            GeneratorTensor_3<OutDataType>{0.0, 1.0, get_host_generator_seed(3)});
     }
 
     using InElementOp  = ck::tensor_operation::element_wise::PassThrough;
@@ -185,30 +202,70 @@ void profile_conv_fwd_bias_relu_add_impl(int do_verification,
                                    OutElementOp{});
     }
 
-    DeviceMem in_device_buf(sizeof(InDataType) * in_n_c_hi_wi.mDesc.GetElementSpace());
-    DeviceMem wei_device_buf(sizeof(WeiDataType) * wei_k_c_y_x.mDesc.GetElementSpace());
-    DeviceMem out_device_buf(sizeof(OutDataType) *
-                             out_n_k_ho_wo_device_result.mDesc.GetElementSpace());
-    DeviceMem bias_device_buf(sizeof(OutDataType) * bias_k.mDesc.GetElementSpace());
-    DeviceMem resi_device_buf(sizeof(OutDataType) * resi_n_k_ho_wo.mDesc.GetElementSpace());
-
-    in_device_buf.ToDevice(in_n_c_hi_wi.mData.data());
-    wei_device_buf.ToDevice(wei_k_c_y_x.mData.data());
-    bias_device_buf.ToDevice(bias_k.mData.data());
-    resi_device_buf.ToDevice(resi_n_k_ho_wo.mData.data());
-
     using DeviceConvFwdBiasReluAddPtr = ck::tensor_operation::device::
         DeviceConvFwdBiasActivationAddPtr<InElementOp, WeiElementOp, OutElementOp>;
 
-    // add device operator instances
+    // add operator instances, host instances work on the host tensors directly
     std::vector<DeviceConvFwdBiasReluAddPtr> op_ptrs;
 
-    if constexpr(ck::is_same_v<ck::remove_cv_t<InDataType>, ck::half_t> &&
-                 ck::is_same_v<ck::remove_cv_t<WeiDataType>, ck::half_t> &&
-                 ck::is_same_v<ck::remove_cv_t<OutDataType>, ck::half_t>)
+    std::unique_ptr<DeviceMem> in_device_buf, wei_device_buf, out_device_buf, bias_device_buf,
+        resi_device_buf;
+
+    const void* p_in   = in_n_c_hi_wi.mData.data();
+    const void* p_wei  = wei_k_c_y_x.mData.data();
+    void* p_out        = out_n_k_ho_wo_device_result.mData.data();
+    const void* p_bias = bias_k.mData.data();
+    const void* p_resi = resi_n_k_ho_wo.mData.data();
+
+    if(run_on_host)
     {
-        ck::tensor_operation::device::device_conv2d_fwd_bias_activation_add_instance::
-            add_device_conv2d_fwd_xdl_c_shuffle_bias_relu_add_nhwc_kyxc_nhwk_f16_instances(op_ptrs);
+        if constexpr(ck::is_same_v<ck::remove_cv_t<InDataType>, float> &&
+                     ck::is_same_v<ck::remove_cv_t<WeiDataType>, float> &&
+                     ck::is_same_v<ck::remove_cv_t<OutDataType>, float>)
+        {
+            ck::tensor_operation::device::device_conv2d_fwd_bias_activation_add_instance::
+                add_device_conv2d_fwd_cpu_bias_relu_add_nhwc_kyxc_nhwk_f32_instances(op_ptrs);
+        }
+        else if constexpr(ck::is_same_v<ck::remove_cv_t<InDataType>, ck::half_t> &&
+                          ck::is_same_v<ck::remove_cv_t<WeiDataType>, ck::half_t> &&
+                          ck::is_same_v<ck::remove_cv_t<OutDataType>, ck::half_t>)
+        {
+            ck::tensor_operation::device::device_conv2d_fwd_bias_activation_add_instance::
+                add_device_conv2d_fwd_cpu_bias_relu_add_nhwc_kyxc_nhwk_f16_instances(op_ptrs);
+        }
+    }
+    else
+    {
+        in_device_buf = std::make_unique<DeviceMem>(sizeof(InDataType) *
+                                                    in_n_c_hi_wi.mDesc.GetElementSpace());
+        wei_device_buf = std::make_unique<DeviceMem>(sizeof(WeiDataType) *
+                                                     wei_k_c_y_x.mDesc.GetElementSpace());
+        out_device_buf = std::make_unique<DeviceMem>(
+            sizeof(OutDataType) * out_n_k_ho_wo_device_result.mDesc.GetElementSpace());
+        bias_device_buf =
+            std::make_unique<DeviceMem>(sizeof(OutDataType) * bias_k.mDesc.GetElementSpace());
+        resi_device_buf = std::make_unique<DeviceMem>(sizeof(OutDataType) *
+                                                      resi_n_k_ho_wo.mDesc.GetElementSpace());
+
+        in_device_buf->ToDevice(in_n_c_hi_wi.mData.data());
+        wei_device_buf->ToDevice(wei_k_c_y_x.mData.data());
+        bias_device_buf->ToDevice(bias_k.mData.data());
+        resi_device_buf->ToDevice(resi_n_k_ho_wo.mData.data());
+
+        p_in   = in_device_buf->GetDeviceBuffer();
+        p_wei  = wei_device_buf->GetDeviceBuffer();
+        p_out  = out_device_buf->GetDeviceBuffer();
+        p_bias = bias_device_buf->GetDeviceBuffer();
+        p_resi = resi_device_buf->GetDeviceBuffer();
+
+        if constexpr(ck::is_same_v<ck::remove_cv_t<InDataType>, ck::half_t> &&
+                     ck::is_same_v<ck::remove_cv_t<WeiDataType>, ck::half_t> &&
+                     ck::is_same_v<ck::remove_cv_t<OutDataType>, ck::half_t>)
+        {
+            ck::tensor_operation::device::device_conv2d_fwd_bias_activation_add_instance::
+                add_device_conv2d_fwd_xdl_c_shuffle_bias_relu_add_nhwc_kyxc_nhwk_f16_instances(
+                    op_ptrs);
+        }
     }
 
     if(op_ptrs.size() <= 0)
@@ -216,41 +273,71 @@ void profile_conv_fwd_bias_relu_add_impl(int do_verification,
         throw std::runtime_error("wrong! no device Conv instance found");
     }
 
-    std::string best_conv_name;
-    float best_ave_time   = 0;
-    float best_tflops     = 0;
-    float best_gb_per_sec = 0;
+    ProfileResult result_base;
+
+    result_base.op        = "conv_fwd_bias_relu_add";
+    result_base.backend   = run_on_host ? "host" : "device";
+    result_base.data_type = get_data_type_string<InDataType, WeiDataType, OutDataType>();
+    result_base.layout    = get_conv_layout_string<InLayout, WeiLayout, OutLayout>();
+    result_base.problem   = make_conv_fwd_problem(N,
+                                                K,
+                                                C,
+                                                input_spatial_lengths,
+                                                filter_spatial_lengths,
+                                                conv_filter_strides,
+                                                conv_filter_dilations,
+                                                input_left_pads,
+                                                input_right_pads);
+    result_base.nrepeat   = nrepeat;
+
+    const std::string tuning_key =
+        make_tuning_db_key(result_base.op,
+                           result_base.data_type,
+                           result_base.layout,
+                           result_base.problem,
+                           get_element_wise_op_string<InElementOp, WeiElementOp, OutElementOp>(),
+                           get_tuning_db_backend(run_on_host));
+
+    // with --use-db only the tuned instance is profiled
+    const auto tuned_ptr = ProfileTuningDb::GetInstance().FindInstance(op_ptrs, tuning_key);
+
+    ProfileBestInstance best;
 
     // profile device Conv instances
     for(auto& op_ptr : op_ptrs)
     {
-        auto argument_ptr = op_ptr->MakeArgumentPointer(
-            static_cast<const InDataType*>(in_device_buf.GetDeviceBuffer()),
-            static_cast<const WeiDataType*>(wei_device_buf.GetDeviceBuffer()),
-            static_cast<OutDataType*>(out_device_buf.GetDeviceBuffer()),
-            static_cast<const OutDataType*>(bias_device_buf.GetDeviceBuffer()),
-            static_cast<const OutDataType*>(resi_device_buf.GetDeviceBuffer()),
-            N,
-            K,
-            C,
-            input_spatial_lengths,
-            filter_spatial_lengths,
-            output_spatial_lengths,
-            conv_filter_strides,
-            conv_filter_dilations,
-            input_left_pads,
-            input_right_pads,
-            InElementOp{},
-            WeiElementOp{},
-            OutElementOp{});
+        if(tuned_ptr != nullptr && op_ptr.get() != tuned_ptr)
+            continue;
+
+        auto argument_ptr = op_ptr->MakeArgumentPointer(p_in,
+                                                        p_wei,
+                                                        p_out,
+                                                        p_bias,
+                                                        p_resi,
+                                                        N,
+                                                        K,
+                                                        C,
+                                                        input_spatial_lengths,
+                                                        filter_spatial_lengths,
+                                                        output_spatial_lengths,
+                                                        conv_filter_strides,
+                                                        conv_filter_dilations,
+                                                        input_left_pads,
+                                                        input_right_pads,
+                                                        InElementOp{},
+                                                        WeiElementOp{},
+                                                        OutElementOp{});
 
         auto invoker_ptr = op_ptr->MakeInvokerPointer();
 
-        if(op_ptr->IsSupportedArgument(argument_ptr.get()))
-        {
-            std::string conv_name = op_ptr->GetTypeString();
+        ProfileResult result = result_base;
 
-            float ave_time = invoker_ptr->Run(argument_ptr.get(), nrepeat);
+        result.instance  = op_ptr->GetTypeString();
+        result.supported = op_ptr->IsSupportedArgument(argument_ptr.get());
+
+        if(result.supported)
+        {
+            const TimingStats timing = invoker_ptr->RunWithStats(argument_ptr.get(), nrepeat);
 
             std::size_t flop = std::size_t(2) * N * K * Ho * Wo * C * Y * X;
 
@@ -259,26 +346,21 @@ void profile_conv_fwd_bias_relu_add_impl(int do_verification,
                 sizeof(OutDataType) * (N * K * Ho * Wo) + sizeof(OutDataType) * (K) +
                 sizeof(OutDataType) * (N * K * Ho * Wo);
 
-            float tflops = static_cast<float>(flop) / 1.E9 / ave_time;
-
-            float gb_per_sec = num_btype / 1.E6 / ave_time;
-
-            std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
-                      << " GB/s, " << conv_name << std::endl;
-
-            if(tflops > best_tflops)
-            {
-                best_conv_name  = conv_name;
-                best_tflops     = tflops;
-                best_ave_time   = ave_time;
-                best_gb_per_sec = gb_per_sec;
-            }
+            best.Add(result, timing, flop, num_btype);
 
             if(do_verification)
             {
-                out_device_buf.FromDevice(out_n_k_ho_wo_device_result.mData.data());
+                if(!run_on_host)
+                {
+                    out_device_buf->FromDevice(out_n_k_ho_wo_device_result.mData.data());
+                }
 
-                check_error(out_n_k_ho_wo_host_result, out_n_k_ho_wo_device_result);
+                result.verification =
+                    check_error(out_n_k_ho_wo_host_result,
+                                out_n_k_ho_wo_device_result,
+                                get_default_host_compare_options<OutDataType>(C * Y * X))
+                        ? "pass"
+                        : "fail";
 
                 if(do_log)
                 {
@@ -295,10 +377,59 @@ void profile_conv_fwd_bias_relu_add_impl(int do_verification,
                 }
             }
         }
+
+        ProfileResultSink::GetInstance().Record(result);
     }
 
-    std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
-              << best_gb_per_sec << " GB/s, " << best_conv_name << std::endl;
+    best.Finish(tuning_key);
+
+    if(run_on_host)
+    {
+        // the same conv with bias, ReLU and add in a separate element-wise pass, to measure what
+        // the fused epilogue saves
+        auto f_pair = [](const std::vector<ck::index_t>& v) {
+            return std::array<std::size_t, 2>{static_cast<std::size_t>(v[0]),
+                                              static_cast<std::size_t>(v[1])};
+        };
+
+        const auto problem = make_HostConvProblem(in_n_c_hi_wi.mDesc,
+                                                  wei_k_c_y_x.mDesc,
+                                                  out_n_k_ho_wo_device_result.mDesc,
+                                                  f_pair(conv_filter_strides),
+                                                  f_pair(conv_filter_dilations),
+                                                  f_pair(input_left_pads),
+                                                  f_pair(input_right_pads),
+                                                  HostConvTensorLayout_t::NCHW);
+
+        using Epilogue = HostConvBiasActivationAddEpilogue<OutDataType, OutDataType, OutElementOp>;
+
+        const Epilogue epilogue{{},
+                                bias_k.mData.data(),
+                                resi_n_k_ho_wo.mData.data(),
+                                problem.OutStrides,
+                                OutElementOp{}};
+
+        auto f_unfused = [&]() {
+            host_conv_fwd_bias_activation_unfused<float>(problem,
+                                                         in_n_c_hi_wi.mData.data(),
+                                                         wei_k_c_y_x.mData.data(),
+                                                         out_n_k_ho_wo_device_result.mData.data(),
+                                                         epilogue);
+        };
+
+        const float unfused_time = launch_and_time_host_kernel(f_unfused, nrepeat);
+
+        const auto traffic = get_host_conv_bias_activation_traffic(
+            problem, sizeof(InDataType), sizeof(WeiDataType), sizeof(OutDataType), true);
+
+        std::cout << "Unfused Perf: " << unfused_time << " ms, "
+                  << traffic.unfused_bytes / 1.E6 / unfused_time << " GB/s" << std::endl;
+
+        std::cout << "Traffic: fused " << traffic.fused_bytes / 1.E6 << " MB, unfused "
+                  << traffic.unfused_bytes / 1.E6 << " MB, saving "
+                  << 100.0 * (traffic.unfused_bytes - traffic.fused_bytes) / traffic.unfused_bytes
+                  << " %, speedup " << unfused_time / best_ave_time << std::endl;
+    }
 }
 
 } // namespace profiler
@@ -8,6 +8,8 @@
 #include "device_tensor.hpp"
 #include "device_conv_fwd_bias_activation.hpp"
 #include "element_wise_operation.hpp"
+#include "profile_result.hpp"
+#include "profile_tuning_db.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -178,13 +180,17 @@ void profile_conv_fwd_bias_relu_atomic_add_impl(int do_verification,
     case 0: break;
     case 1:
         in_n_c_hi_wi.GenerateTensorValue(GeneratorTensor_2<InDataType>{-5, 5});
-        wei_k_c_y_x.GenerateTensorValue(GeneratorTensor_2<WeiDataType>{-5, 5});
-        bias_k.GenerateTensorValue(GeneratorTensor_2<OutDataType>{-5, 5});
+        wei_k_c_y_x.GenerateTensorValue(
+            GeneratorTensor_2<WeiDataType>{-5, 5, get_host_generator_seed(1)});
+        bias_k.GenerateTensorValue(
+            GeneratorTensor_2<OutDataType>{-5, 5, get_host_generator_seed(2)});
         break;
     default:
         in_n_c_hi_wi.GenerateTensorValue(GeneratorTensor_3<InDataType>{0.0, 1.0});
-        wei_k_c_y_x.GenerateTensorValue(GeneratorTensor_3<WeiDataType>{-0.5, 0.5});
-        bias_k.GenerateTensorValue(GeneratorTensor_3<OutDataType>{0.0, 1.0});
+        wei_k_c_y_x.GenerateTensorValue(
+            GeneratorTensor_3<WeiDataType>{-0.5, 0.5, get_host_generator_seed(1)});
+        bias_k.GenerateTensorValue(
+            GeneratorTensor_3<OutDataType>{0.0, 1.0, get_host_generator_seed(2)});
     }
 
     using InElementOp  = ck::tensor_operation::element_wise::PassThrough;
@@ -241,14 +247,42 @@ void profile_conv_fwd_bias_relu_atomic_add_impl(int do_verification,
         throw std::runtime_error("wrong! no device Conv instance found");
     }
 
-    std::string best_conv_name;
-    float best_ave_time   = 0;
-    float best_tflops     = 0;
-    float best_gb_per_sec = 0;
+    ProfileResult result_base;
+
+    result_base.op        = "conv_fwd_bias_relu_atomic_add";
+    result_base.backend   = "device";
+    result_base.data_type = get_data_type_string<InDataType, WeiDataType, OutDataType>();
+    result_base.layout    = get_conv_layout_string<InLayout, WeiLayout, OutLayout>();
+    result_base.problem   = make_conv_fwd_problem(N,
+                                                K,
+                                                C,
+                                                input_spatial_lengths,
+                                                filter_spatial_lengths,
+                                                conv_filter_strides,
+                                                conv_filter_dilations,
+                                                input_left_pads,
+                                                input_right_pads);
+    result_base.nrepeat   = nrepeat;
+
+    const std::string tuning_key =
+        make_tuning_db_key(result_base.op,
+                           result_base.data_type,
+                           result_base.layout,
+                           result_base.problem,
+                           get_element_wise_op_string<InElementOp, WeiElementOp, OutElementOp>(),
+                           get_tuning_db_backend(false));
+
+    // with --use-db only the tuned instance is profiled
+    const auto tuned_ptr = ProfileTuningDb::GetInstance().FindInstance(op_ptrs, tuning_key);
+
+    ProfileBestInstance best;
 
     // profile device Conv instances
     for(auto& op_ptr : op_ptrs)
     {
+        if(tuned_ptr != nullptr && op_ptr.get() != tuned_ptr)
+            continue;
+
         auto argument_ptr = op_ptr->MakeArgumentPointer(
             static_cast<const InDataType*>(in_device_buf.GetDeviceBuffer()),
             static_cast<const WeiDataType*>(wei_device_buf.GetDeviceBuffer()),
@@ -270,11 +304,14 @@ void profile_conv_fwd_bias_relu_atomic_add_impl(int do_verification,
 
         auto invoker_ptr = op_ptr->MakeInvokerPointer();
 
-        if(op_ptr->IsSupportedArgument(argument_ptr.get()))
-        {
-            std::string conv_name = op_ptr->GetTypeString();
+        ProfileResult result = result_base;
 
-            float ave_time = invoker_ptr->Run(argument_ptr.get(), nrepeat);
+        result.instance  = op_ptr->GetTypeString();
+        result.supported = op_ptr->IsSupportedArgument(argument_ptr.get());
+
+        if(result.supported)
+        {
+            const TimingStats timing = invoker_ptr->RunWithStats(argument_ptr.get(), nrepeat);
 
             std::size_t flop = std::size_t(2) * N * K * Ho * Wo * C * Y * X;
 
@@ -282,26 +319,18 @@ void profile_conv_fwd_bias_relu_atomic_add_impl(int do_verification,
                 sizeof(InDataType) * (N * C * Hi * Wi) + sizeof(WeiDataType) * (K * C * Y * X) +
                 sizeof(OutDataType) * (N * K * Ho * Wo) + sizeof(OutDataType) * (K);
 
-            float tflops = static_cast<float>(flop) / 1.E9 / ave_time;
-
-            float gb_per_sec = num_btype / 1.E6 / ave_time;
-
-            std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
-                      << " GB/s, " << conv_name << std::endl;
-
-            if(tflops > best_tflops)
-            {
-                best_conv_name  = conv_name;
-                best_tflops     = tflops;
-                best_ave_time   = ave_time;
-                best_gb_per_sec = gb_per_sec;
-            }
+            best.Add(result, timing, flop, num_btype);
 
             if(do_verification)
             {
                 out_device_buf.FromDevice(out_n_k_ho_wo_device_result.mData.data());
 
-                check_error(out_n_k_ho_wo_host_result, out_n_k_ho_wo_device_result);
+                result.verification =
+                    check_error(out_n_k_ho_wo_host_result,
+                                out_n_k_ho_wo_device_result,
+                                get_default_host_compare_options<OutDataType>(C * Y * X))
+                        ? "pass"
+                        : "fail";
 
                 if(do_log)
                 {
@@ -318,10 +347,11 @@ void profile_conv_fwd_bias_relu_atomic_add_impl(int do_verification,
                 }
             }
         }
+
+        ProfileResultSink::GetInstance().Record(result);
     }
 
-    std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
-              << best_gb_per_sec << " GB/s, " << best_conv_name << std::endl;
+    best.Finish(tuning_key);
 }
 
 } // namespace profiler
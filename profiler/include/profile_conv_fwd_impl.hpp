@@ -3,11 +3,15 @@
 #include "device.hpp"
 #include "host_tensor.hpp"
 #include "host_tensor_generator.hpp"
+#include "host_tensor_file.hpp"
 #include "host_conv.hpp"
 #include "tensor_layout.hpp"
 #include "device_tensor.hpp"
 #include "device_conv_fwd.hpp"
 #include "element_wise_operation.hpp"
+#include "profile_result.hpp"
+#include "profile_tuning_db.hpp"
+#include "profile_verifier.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -25,6 +29,10 @@ void add_device_conv2d_fwd_xdl_nhwc_kyxc_nhwk_f16_instances(std::vector<DeviceCo
 void add_device_conv2d_fwd_xdl_c_shuffle_nhwc_kyxc_nhwk_f16_instances(
     std::vector<DeviceConvFwdNoOpPtr>&);
 
+void add_device_conv2d_fwd_cpu_nhwc_kyxc_nhwk_f32_instances(std::vector<DeviceConvFwdNoOpPtr>&);
+
+void add_device_conv2d_fwd_cpu_nhwc_kyxc_nhwk_f16_instances(std::vector<DeviceConvFwdNoOpPtr>&);
+
 } // namespace device_conv2d_fwd_instance
 } // namespace device
 } // namespace tensor_operation
@@ -53,7 +61,8 @@ void profile_conv_fwd_impl(int do_verification,
                            std::vector<ck::index_t> conv_filter_strides,
                            std::vector<ck::index_t> conv_filter_dilations,
                            std::vector<ck::index_t> input_left_pads,
-                           std::vector<ck::index_t> input_right_pads)
+                           std::vector<ck::index_t> input_right_pads,
+                           bool run_on_host = false)
 {
     const ck::index_t Y = filter_spatial_lengths[0];
     const ck::index_t X = filter_spatial_lengths[1];
@@ -98,56 +107,127 @@ void profile_conv_fwd_impl(int do_verification,
     case 0: break;
     case 1:
         in_n_c_hi_wi.GenerateTensorValue(GeneratorTensor_2<InDataType>{-5, 5});
-        wei_k_c_y_x.GenerateTensorValue(GeneratorTensor_2<WeiDataType>{-5, 5});
+        wei_k_c_y_x.GenerateTensorValue(
+            GeneratorTensor_2<WeiDataType>{-5, 5, get_host_generator_seed(1)});
         break;
     default:
         in_n_c_hi_wi.GenerateTensorValue(GeneratorTensor_3<InDataType>{0.0, 1.0});
-        wei_k_c_y_x.GenerateTensorValue(GeneratorTensor_3<WeiDataType>{-0.5, 0.5});
+        wei_k_c_y_x.GenerateTensorValue(
+            GeneratorTensor_3<WeiDataType>{-0.5, 0.5, get_host_generator_seed(1)});
     }
 
+    // the host reference and the checks run in the background while device instances are timed,
+    // host instances would compete with them for the host threads
+    ProfileVerifier verifier(!run_on_host);
+
     if(do_verification)
     {
-        host_conv_nchw_kcyx_nkhw(in_n_c_hi_wi,
-                                 wei_k_c_y_x,
-                                 out_n_k_ho_wo_host_result,
-                                 conv_filter_strides,
-                                 conv_filter_dilations,
-                                 input_left_pads,
-                                 input_right_pads);
+        verifier.Submit([&] {
+            // reused from CK_HOST_TENSOR_CACHE if the same problem was verified before. The fp64
+            // accumulation keeps the reference independent of the fp32 engine of host instances.
+            HostTensorCache::GetInstance().GetOrCreate(
+                out_n_k_ho_wo_host_result,
+                [&] {
+                    return make_host_tensor_cache_key("conv_fwd",
+                                                      in_n_c_hi_wi,
+                                                      wei_k_c_y_x,
+                                                      conv_filter_strides,
+                                                      conv_filter_dilations,
+                                                      input_left_pads,
+                                                      input_right_pads,
+                                                      HostGemmPrecision_t::Strict);
+                },
+                [&](auto& out) {
+                    host_conv_nchw_kcyx_nkhw(in_n_c_hi_wi,
+                                             wei_k_c_y_x,
+                                             out,
+                                             conv_filter_strides,
+                                             conv_filter_dilations,
+                                             input_left_pads,
+                                             input_right_pads,
+                                             HostGemmPrecision_t::Strict);
+                });
+        });
     }
 
-    DeviceMem in_device_buf(sizeof(InDataType) * in_n_c_hi_wi.mDesc.GetElementSpace());
-    DeviceMem wei_device_buf(sizeof(WeiDataType) * wei_k_c_y_x.mDesc.GetElementSpace());
-    DeviceMem out_device_buf(sizeof(OutDataType) *
-                             out_n_k_ho_wo_device_result.mDesc.GetElementSpace());
-
-    in_device_buf.ToDevice(in_n_c_hi_wi.mData.data());
-    wei_device_buf.ToDevice(wei_k_c_y_x.mData.data());
-
     using PassThrough = ck::tensor_operation::element_wise::PassThrough;
 
     using DeviceConvFwdNoOpPtr =
         ck::tensor_operation::device::DeviceConvFwdPtr<PassThrough, PassThrough, PassThrough>;
 
-    // add device Conv instances
-    std::vector<DeviceConvFwdNoOpPtr> conv_ptrs;
+    // add Conv instances, host instances work on the host tensors directly. They are built once
+    // per process and reused by every problem of a batch run.
+    static std::vector<DeviceConvFwdNoOpPtr> host_conv_ptrs, device_conv_ptrs;
 
-    if constexpr(ck::is_same_v<ck::remove_cv_t<InDataType>, float> &&
-                 ck::is_same_v<ck::remove_cv_t<WeiDataType>, float> &&
-                 ck::is_same_v<ck::remove_cv_t<OutDataType>, float>)
+    auto& conv_ptrs = run_on_host ? host_conv_ptrs : device_conv_ptrs;
+
+    const std::size_t in_bytes  = sizeof(InDataType) * in_n_c_hi_wi.mDesc.GetElementSpace();
+    const std::size_t wei_bytes = sizeof(WeiDataType) * wei_k_c_y_x.mDesc.GetElementSpace();
+    const std::size_t out_bytes =
+        sizeof(OutDataType) * out_n_k_ho_wo_device_result.mDesc.GetElementSpace();
+
+    DeviceMem* out_device_buf = nullptr;
+
+    const void* p_in  = in_n_c_hi_wi.mData.data();
+    const void* p_wei = wei_k_c_y_x.mData.data();
+    void* p_out       = out_n_k_ho_wo_device_result.mData.data();
+
+    if(run_on_host)
     {
-        ck::tensor_operation::device::device_conv2d_fwd_instance::
-            add_device_conv2d_fwd_xdl_nhwc_kyxc_nhwk_f32_instances(conv_ptrs);
+        if(conv_ptrs.empty())
+        {
+            if constexpr(ck::is_same_v<ck::remove_cv_t<InDataType>, float> &&
+                         ck::is_same_v<ck::remove_cv_t<WeiDataType>, float> &&
+                         ck::is_same_v<ck::remove_cv_t<OutDataType>, float>)
+            {
+                ck::tensor_operation::device::device_conv2d_fwd_instance::
+                    add_device_conv2d_fwd_cpu_nhwc_kyxc_nhwk_f32_instances(conv_ptrs);
+            }
+            else if constexpr(ck::is_same_v<ck::remove_cv_t<InDataType>, ck::half_t> &&
+                              ck::is_same_v<ck::remove_cv_t<WeiDataType>, ck::half_t> &&
+                              ck::is_same_v<ck::remove_cv_t<OutDataType>, ck::half_t>)
+            {
+                ck::tensor_operation::device::device_conv2d_fwd_instance::
+                    add_device_conv2d_fwd_cpu_nhwc_kyxc_nhwk_f16_instances(conv_ptrs);
+            }
+        }
     }
-    else if constexpr(ck::is_same_v<ck::remove_cv_t<InDataType>, ck::half_t> &&
-                      ck::is_same_v<ck::remove_cv_t<WeiDataType>, ck::half_t> &&
-                      ck::is_same_v<ck::remove_cv_t<OutDataType>, ck::half_t>)
+    else
     {
-        ck::tensor_operation::device::device_conv2d_fwd_instance::
-            add_device_conv2d_fwd_xdl_nhwc_kyxc_nhwk_f16_instances(conv_ptrs);
+        // grow-only buffers, a batch run only allocates for problems larger than the ones before
+        auto& device_mem_pool = DeviceMemPool::GetInstance();
 
-        ck::tensor_operation::device::device_conv2d_fwd_instance::
-            add_device_conv2d_fwd_xdl_c_shuffle_nhwc_kyxc_nhwk_f16_instances(conv_ptrs);
+        DeviceMem& in_device_buf  = device_mem_pool.Get(0, in_bytes);
+        DeviceMem& wei_device_buf = device_mem_pool.Get(1, wei_bytes);
+        out_device_buf            = &device_mem_pool.Get(2, out_bytes);
+
+        in_device_buf.ToDevice(in_n_c_hi_wi.mData.data(), in_bytes);
+        wei_device_buf.ToDevice(wei_k_c_y_x.mData.data(), wei_bytes);
+
+        p_in  = in_device_buf.GetDeviceBuffer();
+        p_wei = wei_device_buf.GetDeviceBuffer();
+        p_out = out_device_buf->GetDeviceBuffer();
+
+        if(conv_ptrs.empty())
+        {
+            if constexpr(ck::is_same_v<ck::remove_cv_t<InDataType>, float> &&
+                         ck::is_same_v<ck::remove_cv_t<WeiDataType>, float> &&
+                         ck::is_same_v<ck::remove_cv_t<OutDataType>, float>)
+            {
+                ck::tensor_operation::device::device_conv2d_fwd_instance::
+                    add_device_conv2d_fwd_xdl_nhwc_kyxc_nhwk_f32_instances(conv_ptrs);
+            }
+            else if constexpr(ck::is_same_v<ck::remove_cv_t<InDataType>, ck::half_t> &&
+                              ck::is_same_v<ck::remove_cv_t<WeiDataType>, ck::half_t> &&
+                              ck::is_same_v<ck::remove_cv_t<OutDataType>, ck::half_t>)
+            {
+                ck::tensor_operation::device::device_conv2d_fwd_instance::
+                    add_device_conv2d_fwd_xdl_nhwc_kyxc_nhwk_f16_instances(conv_ptrs);
+
+                ck::tensor_operation::device::device_conv2d_fwd_instance::
+                    add_device_conv2d_fwd_xdl_c_shuffle_nhwc_kyxc_nhwk_f16_instances(conv_ptrs);
+            }
+        }
     }
 
     if(conv_ptrs.size() <= 0)
@@ -155,39 +235,80 @@ void profile_conv_fwd_impl(int do_verification,
         throw std::runtime_error("wrong! no device Conv instance found");
     }
 
-    std::string best_conv_name;
-    float best_ave_time   = 0;
-    float best_tflops     = 0;
-    float best_gb_per_sec = 0;
+    ProfileResult result_base;
+
+    result_base.op        = "conv_fwd";
+    result_base.backend   = run_on_host ? "host" : "device";
+    result_base.data_type = get_data_type_string<InDataType, WeiDataType, OutDataType>();
+    result_base.layout    = get_conv_layout_string<InLayout, WeiLayout, OutLayout>();
+    result_base.problem   = make_conv_fwd_problem(N,
+                                                K,
+                                                C,
+                                                input_spatial_lengths,
+                                                filter_spatial_lengths,
+                                                conv_filter_strides,
+                                                conv_filter_dilations,
+                                                input_left_pads,
+                                                input_right_pads);
+    result_base.nrepeat   = nrepeat;
+
+    const std::string tuning_key =
+        make_tuning_db_key(result_base.op,
+                           result_base.data_type,
+                           result_base.layout,
+                           result_base.problem,
+                           get_element_wise_op_string<PassThrough, PassThrough, PassThrough>(),
+                           get_tuning_db_backend(run_on_host));
+
+    // with --use-db only the tuned instance is profiled
+    const auto tuned_ptr = ProfileTuningDb::GetInstance().FindInstance(conv_ptrs, tuning_key);
+
+    auto f_log = [&](const Tensor<OutDataType>& out_checked) {
+        if(!do_log)
+            return;
+
+        LogRangeAsType<float>(std::cout << "in : ", in_n_c_hi_wi.mData, ",") << std::endl;
+        LogRangeAsType<float>(std::cout << "wei: ", wei_k_c_y_x.mData, ",") << std::endl;
+        LogRangeAsType<float>(std::cout << "out_host  : ", out_n_k_ho_wo_host_result.mData, ",")
+            << std::endl;
+        LogRangeAsType<float>(std::cout << "out_device: ", out_checked.mData, ",") << std::endl;
+    };
+
+    ProfileBestInstance best;
 
     // profile device Conv instances
     for(auto& conv_ptr : conv_ptrs)
     {
-        auto argument_ptr = conv_ptr->MakeArgumentPointer(
-            static_cast<InDataType*>(in_device_buf.GetDeviceBuffer()),
-            static_cast<WeiDataType*>(wei_device_buf.GetDeviceBuffer()),
-            static_cast<OutDataType*>(out_device_buf.GetDeviceBuffer()),
-            N,
-            K,
-            C,
-            input_spatial_lengths,
-            filter_spatial_lengths,
-            output_spatial_lengths,
-            conv_filter_strides,
-            conv_filter_dilations,
-            input_left_pads,
-            input_right_pads,
-            PassThrough{},
-            PassThrough{},
-            PassThrough{});
+        if(tuned_ptr != nullptr && conv_ptr.get() != tuned_ptr)
+            continue;
+
+        auto argument_ptr = conv_ptr->MakeArgumentPointer(p_in,
+                                                          p_wei,
+                                                          p_out,
+                                                          N,
+                                                          K,
+                                                          C,
+                                                          input_spatial_lengths,
+                                                          filter_spatial_lengths,
+                                                          output_spatial_lengths,
+                                                          conv_filter_strides,
+                                                          conv_filter_dilations,
+                                                          input_left_pads,
+                                                          input_right_pads,
+                                                          PassThrough{},
+                                                          PassThrough{},
+                                                          PassThrough{});
 
         auto invoker_ptr = conv_ptr->MakeInvokerPointer();
 
-        if(conv_ptr->IsSupportedArgument(argument_ptr.get()))
-        {
-            std::string conv_name = conv_ptr->GetTypeString();
+        ProfileResult result = result_base;
+
+        result.instance  = conv_ptr->GetTypeString();
+        result.supported = conv_ptr->IsSupportedArgument(argument_ptr.get());
 
-            float ave_time = invoker_ptr->Run(argument_ptr.get(), nrepeat);
+        if(result.supported)
+        {
+            const TimingStats timing = invoker_ptr->RunWithStats(argument_ptr.get(), nrepeat);
 
             std::size_t flop = std::size_t(2) * N * K * Ho * Wo * C * Y * X;
 
@@ -195,46 +316,33 @@ void profile_conv_fwd_impl(int do_verification,
                                     sizeof(WeiDataType) * (K * C * Y * X) +
                                     sizeof(OutDataType) * (N * K * Ho * Wo);
 
-            float tflops = static_cast<float>(flop) / 1.E9 / ave_time;
-
-            float gb_per_sec = num_btype / 1.E6 / ave_time;
-
-            std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
-                      << " GB/s, " << conv_name << std::endl;
-
-            if(tflops > best_tflops)
-            {
-                best_conv_name  = conv_name;
-                best_tflops     = tflops;
-                best_ave_time   = ave_time;
-                best_gb_per_sec = gb_per_sec;
-            }
+            best.Add(result, timing, flop, num_btype);
 
             if(do_verification)
             {
-                out_device_buf.FromDevice(out_n_k_ho_wo_device_result.mData.data());
-
-                check_error(out_n_k_ho_wo_host_result, out_n_k_ho_wo_device_result);
-
-                if(do_log)
+                if(!run_on_host)
                 {
-                    LogRangeAsType<float>(std::cout << "in : ", in_n_c_hi_wi.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "wei: ", wei_k_c_y_x.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "out_host  : ", out_n_k_ho_wo_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(
-                        std::cout << "out_device: ", out_n_k_ho_wo_device_result.mData, ",")
-                        << std::endl;
+                    out_device_buf->FromDevice(out_n_k_ho_wo_device_result.mData.data(), out_bytes);
                 }
+
+                // checks a copy, the next instance writes out_n_k_ho_wo_device_result again. The
+                // result is recorded once it is checked.
+                verifier.Check(result,
+                               out_n_k_ho_wo_host_result,
+                               out_n_k_ho_wo_device_result,
+                               get_default_host_compare_options<OutDataType>(C * Y * X),
+                               f_log);
+
+                continue;
             }
         }
+
+        verifier.Record(result);
     }
 
-    std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
-              << best_gb_per_sec << " GB/s, " << best_conv_name << std::endl;
+    verifier.Flush();
+
+    best.Finish(tuning_key);
 }
 
 } // namespace profiler
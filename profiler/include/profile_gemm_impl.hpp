@@ -1,5 +1,8 @@
 #pragma once
 #include "device_gemm_instance.hpp"
+#include "profile_result.hpp"
+#include "profile_tuning_db.hpp"
+#include "profile_verifier.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -74,6 +77,114 @@ void add_device_gemm_instance<ck::half_t,
                               ck::tensor_layout::gemm::ColumnMajor,
                               ck::tensor_layout::gemm::RowMajor>(std::vector<DeviceGemmNoOpPtr>&);
 
+template <>
+void add_device_gemm_cpu_instance<float,
+                                  float,
+                                  float,
+                                  ck::tensor_layout::gemm::RowMajor,
+                                  ck::tensor_layout::gemm::RowMajor,
+                                  ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceGemmNoOpPtr>&);
+
+template <>
+void add_device_gemm_cpu_instance<float,
+                                  float,
+                                  float,
+                                  ck::tensor_layout::gemm::RowMajor,
+                                  ck::tensor_layout::gemm::ColumnMajor,
+                                  ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceGemmNoOpPtr>&);
+
+template <>
+void add_device_gemm_cpu_instance<float,
+                                  float,
+                                  float,
+                                  ck::tensor_layout::gemm::ColumnMajor,
+                                  ck::tensor_layout::gemm::RowMajor,
+                                  ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceGemmNoOpPtr>&);
+
+template <>
+void add_device_gemm_cpu_instance<float,
+                                  float,
+                                  float,
+                                  ck::tensor_layout::gemm::ColumnMajor,
+                                  ck::tensor_layout::gemm::ColumnMajor,
+                                  ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceGemmNoOpPtr>&);
+
+template <>
+void add_device_gemm_cpu_instance<ck::half_t,
+                                  ck::half_t,
+                                  ck::half_t,
+                                  ck::tensor_layout::gemm::RowMajor,
+                                  ck::tensor_layout::gemm::RowMajor,
+                                  ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceGemmNoOpPtr>&);
+
+template <>
+void add_device_gemm_cpu_instance<ck::half_t,
+                                  ck::half_t,
+                                  ck::half_t,
+                                  ck::tensor_layout::gemm::RowMajor,
+                                  ck::tensor_layout::gemm::ColumnMajor,
+                                  ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceGemmNoOpPtr>&);
+
+template <>
+void add_device_gemm_cpu_instance<ck::half_t,
+                                  ck::half_t,
+                                  ck::half_t,
+                                  ck::tensor_layout::gemm::ColumnMajor,
+                                  ck::tensor_layout::gemm::RowMajor,
+                                  ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceGemmNoOpPtr>&);
+
+template <>
+void add_device_gemm_cpu_instance<ck::half_t,
+                                  ck::half_t,
+                                  ck::half_t,
+                                  ck::tensor_layout::gemm::ColumnMajor,
+                                  ck::tensor_layout::gemm::ColumnMajor,
+                                  ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceGemmNoOpPtr>&);
+
+template <>
+void add_device_gemm_cpu_instance<int8_t,
+                                  int8_t,
+                                  int8_t,
+                                  ck::tensor_layout::gemm::RowMajor,
+                                  ck::tensor_layout::gemm::RowMajor,
+                                  ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceGemmNoOpPtr>&);
+
+template <>
+void add_device_gemm_cpu_instance<int8_t,
+                                  int8_t,
+                                  int8_t,
+                                  ck::tensor_layout::gemm::RowMajor,
+                                  ck::tensor_layout::gemm::ColumnMajor,
+                                  ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceGemmNoOpPtr>&);
+
+template <>
+void add_device_gemm_cpu_instance<int8_t,
+                                  int8_t,
+                                  int8_t,
+                                  ck::tensor_layout::gemm::ColumnMajor,
+                                  ck::tensor_layout::gemm::RowMajor,
+                                  ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceGemmNoOpPtr>&);
+
+template <>
+void add_device_gemm_cpu_instance<int8_t,
+                                  int8_t,
+                                  int8_t,
+                                  ck::tensor_layout::gemm::ColumnMajor,
+                                  ck::tensor_layout::gemm::ColumnMajor,
+                                  ck::tensor_layout::gemm::RowMajor>(
+    std::vector<DeviceGemmNoOpPtr>&);
+
 } // namespace device_gemm_instance
 } // namespace device
 } // namespace tensor_operation
@@ -97,7 +208,8 @@ void profile_gemm_impl(int do_verification,
                        int K,
                        int StrideA,
                        int StrideB,
-                       int StrideC)
+                       int StrideC,
+                       bool run_on_host = false)
 {
     auto f_host_tensor_descriptor =
         [](std::size_t row, std::size_t col, std::size_t stride, auto layout) {
@@ -127,55 +239,154 @@ void profile_gemm_impl(int do_verification,
     case 0: break;
     case 1:
         a_m_k.GenerateTensorValue(GeneratorTensor_2<ADataType>{-5, 5});
-        b_k_n.GenerateTensorValue(GeneratorTensor_2<BDataType>{-5, 5});
+        b_k_n.GenerateTensorValue(GeneratorTensor_2<BDataType>{-5, 5, get_host_generator_seed(1)});
         break;
     default:
         a_m_k.GenerateTensorValue(GeneratorTensor_3<ADataType>{0.0, 1.0});
-        b_k_n.GenerateTensorValue(GeneratorTensor_3<BDataType>{-0.5, 0.5});
+        b_k_n.GenerateTensorValue(
+            GeneratorTensor_3<BDataType>{-0.5, 0.5, get_host_generator_seed(1)});
     }
 
+    // the host reference and the checks run in the background while device instances are timed,
+    // host instances would compete with them for the host threads
+    ProfileVerifier verifier(!run_on_host);
+
     if(do_verification)
     {
-        host_gemm_mk_kn_mn(a_m_k,
-                           b_k_n,
-                           c_m_n_host_result,
-                           ck::tensor_operation::element_wise::PassThrough{},
-                           ck::tensor_operation::element_wise::PassThrough{},
-                           ck::tensor_operation::element_wise::PassThrough{});
+        verifier.Submit([&] {
+            // reused from CK_HOST_TENSOR_CACHE if the same problem was verified before. The fp64
+            // accumulation keeps the reference independent of the fp32 engine of host instances.
+            HostTensorCache::GetInstance().GetOrCreate(
+                c_m_n_host_result,
+                [&] {
+                    return make_host_tensor_cache_key(
+                        "gemm", a_m_k, b_k_n, HostGemmPrecision_t::Strict);
+                },
+                [&](auto& c_m_n) {
+                    host_gemm_mk_kn_mn(a_m_k,
+                                       b_k_n,
+                                       c_m_n,
+                                       ck::tensor_operation::element_wise::PassThrough{},
+                                       ck::tensor_operation::element_wise::PassThrough{},
+                                       ck::tensor_operation::element_wise::PassThrough{},
+                                       HostGemmPrecision_t::Strict);
+                });
+        });
     }
 
-    DeviceMem a_device_buf(sizeof(ADataType) * a_m_k.mDesc.GetElementSpace());
-    DeviceMem b_device_buf(sizeof(BDataType) * b_k_n.mDesc.GetElementSpace());
-    DeviceMem c_device_buf(sizeof(CDataType) * c_m_n_device_result.mDesc.GetElementSpace());
+    // add GEMM instances, host instances work on the host tensors directly. They are built once
+    // per process and reused by every problem of a batch run.
+    static std::vector<ck::tensor_operation::device::device_gemm_instance::DeviceGemmNoOpPtr>
+        host_gemm_ptrs, device_gemm_ptrs;
+
+    auto& gemm_ptrs = run_on_host ? host_gemm_ptrs : device_gemm_ptrs;
 
-    a_device_buf.ToDevice(a_m_k.mData.data());
-    b_device_buf.ToDevice(b_k_n.mData.data());
-    c_device_buf.ToDevice(c_m_n_device_result.mData.data());
+    const std::size_t a_bytes = sizeof(ADataType) * a_m_k.mDesc.GetElementSpace();
+    const std::size_t b_bytes = sizeof(BDataType) * b_k_n.mDesc.GetElementSpace();
+    const std::size_t c_bytes = sizeof(CDataType) * c_m_n_device_result.mDesc.GetElementSpace();
 
-    // add device GEMM instances
-    std::vector<ck::tensor_operation::device::device_gemm_instance::DeviceGemmNoOpPtr> gemm_ptrs;
+    DeviceMem* c_device_buf = nullptr;
 
-    ck::tensor_operation::device::device_gemm_instance::
-        add_device_gemm_instance<ADataType, BDataType, CDataType, ALayout, BLayout, CLayout>(
-            gemm_ptrs);
+    const void* p_a = a_m_k.mData.data();
+    const void* p_b = b_k_n.mData.data();
+    void* p_c       = c_m_n_device_result.mData.data();
+
+    if(run_on_host)
+    {
+        if(gemm_ptrs.empty())
+        {
+            ck::tensor_operation::device::device_gemm_instance::
+                add_device_gemm_cpu_instance<ADataType,
+                                             BDataType,
+                                             CDataType,
+                                             ALayout,
+                                             BLayout,
+                                             CLayout>(gemm_ptrs);
+        }
+    }
+    else if constexpr(std::is_same<ADataType, int8_t>::value)
+    {
+        throw std::runtime_error("wrong! int8 GEMM only has host instances");
+    }
+    else
+    {
+        // grow-only buffers, a batch run only allocates for problems larger than the ones before
+        auto& device_mem_pool = DeviceMemPool::GetInstance();
+
+        DeviceMem& a_device_buf = device_mem_pool.Get(0, a_bytes);
+        DeviceMem& b_device_buf = device_mem_pool.Get(1, b_bytes);
+        c_device_buf            = &device_mem_pool.Get(2, c_bytes);
+
+        a_device_buf.ToDevice(a_m_k.mData.data(), a_bytes);
+        b_device_buf.ToDevice(b_k_n.mData.data(), b_bytes);
+        c_device_buf->ToDevice(c_m_n_device_result.mData.data(), c_bytes);
+
+        p_a = a_device_buf.GetDeviceBuffer();
+        p_b = b_device_buf.GetDeviceBuffer();
+        p_c = c_device_buf->GetDeviceBuffer();
+
+        if(gemm_ptrs.empty())
+        {
+            ck::tensor_operation::device::device_gemm_instance::
+                add_device_gemm_instance<ADataType,
+                                         BDataType,
+                                         CDataType,
+                                         ALayout,
+                                         BLayout,
+                                         CLayout>(gemm_ptrs);
+        }
+    }
 
     if(gemm_ptrs.size() <= 0)
     {
         throw std::runtime_error("wrong! no device GEMM instance found");
     }
 
-    std::string best_gemm_name;
-    float best_ave_time   = 0;
-    float best_tflops     = 0;
-    float best_gb_per_sec = 0;
+    ProfileResult result_base;
+
+    result_base.op        = "gemm";
+    result_base.backend   = run_on_host ? "host" : "device";
+    result_base.data_type = get_data_type_string<ADataType, BDataType, CDataType>();
+    result_base.layout    = get_gemm_layout_string<ALayout, BLayout, CLayout>();
+    result_base.problem   = make_gemm_problem(M, N, K, StrideA, StrideB, StrideC);
+    result_base.nrepeat   = nrepeat;
+
+    using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+    const std::string tuning_key =
+        make_tuning_db_key(result_base.op,
+                           result_base.data_type,
+                           result_base.layout,
+                           result_base.problem,
+                           get_element_wise_op_string<PassThrough, PassThrough, PassThrough>(),
+                           get_tuning_db_backend(run_on_host));
+
+    // with --use-db only the tuned instance is profiled
+    const auto tuned_ptr = ProfileTuningDb::GetInstance().FindInstance(gemm_ptrs, tuning_key);
+
+    auto f_log = [&](const Tensor<CDataType>& c_m_n_checked) {
+        if(!do_log)
+            return;
+
+        LogRangeAsType<float>(std::cout << "a : ", a_m_k.mData, ",") << std::endl;
+        LogRangeAsType<float>(std::cout << "b: ", b_k_n.mData, ",") << std::endl;
+        LogRangeAsType<float>(std::cout << "c_host  : ", c_m_n_host_result.mData, ",")
+            << std::endl;
+        LogRangeAsType<float>(std::cout << "c_device: ", c_m_n_checked.mData, ",") << std::endl;
+    };
+
+    ProfileBestInstance best;
 
     // profile device GEMM instances
     for(auto& gemm_ptr : gemm_ptrs)
     {
+        if(tuned_ptr != nullptr && gemm_ptr.get() != tuned_ptr)
+            continue;
+
         auto argument_ptr =
-            gemm_ptr->MakeArgumentPointer(static_cast<ADataType*>(a_device_buf.GetDeviceBuffer()),
-                                          static_cast<BDataType*>(b_device_buf.GetDeviceBuffer()),
-                                          static_cast<CDataType*>(c_device_buf.GetDeviceBuffer()),
+            gemm_ptr->MakeArgumentPointer(p_a,
+                                          p_b,
+                                          p_c,
                                           M,
                                           N,
                                           K,
@@ -188,47 +399,38 @@ void profile_gemm_impl(int do_verification,
 
         auto invoker_ptr = gemm_ptr->MakeInvokerPointer();
 
-        if(gemm_ptr->IsSupportedArgument(argument_ptr.get()))
-        {
-            std::string gemm_name = gemm_ptr->GetTypeString();
+        ProfileResult result = result_base;
 
-            float ave_time = invoker_ptr->Run(argument_ptr.get(), nrepeat);
+        result.instance  = gemm_ptr->GetTypeString();
+        result.supported = gemm_ptr->IsSupportedArgument(argument_ptr.get());
+
+        if(result.supported)
+        {
+            const TimingStats timing = invoker_ptr->RunWithStats(argument_ptr.get(), nrepeat);
 
             std::size_t flop = std::size_t(2) * M * N * K;
 
             std::size_t num_btype =
                 sizeof(ADataType) * M * K + sizeof(BDataType) * K * M + sizeof(CDataType) * M * N;
 
-            float tflops = static_cast<float>(flop) / 1.E9 / ave_time;
-
-            float gb_per_sec = num_btype / 1.E6 / ave_time;
-
-            std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
-                      << " GB/s, " << gemm_name << std::endl;
-
-            if(tflops > best_tflops)
-            {
-                best_gemm_name  = gemm_name;
-                best_tflops     = tflops;
-                best_ave_time   = ave_time;
-                best_gb_per_sec = gb_per_sec;
-            }
+            best.Add(result, timing, flop, num_btype);
 
             if(do_verification)
             {
-                c_device_buf.FromDevice(c_m_n_device_result.mData.data());
-
-                check_error(c_m_n_host_result, c_m_n_device_result);
-
-                if(do_log)
+                if(!run_on_host)
                 {
-                    LogRangeAsType<float>(std::cout << "a : ", a_m_k.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "b: ", b_k_n.mData, ",") << std::endl;
-                    LogRangeAsType<float>(std::cout << "c_host  : ", c_m_n_host_result.mData, ",")
-                        << std::endl;
-                    LogRangeAsType<float>(std::cout << "c_device: ", c_m_n_device_result.mData, ",")
-                        << std::endl;
+                    c_device_buf->FromDevice(c_m_n_device_result.mData.data(), c_bytes);
                 }
+
+                // checks a copy, the next instance writes c_m_n_device_result again. The result
+                // is recorded once it is checked.
+                verifier.Check(result,
+                               c_m_n_host_result,
+                               c_m_n_device_result,
+                               get_default_host_compare_options<CDataType>(K),
+                               f_log);
+
+                continue;
             }
         }
         else
@@ -236,10 +438,13 @@ void profile_gemm_impl(int do_verification,
             std::cout << "this device GEMM instance does not support this GEMM problem"
                       << std::endl;
         }
+
+        verifier.Record(result);
     }
 
-    std::cout << "Best Perf: " << best_ave_time << " ms, " << best_tflops << " TFlops, "
-              << best_gb_per_sec << " GB/s, " << best_gemm_name << std::endl;
+    verifier.Flush();
+
+    best.Finish(tuning_key);
 }
 
 } // namespace profiler
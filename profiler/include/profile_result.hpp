@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "device_tuning_db.hpp"
+#include "timing_stats.hpp"
+
+namespace ck {
+namespace profiler {
+
+// One profiled (problem, instance) pair. Timing and throughput are only set for supported
+// instances, verification is "pass", "fail" or "skipped".
+struct ProfileResult
+{
+    std::string op;        // gemm, batched_gemm, conv_fwd, ...
+    std::string backend;   // device or host
+    std::string data_type; // fp32, fp16, ..., one per operand if they differ
+    std::string layout;    // mk_kn_mn, nhwc_kyxc_nhwk, ...
+    ck::tensor_operation::device::TuningDbProblem problem;
+
+    std::string instance;
+    bool supported = false;
+
+    int nrepeat      = 0;
+    float ave_time   = 0; // ms, median of the timed runs
+    float tflops     = 0; // from the median time
+    float gb_per_sec = 0;
+
+    TimingStats timing;
+
+    std::string verification = "skipped";
+};
+
+// Fastest supported instance of a profiled problem. Instances are ranked by their median time,
+// which the odd slow run does not move, and time and throughput of a record derive from it.
+struct ProfileBestInstance
+{
+    // sets time and throughput of the result of a supported instance, prints them and keeps the
+    // instance if it is the fastest so far
+    void Add(ProfileResult& result,
+             const TimingStats& timing,
+             std::size_t flop,
+             std::size_t num_btype);
+
+    // prints the fastest instance and stores it under tuning_key with --update-db
+    void Finish(const std::string& tuning_key) const;
+
+    std::string mInstance;
+    float mAveTime  = 0;
+    float mTflops   = 0;
+    float mGbPerSec = 0;
+    TimingStats mTiming;
+};
+
+enum class ProfileResultFormat_t
+{
+    JsonLines = 0,
+    Csv       = 1,
+};
+
+// Writes one record per profiled instance to the file given with --output=<file>, as JSON Lines
+// or CSV (--output-format=jsonl|csv, picked from the file extension by default). The file is
+// truncated when it is opened unless --append is given, a CSV header is only written to an
+// empty file. Each record is one line, written under a lock and flushed.
+struct ProfileResultSink
+{
+    static ProfileResultSink& GetInstance();
+
+    // consumes an --output, --output-format or --append argument, false for any other argument
+    bool ParseOption(const std::string& arg);
+
+    bool IsEnabled() const { return !mPath.empty(); }
+
+    void Record(const ProfileResult& result);
+
+    ProfileResultSink(const ProfileResultSink&) = delete;
+    ProfileResultSink& operator=(const ProfileResultSink&) = delete;
+
+    private:
+    ProfileResultSink() = default;
+
+    void Open();
+
+    std::string mPath;
+    ProfileResultFormat_t mFormat = ProfileResultFormat_t::JsonLines;
+    bool mFormatSet               = false;
+    bool mAppend                  = false;
+
+    std::ofstream mStream;
+    std::mutex mMutex;
+};
+
+using ck::tensor_operation::device::get_conv_layout_string;
+using ck::tensor_operation::device::get_data_type_string;
+using ck::tensor_operation::device::get_element_wise_op_string;
+using ck::tensor_operation::device::get_gemm_layout_string;
+using ck::tensor_operation::device::get_tuning_db_backend;
+using ck::tensor_operation::device::make_batched_gemm_problem;
+using ck::tensor_operation::device::make_conv_fwd_problem;
+using ck::tensor_operation::device::make_gemm_problem;
+using ck::tensor_operation::device::make_tuning_db_key;
+
+} // namespace profiler
+} // namespace ck
@@ -0,0 +1,69 @@
+#pragma once
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "device_tuning_db.hpp"
+
+namespace ck {
+namespace profiler {
+
+// Tuning db options of ckProfiler:
+//   --use-db[=<file>]     only profile the instance the db holds for the problem, all instances
+//                         if the problem was not tuned yet
+//   --update-db[=<file>]  store the best instance of every profiled problem in the db
+// <file> defaults to CK_TUNING_DB, or "ck_tuning.db" if that is unset.
+struct ProfileTuningDb
+{
+    static ProfileTuningDb& GetInstance();
+
+    // consumes a --use-db or --update-db argument, false for any other argument
+    bool ParseOption(const std::string& arg);
+
+    bool IsUseEnabled() const { return mUse; }
+
+    bool IsUpdateEnabled() const { return mUpdate; }
+
+    // instance to profile alone with --use-db, nullptr to profile all of them
+    template <typename OpPtr>
+    auto FindInstance(const std::vector<OpPtr>& op_ptrs, const std::string& key)
+        -> decltype(op_ptrs[0].get())
+    {
+        if(!mUse)
+            return nullptr;
+
+        auto tuned_ptr = ck::tensor_operation::device::find_tuned_device_instance(
+            op_ptrs, key, GetDb());
+
+        if(tuned_ptr != nullptr)
+            std::cout << "Tuning db: " << tuned_ptr->GetTypeString() << std::endl;
+        else
+            std::cout << "Tuning db: no tuned instance found, profiling all instances" << std::endl;
+
+        return tuned_ptr;
+    }
+
+    // stores the best instance with --update-db, nothing if no instance supported the problem
+    void Update(const std::string& key,
+                const std::string& instance,
+                float ave_time,
+                float tflops,
+                float gb_per_sec);
+
+    ProfileTuningDb(const ProfileTuningDb&) = delete;
+    ProfileTuningDb& operator=(const ProfileTuningDb&) = delete;
+
+    private:
+    ProfileTuningDb() = default;
+
+    TuningDb& GetDb();
+
+    std::string mPath;
+    bool mUse    = false;
+    bool mUpdate = false;
+
+    std::unique_ptr<TuningDb> mDb;
+};
+
+} // namespace profiler
+} // namespace ck
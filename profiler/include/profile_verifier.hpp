@@ -0,0 +1,108 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "host_tensor.hpp"
+#include "profile_result.hpp"
+
+namespace ck {
+namespace profiler {
+
+// Host side of the verification of a profiled problem. Submitted tasks (the host reference, then
+// one comparison per copied back instance result) run in submission order on a background
+// thread, each of them still parallelized on HostThreadPool, while the next instances are timed.
+// The wall time of a verified sweep then approaches max(reference, timing) instead of their sum.
+//
+// Records are passed to ProfileResultSink and comparison reports are printed on the calling
+// thread, in the order the instances were profiled. With in_background false (host instances,
+// which would share the host threads with the verification) every task runs in line instead.
+struct ProfileVerifier
+{
+    // max_pending bounds the number of result copies waiting for their comparison
+    explicit ProfileVerifier(bool in_background, std::size_t max_pending = 4);
+
+    // waits for a running task, tasks that did not start yet are dropped
+    ~ProfileVerifier();
+
+    // e.g. the host reference, every later task runs after it
+    void Submit(std::function<void()> f);
+
+    // compares result_tensor against ref_tensor under options once everything submitted before is
+    // done, then prints the report, calls f_log(result_tensor) and records result with its
+    // verification
+    template <typename T, typename FLog>
+    void Check(const ProfileResult& result,
+               const Tensor<T>& ref_tensor,
+               Tensor<T> result_tensor,
+               const HostCompareOptions& options,
+               FLog f_log)
+    {
+        auto result_tensor_ptr = std::make_shared<Tensor<T>>(std::move(result_tensor));
+        auto report_ptr        = std::make_shared<HostCompareReport>();
+
+        Pending pending;
+
+        pending.mRecord = true;
+        pending.mResult = result;
+        pending.mDone   = Run([&ref_tensor, result_tensor_ptr, report_ptr, options] {
+            *report_ptr = compare_tensor(ref_tensor, *result_tensor_ptr, options);
+        });
+        pending.mFinish = [result_tensor_ptr, report_ptr, f_log](ProfileResult& r) {
+            std::cout << "Verification: " << r.instance << std::endl << *report_ptr;
+
+            r.verification = report_ptr->Pass() ? "pass" : "fail";
+
+            f_log(*result_tensor_ptr);
+        };
+
+        Enqueue(std::move(pending));
+    }
+
+    // records result after the records of the instances profiled before it
+    void Record(const ProfileResult& result);
+
+    // waits for every task, prints and records everything still pending
+    void Flush();
+
+    ProfileVerifier(const ProfileVerifier&) = delete;
+    ProfileVerifier& operator=(const ProfileVerifier&) = delete;
+
+    private:
+    struct Pending
+    {
+        bool mRecord = false;
+        ProfileResult mResult;
+        std::future<void> mDone;
+        std::function<void(ProfileResult&)> mFinish;
+    };
+
+    std::future<void> Run(std::function<void()> f);
+
+    void Enqueue(Pending&& pending);
+
+    // waits for the oldest entry, then prints and records it
+    void FinishFront();
+
+    void WorkerLoop();
+
+    bool mInBackground;
+    std::size_t mMaxPending;
+
+    // touched by the calling thread only
+    std::deque<Pending> mPendings;
+
+    std::thread mWorker;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<std::packaged_task<void()>> mTasks;
+    bool mStop = false;
+};
+
+} // namespace profiler
+} // namespace ck
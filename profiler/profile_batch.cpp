@@ -0,0 +1,131 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+int profile_operation(int, char*[]);
+
+// the operations parse their arguments with std::stoi, which takes "12x" for 12
+bool is_problem_argument(const std::string& field)
+{
+    const std::size_t first = field[0] == '-' ? 1 : 0;
+
+    return first < field.size() &&
+           field.find_first_not_of("0123456789", first) == std::string::npos;
+}
+
+// Profiles every problem of a problem list file in this process, so instance libraries, instance
+// objects, host and device buffers and host threads are set up once for the whole list. Each
+// line holds the arguments of one ckProfiler run, starting with the operation, e.g.
+//   conv_fwd 1 1 1 1 0 1 0 5 256 256 64 1 1 56 56 1 1 1 1 0 0 0 0
+// Empty lines and lines starting with '#' are skipped. Options apply to the whole batch and are
+// rejected on a line. Every line is checked before the first problem runs; a problem that fails
+// is reported and the batch goes on. Results are printed (and written to --output) as each
+// problem finishes.
+int profile_batch(int argc, char* argv[])
+{
+    if(argc != 3)
+    {
+        printf("arg1: tensor operation (batch: every problem of a problem list file)\n");
+        printf("arg2: problem list file, one line of ckProfiler arguments per problem\n");
+        throw std::runtime_error("wrong! number of arguments");
+    }
+
+    std::ifstream file(argv[2]);
+
+    if(!file)
+        throw std::runtime_error(std::string("wrong! cannot open problem list ") + argv[2]);
+
+    std::vector<std::vector<std::string>> problems;
+    std::vector<int> line_numbers;
+
+    int num_invalid = 0;
+
+    std::string line;
+
+    for(int line_number = 1; std::getline(file, line); ++line_number)
+    {
+        std::istringstream is(line);
+
+        std::vector<std::string> fields;
+
+        for(std::string field; is >> field;)
+            fields.push_back(field);
+
+        if(fields.empty() || fields[0][0] == '#')
+            continue;
+
+        std::string error;
+
+        if(fields[0] == "batch")
+            error = "runs a batch";
+
+        for(std::size_t i = 1; i < fields.size() && error.empty(); ++i)
+        {
+            if(fields[i].compare(0, 2, "--") == 0)
+                error = "has option " + fields[i] + ", options go on the command line";
+            else if(!is_problem_argument(fields[i]))
+                error = "has argument " + fields[i] + ", which is not an integer";
+        }
+
+        if(!error.empty())
+        {
+            std::cerr << "Problem list line " << line_number << " " << error << std::endl;
+
+            ++num_invalid;
+            continue;
+        }
+
+        problems.push_back(fields);
+        line_numbers.push_back(line_number);
+    }
+
+    if(num_invalid > 0)
+        throw std::runtime_error("wrong! problem list " + std::string(argv[2]) + " has " +
+                                 std::to_string(num_invalid) + " invalid lines");
+
+    int num_failed = 0;
+
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        std::vector<char*> problem_argv{argv[0]};
+
+        std::cout << "Problem " << i + 1 << "/" << problems.size() << " (line "
+                  << line_numbers[i] << "):";
+
+        for(auto& field : problems[i])
+        {
+            std::cout << " " << field;
+            problem_argv.push_back(&field[0]);
+        }
+
+        std::cout << std::endl;
+
+        problem_argv.push_back(nullptr);
+
+        try
+        {
+            // 0: the operation is unknown and only its usage was printed
+            if(profile_operation(static_cast<int>(problem_argv.size()) - 1,
+                                 problem_argv.data()) == 0)
+                throw std::runtime_error("wrong! unknown tensor operation " + problems[i][0]);
+        }
+        catch(const std::exception& e)
+        {
+            std::cerr << "Problem " << i + 1 << " (line " << line_numbers[i]
+                      << ") failed: " << e.what() << std::endl;
+
+            ++num_failed;
+        }
+    }
+
+    if(num_failed > 0)
+        throw std::runtime_error("wrong! " + std::to_string(num_failed) + " of " +
+                                 std::to_string(problems.size()) + " problems failed");
+
+    return 1;
+}
@@ -2,7 +2,9 @@
 #include <numeric>
 #include <initializer_list>
 #include <cstdlib>
+#include <cstring>
 #include <stdlib.h>
+#include <stdexcept>
 #include <half.hpp>
 #include "profile_conv_fwd_bias_relu_add_impl.hpp"
 
@@ -34,8 +36,10 @@ int profile_conv_fwd_bias_relu_add(int argc, char* argv[])
 {
     if(argc != 25)
     {
-        printf(
-            "arg1: tensor operation (conv_fwd_bias_relu_add: ForwardConvolution+Bias+ReLu+Add)\n");
+        printf("arg1: tensor operation (conv_fwd_bias_relu_add: "
+               "ForwardConvolution+Bias+ReLu+Add;\n");
+        printf("                        conv_fwd_bias_relu_add_cpu: "
+               "ForwardConvolution+Bias+ReLu+Add on the host)\n");
         printf("arg2: data type (0: fp32; 1: fp16)\n");
         printf("arg3: input tensor layout (0: NCHW; 1: NHWC)\n");
         printf("arg4: weight tensor layout (0: KCYX; 1: KYXC)\n");
@@ -46,9 +50,10 @@ int profile_conv_fwd_bias_relu_add(int argc, char* argv[])
         printf("arg9: run kernel # of times (>1)\n");
         printf("arg10 to 24: N, K, C, Y, X, Hi, Wi, Sy, Sx, Dy, Dx, LeftPy, LeftPx, RightPy, "
                "RightPx\n");
-        exit(1);
+        throw std::runtime_error("wrong! number of arguments");
     }
 
+    const bool run_on_host     = strcmp(argv[1], "conv_fwd_bias_relu_add_cpu") == 0;
     const int data_type        = static_cast<ConvDataType>(std::stoi(argv[2]));
     const int in_layout        = static_cast<ConvInputLayout>(std::stoi(argv[3]));
     const int wei_layout       = static_cast<ConvWeightLayout>(std::stoi(argv[4]));
@@ -81,8 +86,34 @@ int profile_conv_fwd_bias_relu_add(int argc, char* argv[])
     const ck::index_t Ho = (Hi + in_left_pad_h + in_right_pad_h - YEff) / conv_stride_h + 1;
     const ck::index_t Wo = (Wi + in_left_pad_w + in_right_pad_w - XEff) / conv_stride_w + 1;
 
-    if(data_type == ConvDataType::F16_F16_F16 && in_layout == ConvInputLayout::NHWC &&
+    if(data_type == ConvDataType::F32_F32_F32 && in_layout == ConvInputLayout::NHWC &&
        wei_layout == ConvWeightLayout::KYXC && out_layout == ConvOutputLayout::NHWK)
+    {
+        ck::profiler::profile_conv_fwd_bias_relu_add_impl<2,
+                                                          float,
+                                                          float,
+                                                          float,
+                                                          ck::tensor_layout::convolution::NHWC,
+                                                          ck::tensor_layout::convolution::KYXC,
+                                                          ck::tensor_layout::convolution::NHWK>(
+            do_verification,
+            init_method,
+            do_log,
+            nrepeat,
+            N,
+            K,
+            C,
+            std::vector<ck::index_t>{Hi, Wi},
+            std::vector<ck::index_t>{Y, X},
+            std::vector<ck::index_t>{Ho, Wo},
+            std::vector<ck::index_t>{conv_stride_h, conv_stride_w},
+            std::vector<ck::index_t>{conv_dilation_h, conv_dilation_w},
+            std::vector<ck::index_t>{in_left_pad_h, in_left_pad_w},
+            std::vector<ck::index_t>{in_right_pad_h, in_right_pad_w},
+            run_on_host);
+    }
+    else if(data_type == ConvDataType::F16_F16_F16 && in_layout == ConvInputLayout::NHWC &&
+            wei_layout == ConvWeightLayout::KYXC && out_layout == ConvOutputLayout::NHWK)
     {
         ck::profiler::profile_conv_fwd_bias_relu_add_impl<2,
                                                           ck::half_t,
@@ -104,7 +135,8 @@ int profile_conv_fwd_bias_relu_add(int argc, char* argv[])
             std::vector<ck::index_t>{conv_stride_h, conv_stride_w},
             std::vector<ck::index_t>{conv_dilation_h, conv_dilation_w},
             std::vector<ck::index_t>{in_left_pad_h, in_left_pad_w},
-            std::vector<ck::index_t>{in_right_pad_h, in_right_pad_w});
+            std::vector<ck::index_t>{in_right_pad_h, in_right_pad_w},
+            run_on_host);
     }
     else
     {
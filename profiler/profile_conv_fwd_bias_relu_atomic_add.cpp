@@ -3,6 +3,7 @@
 #include <initializer_list>
 #include <cstdlib>
 #include <stdlib.h>
+#include <stdexcept>
 #include <half.hpp>
 #include "profile_conv_fwd_bias_relu_atomic_add_impl.hpp"
 
@@ -46,7 +47,7 @@ int profile_conv_fwd_bias_relu_atomic_add(int argc, char* argv[])
         printf("arg9: run kernel # of times (>1)\n");
         printf("arg10 to 24: N, K, C, Y, X, Hi, Wi, Sy, Sx, Dy, Dx, LeftPy, LeftPx, RightPy, "
                "RightPx\n");
-        exit(1);
+        throw std::runtime_error("wrong! number of arguments");
     }
 
     const int data_type        = static_cast<ConvDataType>(std::stoi(argv[2]));
@@ -0,0 +1,265 @@
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "profile_result.hpp"
+#include "profile_tuning_db.hpp"
+
+namespace ck {
+namespace profiler {
+
+namespace {
+
+std::string to_json_string(const std::string& str)
+{
+    std::string json = "\"";
+
+    for(char c : str)
+    {
+        if(c == '"' || c == '\\')
+        {
+            json += '\\';
+            json += c;
+        }
+        else if(static_cast<unsigned char>(c) < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            json += escaped;
+        }
+        else
+        {
+            json += c;
+        }
+    }
+
+    return json + "\"";
+}
+
+// quoted if it holds a separator, a quote or a line break
+std::string to_csv_string(const std::string& str)
+{
+    if(str.find_first_of(",\"\r\n") == std::string::npos)
+        return str;
+
+    std::string csv = "\"";
+
+    for(char c : str)
+    {
+        if(c == '"')
+            csv += '"';
+
+        csv += c;
+    }
+
+    return csv + "\"";
+}
+
+const char* get_csv_header()
+{
+    return "op,backend,data_type,layout,problem,instance,supported,nrepeat,ave_time_ms,tflops,"
+           "gb_per_sec,verification,min_ms,median_ms,median_low_ms,median_high_ms,p90_ms,p99_ms,"
+           "stddev_ms,runs,outliers";
+}
+
+std::string to_json_line(const ProfileResult& result)
+{
+    std::ostringstream os;
+
+    os << std::setprecision(7);
+
+    os << "{\"op\":" << to_json_string(result.op)
+       << ",\"backend\":" << to_json_string(result.backend)
+       << ",\"data_type\":" << to_json_string(result.data_type)
+       << ",\"layout\":" << to_json_string(result.layout) << ",\"problem\":{";
+
+    for(std::size_t i = 0; i < result.problem.size(); ++i)
+    {
+        os << (i > 0 ? "," : "") << to_json_string(result.problem[i].first) << ":"
+           << result.problem[i].second;
+    }
+
+    os << "},\"instance\":" << to_json_string(result.instance)
+       << ",\"supported\":" << (result.supported ? "true" : "false")
+       << ",\"nrepeat\":" << result.nrepeat;
+
+    if(result.supported)
+    {
+        const auto& timing = result.timing;
+
+        os << ",\"ave_time_ms\":" << result.ave_time << ",\"tflops\":" << result.tflops
+           << ",\"gb_per_sec\":" << result.gb_per_sec << ",\"timing\":{\"min_ms\":" << timing.mMin
+           << ",\"median_ms\":" << timing.mMedian << ",\"median_ci_ms\":[" << timing.mMedianLow
+           << "," << timing.mMedianHigh << "],\"p90_ms\":" << timing.mP90
+           << ",\"p99_ms\":" << timing.mP99 << ",\"stddev_ms\":" << timing.mStdDev
+           << ",\"runs\":" << timing.mNumSample << ",\"outliers\":" << timing.mNumOutlier << "}";
+    }
+    else
+    {
+        os << ",\"ave_time_ms\":null,\"tflops\":null,\"gb_per_sec\":null,\"timing\":null";
+    }
+
+    os << ",\"verification\":" << to_json_string(result.verification) << "}";
+
+    return os.str();
+}
+
+std::string to_csv_line(const ProfileResult& result)
+{
+    std::string problem;
+
+    for(const auto& field : result.problem)
+        problem += (problem.empty() ? "" : " ") + field.first + "=" + std::to_string(field.second);
+
+    std::ostringstream os;
+
+    os << std::setprecision(7);
+
+    os << to_csv_string(result.op) << "," << to_csv_string(result.backend) << ","
+       << to_csv_string(result.data_type) << "," << to_csv_string(result.layout) << ","
+       << to_csv_string(problem) << "," << to_csv_string(result.instance) << ","
+       << (result.supported ? 1 : 0) << "," << result.nrepeat << ",";
+
+    // empty for unsupported instances
+    if(result.supported)
+        os << result.ave_time << "," << result.tflops << "," << result.gb_per_sec;
+    else
+        os << ",,";
+
+    os << "," << to_csv_string(result.verification);
+
+    if(result.supported)
+    {
+        const auto& timing = result.timing;
+
+        os << "," << timing.mMin << "," << timing.mMedian << "," << timing.mMedianLow << ","
+           << timing.mMedianHigh << "," << timing.mP90 << "," << timing.mP99 << ","
+           << timing.mStdDev << "," << timing.mNumSample << "," << timing.mNumOutlier;
+    }
+    else
+    {
+        os << ",,,,,,,,,";
+    }
+
+    return os.str();
+}
+
+bool has_suffix(const std::string& str, const std::string& suffix)
+{
+    return str.size() >= suffix.size() &&
+           str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+void ProfileBestInstance::Add(ProfileResult& result,
+                              const TimingStats& timing,
+                              std::size_t flop,
+                              std::size_t num_btype)
+{
+    result.ave_time   = timing.mMedian;
+    result.tflops     = static_cast<float>(flop) / 1.E9 / result.ave_time;
+    result.gb_per_sec = num_btype / 1.E6 / result.ave_time;
+    result.timing     = timing;
+
+    std::cout << "Perf: " << result.ave_time << " ms, " << result.tflops << " TFlops, "
+              << result.gb_per_sec << " GB/s, " << result.instance << std::endl;
+    std::cout << "Timing: " << timing << std::endl;
+
+    if(result.tflops > mTflops)
+    {
+        mInstance = result.instance;
+        mAveTime  = result.ave_time;
+        mTflops   = result.tflops;
+        mGbPerSec = result.gb_per_sec;
+        mTiming   = timing;
+    }
+}
+
+void ProfileBestInstance::Finish(const std::string& tuning_key) const
+{
+    std::cout << "Best Perf: " << mAveTime << " ms, " << mTflops << " TFlops, " << mGbPerSec
+              << " GB/s, " << mInstance << std::endl;
+
+    std::cout << "Best Timing: " << mTiming << std::endl;
+
+    ProfileTuningDb::GetInstance().Update(tuning_key, mInstance, mAveTime, mTflops, mGbPerSec);
+}
+
+ProfileResultSink& ProfileResultSink::GetInstance()
+{
+    static ProfileResultSink sink;
+
+    return sink;
+}
+
+bool ProfileResultSink::ParseOption(const std::string& arg)
+{
+    const std::string output        = "--output=";
+    const std::string output_format = "--output-format=";
+
+    if(arg.compare(0, output.size(), output) == 0)
+    {
+        mPath = arg.substr(output.size());
+
+        if(!mFormatSet)
+            mFormat = has_suffix(mPath, ".csv") ? ProfileResultFormat_t::Csv
+                                                : ProfileResultFormat_t::JsonLines;
+    }
+    else if(arg.compare(0, output_format.size(), output_format) == 0)
+    {
+        const std::string format = arg.substr(output_format.size());
+
+        if(format == "jsonl" || format == "json")
+            mFormat = ProfileResultFormat_t::JsonLines;
+        else if(format == "csv")
+            mFormat = ProfileResultFormat_t::Csv;
+        else
+            throw std::runtime_error("wrong! unknown profiler output format " + format);
+
+        mFormatSet = true;
+    }
+    else if(arg == "--append")
+    {
+        mAppend = true;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void ProfileResultSink::Open()
+{
+    mStream.open(mPath, mAppend ? std::ios::app : std::ios::trunc);
+
+    if(!mStream)
+        throw std::runtime_error("wrong! cannot open profiler output " + mPath);
+
+    mStream.seekp(0, std::ios::end);
+
+    if(mFormat == ProfileResultFormat_t::Csv && mStream.tellp() == 0)
+        mStream << get_csv_header() << std::endl;
+}
+
+void ProfileResultSink::Record(const ProfileResult& result)
+{
+    if(!IsEnabled())
+        return;
+
+    const std::string line = mFormat == ProfileResultFormat_t::Csv ? to_csv_line(result)
+                                                                   : to_json_line(result);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if(!mStream.is_open())
+        Open();
+
+    mStream << line << std::endl;
+}
+
+} // namespace profiler
+} // namespace ck
@@ -0,0 +1,91 @@
+#include <stdexcept>
+#include "profile_tuning_db.hpp"
+
+namespace ck {
+namespace profiler {
+
+ProfileTuningDb& ProfileTuningDb::GetInstance()
+{
+    static ProfileTuningDb tuning_db;
+
+    return tuning_db;
+}
+
+bool ProfileTuningDb::ParseOption(const std::string& arg)
+{
+    bool* flag = nullptr;
+    std::string option;
+
+    if(arg.compare(0, 8, "--use-db") == 0)
+    {
+        flag   = &mUse;
+        option = arg.substr(8);
+    }
+    else if(arg.compare(0, 11, "--update-db") == 0)
+    {
+        flag   = &mUpdate;
+        option = arg.substr(11);
+    }
+    else
+    {
+        return false;
+    }
+
+    if(option.empty())
+    {
+        *flag = true;
+    }
+    else if(option[0] == '=' && option.size() > 1)
+    {
+        const std::string path = option.substr(1);
+
+        if(!mPath.empty() && mPath != path)
+            throw std::runtime_error("wrong! --use-db and --update-db name different files");
+
+        *flag = true;
+        mPath = path;
+    }
+    else
+    {
+        // e.g. --use-dbx
+        return false;
+    }
+
+    return true;
+}
+
+TuningDb& ProfileTuningDb::GetDb()
+{
+    if(mPath.empty())
+        return TuningDb::GetInstance();
+
+    if(!mDb)
+        mDb = std::make_unique<TuningDb>(mPath);
+
+    return *mDb;
+}
+
+void ProfileTuningDb::Update(const std::string& key,
+                             const std::string& instance,
+                             float ave_time,
+                             float tflops,
+                             float gb_per_sec)
+{
+    if(!mUpdate || instance.empty())
+        return;
+
+    TuningDbRecord record;
+
+    record.mInstance = instance;
+    record.mAveTime  = ave_time;
+    record.mTflops   = tflops;
+    record.mGbPerSec = gb_per_sec;
+
+    const bool stored = GetDb().Update(key, record);
+
+    std::cout << "Tuning db: " << (stored ? "stored " : "kept the faster record instead of ")
+              << instance << " in " << GetDb().GetPath() << std::endl;
+}
+
+} // namespace profiler
+} // namespace ck
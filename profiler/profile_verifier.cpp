@@ -0,0 +1,139 @@
+#include "profile_verifier.hpp"
+
+namespace ck {
+namespace profiler {
+
+ProfileVerifier::ProfileVerifier(bool in_background, std::size_t max_pending)
+    : mInBackground(in_background), mMaxPending(max_pending > 0 ? max_pending : 1)
+{
+    if(mInBackground)
+        mWorker = std::thread([this] { WorkerLoop(); });
+}
+
+ProfileVerifier::~ProfileVerifier()
+{
+    if(!mInBackground)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        // only left behind if profiling threw, nobody waits for them
+        mTasks.clear();
+        mStop = true;
+    }
+
+    mCondition.notify_one();
+
+    mWorker.join();
+}
+
+void ProfileVerifier::Submit(std::function<void()> f)
+{
+    Pending pending;
+
+    pending.mDone = Run(std::move(f));
+
+    Enqueue(std::move(pending));
+}
+
+void ProfileVerifier::Record(const ProfileResult& result)
+{
+    Pending pending;
+
+    pending.mRecord = true;
+    pending.mResult = result;
+
+    Enqueue(std::move(pending));
+}
+
+void ProfileVerifier::Flush()
+{
+    while(!mPendings.empty())
+        FinishFront();
+}
+
+std::future<void> ProfileVerifier::Run(std::function<void()> f)
+{
+    std::packaged_task<void()> task(std::move(f));
+
+    auto done = task.get_future();
+
+    if(mInBackground)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            mTasks.push_back(std::move(task));
+        }
+
+        mCondition.notify_one();
+    }
+    else
+    {
+        task();
+    }
+
+    return done;
+}
+
+void ProfileVerifier::Enqueue(Pending&& pending)
+{
+    mPendings.push_back(std::move(pending));
+
+    while(!mPendings.empty())
+    {
+        auto& done = mPendings.front().mDone;
+
+        if(done.valid() && done.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            break;
+
+        FinishFront();
+    }
+
+    // bounds the memory held by result copies when checking is slower than timing
+    while(mPendings.size() > mMaxPending)
+        FinishFront();
+}
+
+void ProfileVerifier::FinishFront()
+{
+    Pending pending = std::move(mPendings.front());
+    mPendings.pop_front();
+
+    // waits for the task, rethrows what it threw
+    if(pending.mDone.valid())
+        pending.mDone.get();
+
+    if(pending.mFinish)
+        pending.mFinish(pending.mResult);
+
+    if(pending.mRecord)
+        ProfileResultSink::GetInstance().Record(pending.mResult);
+}
+
+void ProfileVerifier::WorkerLoop()
+{
+    while(true)
+    {
+        std::packaged_task<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+
+            mCondition.wait(lock, [&] { return mStop || !mTasks.empty(); });
+
+            if(mStop)
+                return;
+
+            task = std::move(mTasks.front());
+            mTasks.pop_front();
+        }
+
+        // exceptions end up in the future
+        task();
+    }
+}
+
+} // namespace profiler
+} // namespace ck
@@ -3,29 +3,46 @@
 #include <initializer_list>
 #include <cstdlib>
 #include <stdlib.h>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
 #include <half.hpp>
+#include "device.hpp"
+#include "profile_result.hpp"
+#include "profile_tuning_db.hpp"
 
 int profile_gemm(int, char*[]);
+int profile_batched_gemm(int, char*[]);
 int profile_conv_fwd(int, char*[]);
 int profile_conv_fwd_bias_relu(int, char*[]);
 int profile_conv_fwd_bias_relu_add(int, char*[]);
 int profile_conv_fwd_bias_relu_atomic_add(int, char*[]);
 
-int main(int argc, char* argv[])
+int profile_batch(int, char*[]);
+
+// runs the operation named by argv[1], also called for every problem of a batch run
+int profile_operation(int argc, char* argv[])
 {
-    if(strcmp(argv[1], "gemm") == 0)
+    if(strcmp(argv[1], "gemm") == 0 || strcmp(argv[1], "gemm_cpu") == 0)
     {
         return profile_gemm(argc, argv);
     }
-    else if(strcmp(argv[1], "conv_fwd") == 0)
+    else if(strcmp(argv[1], "batched_gemm") == 0)
+    {
+        return profile_batched_gemm(argc, argv);
+    }
+    else if(strcmp(argv[1], "conv_fwd") == 0 || strcmp(argv[1], "conv_fwd_cpu") == 0)
     {
         return profile_conv_fwd(argc, argv);
     }
-    else if(strcmp(argv[1], "conv_fwd_bias_relu") == 0)
+    else if(strcmp(argv[1], "conv_fwd_bias_relu") == 0 ||
+            strcmp(argv[1], "conv_fwd_bias_relu_cpu") == 0)
     {
         return profile_conv_fwd_bias_relu(argc, argv);
     }
-    else if(strcmp(argv[1], "conv_fwd_bias_relu_add") == 0)
+    else if(strcmp(argv[1], "conv_fwd_bias_relu_add") == 0 ||
+            strcmp(argv[1], "conv_fwd_bias_relu_add_cpu") == 0)
     {
         return profile_conv_fwd_bias_relu_add(argc, argv);
     }
@@ -33,14 +50,85 @@ int main(int argc, char* argv[])
     {
         return profile_conv_fwd_bias_relu_atomic_add(argc, argv);
     }
+    else if(strcmp(argv[1], "batch") == 0)
+    {
+        return profile_batch(argc, argv);
+    }
     else
     {
         printf("arg1: tensor operation (gemm: GEMM;\n"
+               "                        gemm_cpu: GEMM on the host;\n"
+               "                        batched_gemm: batched GEMM on the host;\n"
                "                        conv_fwd: ForwardConvolution;\n"
-               "                        conv_fwd_bias_relu: ForwardConvolution+Bias+ReLU)\n"
-               "                        conv_fwd_bias_relu_add: ForwardConvolution+Bias+ReLU+Add)\n"
+               "                        conv_fwd_cpu: ForwardConvolution on the host;\n"
+               "                        conv_fwd_bias_relu: ForwardConvolution+Bias+ReLU;\n"
+               "                        conv_fwd_bias_relu_cpu: ForwardConvolution+Bias+ReLU on "
+               "the host;\n"
+               "                        conv_fwd_bias_relu_add: ForwardConvolution+Bias+ReLU+Add;\n"
+               "                        conv_fwd_bias_relu_add_cpu: "
+               "ForwardConvolution+Bias+ReLU+Add on the host;\n"
                "                        conv_fwd_bias_relu_atomic_add: "
-               "ForwardConvolution+Bias+ReLU+AtomicAdd)\n");
+               "ForwardConvolution+Bias+ReLU+AtomicAdd;\n"
+               "                        batch: every problem of a problem list file)\n");
+        printf("options: --output=<file> write one record per instance to <file>\n"
+               "         --output-format=jsonl|csv (default: from the file extension)\n"
+               "         --append append to <file> instead of truncating it\n"
+               "         --use-db[=<file>] only profile the instance tuned for the problem\n"
+               "         --update-db[=<file>] store the best instance of the problem\n"
+               "         (<file> defaults to CK_TUNING_DB or ck_tuning.db)\n"
+               "         --warmup=<n> untimed runs before timing (default: 1)\n"
+               "         --min-time=<ms> time more runs until they took <ms> (default: 0)\n");
         return 0;
     }
 }
+
+// --warmup=<n> and --min-time=<ms> override CK_TIMING_WARMUP and CK_TIMING_MIN_MS
+bool parse_timing_option(const std::string& arg)
+{
+    auto& options = TimingOptions::GetInstance();
+
+    if(arg.compare(0, 9, "--warmup=") == 0)
+        options.mNumWarmup = std::max(0, std::atoi(arg.c_str() + 9));
+    else if(arg.compare(0, 11, "--min-time=") == 0)
+        options.mMinDuration = std::max(0.f, std::strtof(arg.c_str() + 11, nullptr));
+    else
+        return false;
+
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    // take the profiler options out, the operations see their positional arguments only
+    std::vector<char*> args;
+
+    for(int i = 0; i < argc; ++i)
+    {
+        if(!ck::profiler::ProfileResultSink::GetInstance().ParseOption(argv[i]) &&
+           !ck::profiler::ProfileTuningDb::GetInstance().ParseOption(argv[i]) &&
+           !parse_timing_option(argv[i]))
+            args.push_back(argv[i]);
+    }
+
+    argc = static_cast<int>(args.size());
+    args.push_back(nullptr);
+    argv = args.data();
+
+    // device buffers kept across problems go back before the HIP runtime is torn down, also when
+    // the operation throws
+    struct DeviceMemPoolReleaser
+    {
+        ~DeviceMemPoolReleaser() { DeviceMemPool::GetInstance().Release(); }
+    } pool_releaser;
+
+    try
+    {
+        return profile_operation(argc, argv);
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+
+        return EXIT_FAILURE;
+    }
+}